@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cli.h"
+#include "parallel.h"
+#include "suite.h"
+#include "threadpool.h"
+
+#define PATH_LEN 4096
+
+#ifndef AOC_BINARY_DIR
+#define AOC_BINARY_DIR "."
+#endif
+
+enum job_status_t {
+    JOB_SOLVED,
+    JOB_NO_INPUT,
+    JOB_FAILED
+};
+
+struct job_t {
+    const struct aoc_solver_t *solver;
+    char input[PATH_LEN];
+    struct aoc_answer_t answer;
+    enum job_status_t status;
+};
+
+static void print_answer(FILE *stream, const struct aoc_answer_t *answer);
+static int run_all(int argc, char *argv[]);
+static void run_job(void *arg);
+static void print_part(FILE *stream, const char *indent, const char *name, const char *value);
+static const char *base_name(const char *path);
+static void usage(const char *prog);
+
+/*
+ * A single executable for every day. It is dispatched busybox-style: invoked
+ * through a link named after a day it solves that day, otherwise the first
+ * argument picks the day, or "all" to run the whole suite.
+ */
+int main(int argc, char *argv[])
+{
+    const char *prog = base_name(argv[0]);
+
+    const struct aoc_solver_t *solver = suite_find(prog);
+    if(solver != NULL) {
+        return solver_main(solver, print_answer, argc, argv);
+    }
+
+    if(argc < 2) {
+        usage(prog);
+        exit(EXIT_FAILURE);
+    }
+
+    if(strcmp(argv[1], "all") == 0) {
+        return run_all(argc - 1, argv + 1);
+    }
+
+    if(strcmp(argv[1], "list") == 0) {
+        for(size_t i = 0; i < suite_solvers_len; i++) {
+            fprintf(stdout, "%s\n", suite_solvers[i]->name);
+        }
+        return 0;
+    }
+
+    if(strcmp(argv[1], "-h") == 0) {
+        usage(prog);
+        return 0;
+    }
+
+    solver = suite_find(argv[1]);
+    if(solver == NULL) {
+        fprintf(stderr, "Unexpected argument: no solver named %s.\n", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+
+    return solver_main(solver, print_answer, argc - 1, argv + 1);
+}
+
+static void print_answer(FILE *stream, const struct aoc_answer_t *answer)
+{
+    print_part(stream, "", "part1", answer->part1);
+    print_part(stream, "", "part2", answer->part2);
+}
+
+/*
+ * Solves each day on <dir>/<day>/input.in. Every day is an independent task
+ * on the pool, and the answers are held until all of them are done so they
+ * print in puzzle order however the tasks were scheduled.
+ */
+static int run_all(int argc, char *argv[])
+{
+    size_t threads = threadpool_default_threads();
+    size_t solver_threads = 1;
+    const char *dir = AOC_BINARY_DIR;
+
+    int opt;
+    while((opt = getopt(argc, argv, "j:t:C:h")) != -1) {
+        switch(opt) {
+            case 'j':
+                threads = (size_t)cli_parse_count(optarg, 1, "jobs");
+                break;
+            case 't':
+                solver_threads = (size_t)cli_parse_count(optarg, 0, "threads");
+                break;
+            case 'C':
+                dir = optarg;
+                break;
+            case 'h':
+                usage("aoc");
+                return 0;
+            default:
+                usage("aoc");
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    struct job_t *jobs = (struct job_t *)malloc(sizeof(struct job_t) * suite_solvers_len);
+    if(jobs == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t jobs_len = 0;
+    for(size_t i = 0; i < suite_solvers_len; i++) {
+        int selected = optind == argc;
+        for(int arg = optind; arg < argc && !selected; arg++) {
+            selected = strcmp(argv[arg], suite_solvers[i]->name) == 0;
+        }
+
+        if(selected) {
+            jobs[jobs_len].solver = suite_solvers[i];
+            snprintf(jobs[jobs_len].input, PATH_LEN, "%s/%s/input.in", dir, suite_solvers[i]->name);
+            jobs_len++;
+        }
+    }
+
+    for(int arg = optind; arg < argc; arg++) {
+        if(suite_find(argv[arg]) == NULL) {
+            fprintf(stderr, "Unexpected argument: no solver named %s.\n", argv[arg]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if(threads > jobs_len) {
+        threads = jobs_len;
+    }
+
+    parallel_init(solver_threads);
+
+    struct threadpool_t pool;
+    threadpool_init(&pool, threads);
+
+    for(size_t i = 0; i < jobs_len; i++) {
+        threadpool_submit(&pool, run_job, &jobs[i]);
+    }
+
+    threadpool_release(&pool);
+    parallel_release();
+
+    int failures = 0;
+    for(size_t i = 0; i < jobs_len; i++) {
+        switch(jobs[i].status) {
+            case JOB_SOLVED:
+                fprintf(stdout, "%s\n", jobs[i].solver->name);
+                print_part(stdout, "  ", "part1", jobs[i].answer.part1);
+                print_part(stdout, "  ", "part2", jobs[i].answer.part2);
+                break;
+            case JOB_NO_INPUT:
+                fprintf(stderr, "Unexpected error: cannot read %s.\n", jobs[i].input);
+                failures++;
+                break;
+            default:
+                fprintf(stderr, "Unexpected error: %s failed on %s.\n", jobs[i].solver->name, jobs[i].input);
+                failures++;
+        }
+
+        answer_release(&jobs[i].answer);
+    }
+
+    free(jobs);
+
+    return failures ? EXIT_FAILURE : 0;
+}
+
+static void run_job(void *arg)
+{
+    struct job_t *job = (struct job_t *)arg;
+
+    answer_init(&job->answer);
+
+    FILE *input = fopen(job->input, "rb");
+    if(input == NULL) {
+        job->status = JOB_NO_INPUT;
+        return;
+    }
+
+    job->status = job->solver->solve(input, &job->answer) ? JOB_FAILED : JOB_SOLVED;
+
+    fclose(input);
+}
+
+/*
+ * Answers that span several lines (day10's message) start on the line after
+ * their name. A part with no answer is left out.
+ */
+static void print_part(FILE *stream, const char *indent, const char *name, const char *value)
+{
+    if(value == NULL) {
+        return;
+    }
+
+    if(strchr(value, '\n') == NULL) {
+        fprintf(stream, "%s%s: %s\n", indent, name, value);
+        return;
+    }
+
+    fprintf(stream, "%s%s:\n", indent, name);
+
+    const char *line = value;
+    while(*line) {
+        const char *lf = strchr(line, '\n');
+        size_t len = lf != NULL ? (size_t)(lf - line) : strlen(line);
+
+        fprintf(stream, "%s  %.*s\n", indent, (int)len, line);
+        line += lf != NULL ? len + 1 : len;
+    }
+}
+
+static const char *base_name(const char *path)
+{
+    const char *slash = strrchr(path, '/');
+
+    return slash != NULL ? slash + 1 : path;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s <day> [-m] [--stream] [--threads N] [--cache DIR] < input\n"
+                    "       %s <day> [-j jobs] [--threads N] [--cache DIR] <input|dir>...\n"
+                    "       %s all [-j jobs] [-t threads] [-C dir] [day...]\n"
+                    "       %s list\n"
+                    "\n"
+                    "Solves one day on stdin or in batch mode, like aocd#, or every day on\n"
+                    "<dir>/<day>/input.in with up to <jobs> days in flight at once (one per core\n"
+                    "by default) and <threads> shared by the solvers that split their own work.\n"
+                    "Answers are printed in puzzle order. Linking this executable as <day> is the\n"
+                    "same as running '%s <day>'.\n", prog, prog, prog, prog, prog);
+}
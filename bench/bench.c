@@ -0,0 +1,757 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <math.h>
+
+#include "cpu.h"
+#include "hugemem.h"
+#include "suite.h"
+#include "clock.h"
+#include "table.h"
+
+#define DEFAULT_RUNS 10
+#define MAX_SUFFIXES 8
+#define PATH_LEN 4096
+
+/*
+ * A test only fails on time when it is both over the tolerance and this much
+ * slower than its baseline, so that sub-millisecond days do not fail on noise.
+ */
+#define MIN_SLOWDOWN_NS 1000000ULL
+
+#ifndef AOC_BINARY_DIR
+#define AOC_BINARY_DIR "."
+#endif
+
+#define BENCH_TOTAL AOC_PHASES
+#define BENCH_SERIES (AOC_PHASES + 1)
+
+struct bench_stats_t {
+    uint64_t min_ns;
+    uint64_t median_ns;
+    uint64_t p99_ns;
+    double ns_per_byte;
+};
+
+struct bench_result_t {
+    const char *day;
+    char input[PATH_LEN];
+    size_t bytes;
+    int runs;
+    char *part1;
+    char *part2;
+    struct bench_stats_t stats[BENCH_SERIES];
+    int has_memory;
+    struct memstat_t memory[AOC_PHASES];
+    int has_counters;
+    struct perfctr_t counters[BENCH_SERIES];
+};
+
+static char *read_file(const char *path, size_t *len);
+static int bench_solver(const struct aoc_solver_t *solver, const char *dir, const char *suffix, int runs, int memory, int counters, struct bench_result_t *result);
+static int bench_memory(const struct aoc_solver_t *solver, const char *input, size_t input_len, struct memstat_t memory[]);
+static int bench_counters(const struct aoc_solver_t *solver, const char *input, size_t input_len, int runs, struct perfctr_t counters[]);
+static int parts_match(const char *a, const char *b);
+static struct bench_stats_t compute_stats(uint64_t samples[], int samples_len, size_t bytes);
+static int compare_samples(const void *a, const void *b);
+static void print_result(FILE *stream, const struct bench_result_t *result);
+static void print_json_result(FILE *stream, const struct bench_result_t *result);
+static void print_count(FILE *stream, const char *fmt, uint64_t count);
+static int check_answers(const struct table_t *expected, const struct bench_result_t *result);
+static int check_time(const struct table_t *baseline, double tolerance, const struct bench_result_t *result, double *log_ratio);
+static const char *input_name(const struct bench_result_t *result);
+static void usage(const char *prog);
+
+int main(int argc, char *argv[])
+{
+    int runs = DEFAULT_RUNS;
+    const char *dir = AOC_BINARY_DIR;
+    const char *json_path = NULL;
+    const char *suffixes[MAX_SUFFIXES + 1] = {NULL};
+    int suffixes_len = 1;
+    int memory = 0;
+    int counters = 0;
+    const char *expected_path = NULL;
+    const char *baseline_path = NULL;
+    const char *record_path = NULL;
+    double tolerance = -1.0;
+
+    int opt;
+    while((opt = getopt(argc, argv, "n:o:x:C:mpe:b:t:w:h")) != -1) {
+        switch(opt) {
+            case 'n':
+                runs = (int)strtol(optarg, NULL, 10);
+                if(runs < 1) {
+                    fprintf(stderr, "Unexpected argument: number of runs must be positive.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'o':
+                json_path = optarg;
+                break;
+            case 'x':
+                if(suffixes_len > MAX_SUFFIXES) {
+                    fprintf(stderr, "Unexpected argument: too many scaled inputs.\n");
+                    exit(EXIT_FAILURE);
+                }
+                suffixes[suffixes_len++] = optarg;
+                break;
+            case 'C':
+                dir = optarg;
+                break;
+            case 'm':
+                if(memstat_start()) {
+                    fprintf(stderr, "Unexpected argument: built without AOC_MEMSTAT.\n");
+                    exit(EXIT_FAILURE);
+                }
+                memstat_stop();
+                memory = 1;
+                break;
+            case 'p':
+                if(perfctr_start()) {
+                    fprintf(stderr, "Note: hardware counters unavailable (%s), benchmarking without them.\n", perfctr_error());
+                    break;
+                }
+                perfctr_stop();
+                counters = 1;
+                break;
+            case 'e':
+                expected_path = optarg;
+                break;
+            case 'b':
+                baseline_path = optarg;
+                break;
+            case 't':
+                tolerance = strtod(optarg, NULL);
+                if(tolerance < 0) {
+                    fprintf(stderr, "Unexpected argument: tolerance must not be negative.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'w':
+                record_path = optarg;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    const struct aoc_solver_t **solvers = (const struct aoc_solver_t **)malloc(sizeof(struct aoc_solver_t *) * suite_solvers_len);
+    if(solvers == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t solvers_len = 0;
+    if(optind == argc) {
+        for(size_t i = 0; i < suite_solvers_len; i++) {
+            solvers[solvers_len++] = suite_solvers[i];
+        }
+    } else {
+        for(int i = optind; i < argc; i++) {
+            const struct aoc_solver_t *solver = suite_find(argv[i]);
+            if(solver == NULL) {
+                fprintf(stderr, "Unexpected argument: no solver named %s.\n", argv[i]);
+                exit(EXIT_FAILURE);
+            }
+
+            if(solvers_len < suite_solvers_len) {
+                solvers[solvers_len++] = solver;
+            }
+        }
+    }
+
+    FILE *json = NULL;
+    if(json_path != NULL) {
+        json = fopen(json_path, "w");
+        if(json == NULL) {
+            perror("Fatal error: Cannot open output file.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        fprintf(json, "{\"runs\": %d, \"cpu_tier\": \"%s\", \"hugepages\": \"%s\", \"numa\": \"%s\", \"counters\": %s, \"results\": [",
+                runs, cpu_tier_name(cpu_tier()), hugemem_mode_name(hugemem_mode()), hugemem_numa_local() ? "local" : "off",
+                counters ? "true" : "false");
+    }
+
+    struct table_t expected;
+    if(expected_path != NULL && table_load(&expected, expected_path, 4)) {
+        fprintf(stderr, "Unexpected error: cannot read %s.\n", expected_path);
+        exit(EXIT_FAILURE);
+    }
+
+    struct table_t baseline;
+    if(baseline_path != NULL && table_load(&baseline, baseline_path, 3)) {
+        fprintf(stderr, "Unexpected error: cannot read %s.\n", baseline_path);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE *record = NULL;
+    if(record_path != NULL) {
+        record = fopen(record_path, "w");
+        if(record == NULL) {
+            perror("Fatal error: Cannot open output file.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        fprintf(record, "# day\tinput\tfastest total ns, %d runs\n", runs);
+    }
+
+    int failures = 0;
+    int results_written = 0;
+    int compared = 0;
+    double log_ratios = 0.0;
+    for(size_t i = 0; i < solvers_len; i++) {
+        for(int j = 0; j < suffixes_len; j++) {
+            struct bench_result_t result;
+            if(bench_solver(solvers[i], dir, suffixes[j], runs, memory, counters, &result)) {
+                if(suffixes[j] == NULL) {
+                    failures++;
+                }
+                continue;
+            }
+
+            print_result(stdout, &result);
+
+            if(expected_path != NULL) {
+                failures += check_answers(&expected, &result);
+            }
+
+            if(baseline_path != NULL) {
+                double log_ratio;
+                failures += check_time(&baseline, tolerance, &result, &log_ratio);
+                if(!isnan(log_ratio)) {
+                    log_ratios += log_ratio;
+                    compared++;
+                }
+            }
+
+            if(record != NULL) {
+                fprintf(record, "%s\t%s\t%llu\n", result.day, input_name(&result),
+                        (unsigned long long)result.stats[BENCH_TOTAL].min_ns);
+            }
+
+            if(json != NULL) {
+                fprintf(json, results_written ? ",\n  " : "\n  ");
+                print_json_result(json, &result);
+                results_written++;
+            }
+
+            free(result.part1);
+            free(result.part2);
+        }
+    }
+
+    if(json != NULL) {
+        fprintf(json, "\n]}\n");
+        fclose(json);
+    }
+
+    if(record != NULL) {
+        fclose(record);
+    }
+
+    if(compared > 0) {
+        double ratio = exp(log_ratios / compared);
+        fprintf(stdout, "geometric mean over %d inputs: %.3fx the baseline time, %.2fx speedup\n", compared, ratio, 1.0 / ratio);
+    }
+
+    if(expected_path != NULL) {
+        table_release(&expected);
+    }
+
+    if(baseline_path != NULL) {
+        table_release(&baseline);
+    }
+
+    free(solvers);
+
+    return failures ? EXIT_FAILURE : 0;
+}
+
+static char *read_file(const char *path, size_t *len)
+{
+    FILE *file = fopen(path, "rb");
+    if(file == NULL) {
+        return NULL;
+    }
+
+    size_t buff_len = 4096;
+    size_t buff_index = 0;
+    char *buffer = (char *)malloc(sizeof(char) * buff_len);
+    if(buffer == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t read;
+    while((read = fread(buffer + buff_index, 1, buff_len - buff_index, file)) > 0) {
+        buff_index += read;
+        if(buff_index == buff_len) {
+            buff_len *= 2;
+            buffer = (char *)realloc(buffer, sizeof(char) * buff_len);
+            if(buffer == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    fclose(file);
+
+    *len = buff_index;
+    return buffer;
+}
+
+static int bench_solver(const struct aoc_solver_t *solver, const char *dir, const char *suffix, int runs, int memory, int counters, struct bench_result_t *result)
+{
+    char path[PATH_LEN];
+    if(suffix == NULL) {
+        snprintf(path, PATH_LEN, "%s/%s/input.in", dir, solver->name);
+    } else {
+        snprintf(path, PATH_LEN, "%s/%s/input.%s.in", dir, solver->name, suffix);
+    }
+
+    size_t input_len = 0;
+    char *input = read_file(path, &input_len);
+    if(input == NULL) {
+        if(suffix == NULL) {
+            fprintf(stderr, "Unexpected error: cannot read %s.\n", path);
+        }
+        return 1;
+    }
+
+    uint64_t *samples = (uint64_t *)malloc(sizeof(uint64_t) * runs * BENCH_SERIES);
+    if(samples == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    result->day = solver->name;
+    snprintf(result->input, PATH_LEN, "%s", path);
+    result->bytes = input_len;
+    result->runs = runs;
+    result->part1 = NULL;
+    result->part2 = NULL;
+    result->has_memory = 0;
+    result->has_counters = 0;
+
+    /*
+     * Heap use is deterministic, so it is measured once in a run of its own
+     * rather than letting the counting slow down the timed runs.
+     */
+    if(memory) {
+        if(bench_memory(solver, input, input_len, result->memory)) {
+            fprintf(stderr, "Unexpected error: %s failed on %s.\n", solver->name, path);
+            free(samples);
+            free(input);
+            return 1;
+        }
+        result->has_memory = 1;
+    }
+
+    /*
+     * Counters, likewise, are read in runs of their own: reading them at every
+     * lap is a system call.
+     */
+    if(counters) {
+        if(bench_counters(solver, input, input_len, runs, result->counters)) {
+            fprintf(stderr, "Unexpected error: %s failed on %s.\n", solver->name, path);
+            free(samples);
+            free(input);
+            return 1;
+        }
+        result->has_counters = 1;
+    }
+
+    for(int run = 0; run < runs; run++) {
+        FILE *stream = fmemopen(input, input_len, "r");
+        if(stream == NULL) {
+            perror("Fatal error: Cannot open input stream.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        struct aoc_answer_t answer;
+        answer_init(&answer);
+
+        uint64_t start = clock_now_ns();
+        int ret = solver->solve(stream, &answer);
+        uint64_t total = clock_now_ns() - start;
+
+        fclose(stream);
+
+        if(ret) {
+            fprintf(stderr, "Unexpected error: %s failed on %s.\n", solver->name, path);
+            answer_release(&answer);
+            free(samples);
+            free(input);
+            return 1;
+        }
+
+        for(int phase = 0; phase < AOC_PHASES; phase++) {
+            samples[phase * runs + run] = answer.phase_ns[phase];
+        }
+        samples[BENCH_TOTAL * runs + run] = total;
+
+        if(run == 0) {
+            result->part1 = answer.part1;
+            result->part2 = answer.part2;
+            answer.part1 = NULL;
+            answer.part2 = NULL;
+        } else if(!parts_match(result->part1, answer.part1) || !parts_match(result->part2, answer.part2)) {
+            fprintf(stderr, "Unexpected error: %s gave different answers across runs on %s.\n", solver->name, path);
+            exit(EXIT_FAILURE);
+        }
+
+        answer_release(&answer);
+    }
+
+    for(int series = 0; series < BENCH_SERIES; series++) {
+        result->stats[series] = compute_stats(samples + series * runs, runs, input_len);
+    }
+
+    free(samples);
+    free(input);
+
+    return 0;
+}
+
+static int bench_memory(const struct aoc_solver_t *solver, const char *input, size_t input_len, struct memstat_t memory[])
+{
+    FILE *stream = fmemopen((void *)input, input_len, "r");
+    if(stream == NULL) {
+        perror("Fatal error: Cannot open input stream.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct aoc_answer_t answer;
+
+    memstat_start();
+    answer_init(&answer);
+    int ret = solver->solve(stream, &answer);
+    memstat_stop();
+
+    fclose(stream);
+
+    for(int phase = 0; phase < AOC_PHASES; phase++) {
+        memory[phase] = answer.phase_mem[phase];
+    }
+
+    answer_release(&answer);
+
+    return ret;
+}
+
+/*
+ * Each count is the median over the runs, per phase, with the phases' sum as
+ * the total. A count that was missing in any run is missing.
+ */
+static int bench_counters(const struct aoc_solver_t *solver, const char *input, size_t input_len, int runs, struct perfctr_t counters[])
+{
+    uint64_t *samples = (uint64_t *)malloc(sizeof(uint64_t) * runs * BENCH_SERIES * PERFCTR_EVENTS);
+    if(samples == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if(perfctr_start()) {
+        fprintf(stderr, "Unexpected error: cannot open hardware counters: %s.\n", perfctr_error());
+        exit(EXIT_FAILURE);
+    }
+
+    int ret = 0;
+    for(int run = 0; run < runs && !ret; run++) {
+        FILE *stream = fmemopen((void *)input, input_len, "r");
+        if(stream == NULL) {
+            perror("Fatal error: Cannot open input stream.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        struct aoc_answer_t answer;
+        answer_init(&answer);
+        ret = solver->solve(stream, &answer);
+
+        fclose(stream);
+
+        for(int event = 0; event < PERFCTR_EVENTS; event++) {
+            uint64_t total = 0;
+            for(int phase = 0; phase < AOC_PHASES; phase++) {
+                uint64_t count = answer.phase_ctr[phase].counts[event];
+                samples[(phase * PERFCTR_EVENTS + event) * runs + run] = count;
+                total = count == PERFCTR_MISSING || total == PERFCTR_MISSING ? PERFCTR_MISSING : total + count;
+            }
+            samples[(BENCH_TOTAL * PERFCTR_EVENTS + event) * runs + run] = total;
+        }
+
+        answer_release(&answer);
+    }
+
+    perfctr_stop();
+
+    for(int series = 0; series < BENCH_SERIES && !ret; series++) {
+        for(int event = 0; event < PERFCTR_EVENTS; event++) {
+            uint64_t *series_samples = samples + (series * PERFCTR_EVENTS + event) * runs;
+            qsort(series_samples, runs, sizeof(uint64_t), compare_samples);
+            counters[series].counts[event] = series_samples[runs - 1] == PERFCTR_MISSING ? PERFCTR_MISSING : series_samples[runs / 2];
+        }
+    }
+
+    free(samples);
+
+    return ret;
+}
+
+static int parts_match(const char *a, const char *b)
+{
+    if(a == NULL || b == NULL) {
+        return a == b;
+    }
+
+    return strcmp(a, b) == 0;
+}
+
+static struct bench_stats_t compute_stats(uint64_t samples[], int samples_len, size_t bytes)
+{
+    struct bench_stats_t stats;
+
+    qsort(samples, samples_len, sizeof(uint64_t), compare_samples);
+
+    int p99_index = (samples_len * 99 + 99) / 100 - 1;
+
+    stats.min_ns = samples[0];
+    stats.median_ns = samples[samples_len / 2];
+    stats.p99_ns = samples[p99_index];
+    stats.ns_per_byte = bytes ? (double)stats.median_ns / (double)bytes : 0.0;
+
+    return stats;
+}
+
+static int compare_samples(const void *a, const void *b)
+{
+    uint64_t lhs = *(const uint64_t *)a;
+    uint64_t rhs = *(const uint64_t *)b;
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static void print_result(FILE *stream, const struct bench_result_t *result)
+{
+    fprintf(stream, "%s (%s, %zu bytes, %d runs)\n", result->day, result->input, result->bytes, result->runs);
+
+    for(int series = 0; series < BENCH_SERIES; series++) {
+        const struct bench_stats_t *stats = result->stats + series;
+        const char *name = series == BENCH_TOTAL ? "total" : aoc_phase_names[series];
+
+        fprintf(stream, "  %-6s min %12.3f ms  median %12.3f ms  p99 %12.3f ms  %12.2f ns/byte\n",
+                name, stats->min_ns / 1e6, stats->median_ns / 1e6, stats->p99_ns / 1e6, stats->ns_per_byte);
+    }
+
+    for(int phase = 0; phase < AOC_PHASES && result->has_memory; phase++) {
+        const struct memstat_t *mem = result->memory + phase;
+
+        fprintf(stream, "  %-6s allocs %10llu  bytes %14llu  peak %14llu\n", aoc_phase_names[phase],
+                (unsigned long long)mem->allocs, (unsigned long long)mem->bytes, (unsigned long long)mem->peak_bytes);
+    }
+
+    for(int series = 0; series < BENCH_SERIES && result->has_counters; series++) {
+        const uint64_t *counts = result->counters[series].counts;
+        const char *name = series == BENCH_TOTAL ? "total" : aoc_phase_names[series];
+
+        fprintf(stream, "  %-6s", name);
+        print_count(stream, " cycles %13s", counts[PERFCTR_CYCLES]);
+        print_count(stream, "  instrs %13s", counts[PERFCTR_INSTRUCTIONS]);
+        if(counts[PERFCTR_CYCLES] != PERFCTR_MISSING && counts[PERFCTR_INSTRUCTIONS] != PERFCTR_MISSING && counts[PERFCTR_CYCLES]) {
+            fprintf(stream, "  IPC %5.2f", (double)counts[PERFCTR_INSTRUCTIONS] / (double)counts[PERFCTR_CYCLES]);
+        } else {
+            fprintf(stream, "  IPC %5s", "-");
+        }
+        print_count(stream, "  L1d miss %11s", counts[PERFCTR_L1D_MISSES]);
+        print_count(stream, "  LLC miss %11s", counts[PERFCTR_LLC_MISSES]);
+        print_count(stream, "  br miss %11s", counts[PERFCTR_BRANCH_MISSES]);
+        print_count(stream, "  dTLB miss %11s", counts[PERFCTR_DTLB_MISSES]);
+        fprintf(stream, "\n");
+    }
+}
+
+/*
+ * fmt takes the count as a string, "-" when it is missing.
+ */
+static void print_count(FILE *stream, const char *fmt, uint64_t count)
+{
+    char buff[24] = "-";
+    if(count != PERFCTR_MISSING) {
+        snprintf(buff, sizeof(buff), "%llu", (unsigned long long)count);
+    }
+
+    fprintf(stream, fmt, buff);
+}
+
+static void print_json_result(FILE *stream, const struct bench_result_t *result)
+{
+    fprintf(stream, "{\"day\": ");
+    answer_print_json_string(stream, result->day);
+    fprintf(stream, ", \"input\": ");
+    answer_print_json_string(stream, result->input);
+    fprintf(stream, ", \"bytes\": %zu, \"part1\": ", result->bytes);
+    answer_print_json_string(stream, result->part1);
+    fprintf(stream, ", \"part2\": ");
+    answer_print_json_string(stream, result->part2);
+    fprintf(stream, ", \"phases\": {");
+
+    for(int series = 0; series < BENCH_SERIES; series++) {
+        const struct bench_stats_t *stats = result->stats + series;
+        const char *name = series == BENCH_TOTAL ? "total" : aoc_phase_names[series];
+
+        fprintf(stream, "%s\"%s\": {\"min_ns\": %llu, \"median_ns\": %llu, \"p99_ns\": %llu, \"ns_per_byte\": %.3f}",
+                series ? ", " : "", name, (unsigned long long)stats->min_ns, (unsigned long long)stats->median_ns,
+                (unsigned long long)stats->p99_ns, stats->ns_per_byte);
+    }
+
+    fprintf(stream, "}");
+
+    if(result->has_memory) {
+        fprintf(stream, ", \"memory\": {");
+
+        for(int phase = 0; phase < AOC_PHASES; phase++) {
+            const struct memstat_t *mem = result->memory + phase;
+
+            fprintf(stream, "%s\"%s\": {\"allocs\": %llu, \"bytes\": %llu, \"peak_bytes\": %llu}", phase ? ", " : "",
+                    aoc_phase_names[phase], (unsigned long long)mem->allocs, (unsigned long long)mem->bytes,
+                    (unsigned long long)mem->peak_bytes);
+        }
+
+        fprintf(stream, "}");
+    }
+
+    if(result->has_counters) {
+        fprintf(stream, ", \"counters\": {");
+
+        for(int series = 0; series < BENCH_SERIES; series++) {
+            fprintf(stream, "%s\"%s\": {", series ? ", " : "", series == BENCH_TOTAL ? "total" : aoc_phase_names[series]);
+
+            for(int event = 0; event < PERFCTR_EVENTS; event++) {
+                uint64_t count = result->counters[series].counts[event];
+
+                fprintf(stream, "%s\"%s\": ", event ? ", " : "", perfctr_event_names[event]);
+                if(count == PERFCTR_MISSING) {
+                    fprintf(stream, "null");
+                } else {
+                    fprintf(stream, "%llu", (unsigned long long)count);
+                }
+            }
+
+            fprintf(stream, "}");
+        }
+
+        fprintf(stream, "}");
+    }
+
+    fprintf(stream, "}");
+}
+
+static int check_answers(const struct table_t *expected, const struct bench_result_t *result)
+{
+    const char *input = input_name(result);
+
+    const struct table_row_t *row = table_find(expected, result->day, input);
+    if(row == NULL) {
+        fprintf(stderr, "Unexpected result: no expected answers for %s %s.\n", result->day, input);
+        return 1;
+    }
+
+    int failures = 0;
+    const char *parts[2] = {result->part1, result->part2};
+    for(int i = 0; i < 2; i++) {
+        if(parts_match(parts[i], row->fields[2 + i])) {
+            continue;
+        }
+
+        fprintf(stderr, "Unexpected result: %s %s part%d is ", result->day, input, i + 1);
+        table_print_field(stderr, parts[i]);
+        fprintf(stderr, ", expected ");
+        table_print_field(stderr, row->fields[2 + i]);
+        fprintf(stderr, ".\n");
+        failures = 1;
+    }
+
+    return failures;
+}
+
+/*
+ * Compares the fastest total time against the recorded one, and stores the log
+ * of their ratio for the summary (NaN when there is nothing to compare). An
+ * input without a baseline passes, so new days and scales can be added before
+ * recording, and with a negative tolerance the comparison is only reported.
+ *
+ * The fastest run is the one least disturbed by the rest of the machine: on a
+ * shared or virtual CPU the median of a few millisecond runs can double from
+ * one invocation to the next, while the fastest one moves by a fraction.
+ */
+static int check_time(const struct table_t *baseline, double tolerance, const struct bench_result_t *result, double *log_ratio)
+{
+    const char *input = input_name(result);
+
+    *log_ratio = NAN;
+
+    const struct table_row_t *row = table_find(baseline, result->day, input);
+    if(row == NULL) {
+        fprintf(stdout, "  no baseline for %s %s\n", result->day, input);
+        return 0;
+    }
+
+    uint64_t baseline_ns = strtoull(row->fields[2], NULL, 10);
+    uint64_t fastest_ns = result->stats[BENCH_TOTAL].min_ns;
+    if(baseline_ns == 0 || fastest_ns == 0) {
+        return 0;
+    }
+
+    double ratio = (double)fastest_ns / (double)baseline_ns;
+    double change = (ratio - 1.0) * 100.0;
+    *log_ratio = log(ratio);
+
+    if(tolerance < 0) {
+        fprintf(stdout, "  baseline %12.3f ms  %+7.1f%%  %.2fx speedup\n", baseline_ns / 1e6, change, 1.0 / ratio);
+        return 0;
+    }
+
+    fprintf(stdout, "  baseline %12.3f ms  %+7.1f%% (tolerance %.1f%%)\n", baseline_ns / 1e6, change, tolerance);
+
+    if(change > tolerance && fastest_ns > baseline_ns + MIN_SLOWDOWN_NS) {
+        fprintf(stderr, "Unexpected result: %s %s fastest run %.3f ms is %.1f%% over its baseline of %.3f ms.\n",
+                result->day, input, fastest_ns / 1e6, change, baseline_ns / 1e6);
+        return 1;
+    }
+
+    return 0;
+}
+
+static const char *input_name(const struct bench_result_t *result)
+{
+    const char *slash = strrchr(result->input, '/');
+
+    return slash != NULL ? slash + 1 : result->input;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-n runs] [-m] [-p] [-o results.json] [-x suffix]... [-C dir]\n"
+                    "          [-e expected.tsv] [-b baseline.tsv [-t percent]] [-w baseline.tsv] [day...]\n"
+                    "\n"
+                    "Runs each solver in-process on <dir>/<day>/input.in and, for every -x,\n"
+                    "on <dir>/<day>/input.<suffix>.in when it exists. With -m, also counts the\n"
+                    "allocations, bytes and peak live bytes of each phase in one extra run. With\n"
+                    "-p, also reports the median hardware counts of each phase (cycles,\n"
+                    "instructions, L1d and LLC misses, branch misses, dTLB misses) over <runs>\n"
+                    "extra runs, or notes that the kernel will not count them and carries on\n"
+                    "without.\n"
+                    "\n"
+                    "-e fails unless the answers match the expected ones, -b compares the fastest\n"
+                    "total times against a baseline and, given -t, fails when one is more than\n"
+                    "<percent> over it, and -w records the fastest total times as a new baseline.\n", prog);
+}
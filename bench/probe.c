@@ -0,0 +1,477 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <math.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "input.h"
+#include "suite.h"
+#include "clock.h"
+#include "table.h"
+
+#define DEFAULT_RUNS 3
+#define DEFAULT_MAX_SCALE 32
+#define DEFAULT_SEED 2018
+#define DEFAULT_SLACK 0.5
+#define MAX_SIZES 24
+#define PATH_LEN 4096
+
+/*
+ * Sizes where a series takes less than this are left out of its fit, since
+ * there fixed costs and timer noise hide how it grows.
+ */
+#define MIN_FIT_NS 50000ULL
+#define MIN_FIT_SIZES 3
+
+#ifndef AOC_BINARY_DIR
+#define AOC_BINARY_DIR "."
+#endif
+
+#define PROBE_TOTAL AOC_PHASES
+#define PROBE_SERIES (AOC_PHASES + 1)
+
+enum model_t {
+    MODEL_N,
+    MODEL_N_LOG_N,
+    MODEL_N2,
+    MODEL_N3,
+    MODELS
+};
+
+static const char *const model_names[MODELS] = {"n", "n log n", "n^2", "n^3"};
+
+struct probe_point_t {
+    size_t bytes;
+    uint64_t min_ns[PROBE_SERIES];
+};
+
+/*
+ * exponent is the slope of log time over log size; error is the RMS relative
+ * error of time = c + a * model(n) at its best c and a, for each model.
+ */
+struct probe_fit_t {
+    int sizes;
+    double exponent;
+    double error[MODELS];
+    enum model_t best;
+};
+
+static int probe_solver(const struct aoc_solver_t *solver, const char *dir, uint64_t seed, unsigned long int max_scale, int runs, struct probe_point_t points[], int *points_len);
+static int generate(const char *dir, const char *day, uint64_t seed, unsigned long int scale, const char *path);
+static int time_solver(const struct aoc_solver_t *solver, const struct input_t *input, int runs, uint64_t min_ns[]);
+static int fit(const struct probe_point_t points[], int points_len, int series, struct probe_fit_t *result);
+static double model(enum model_t model, double n);
+static int check_exponent(const struct table_t *baseline, double slack, const char *day, const char *series, double exponent);
+static void usage(const char *prog);
+
+int main(int argc, char *argv[])
+{
+    int runs = DEFAULT_RUNS;
+    unsigned long int max_scale = DEFAULT_MAX_SCALE;
+    uint64_t seed = DEFAULT_SEED;
+    const char *dir = AOC_BINARY_DIR;
+    const char *baseline_path = NULL;
+    const char *record_path = NULL;
+    double slack = DEFAULT_SLACK;
+
+    int opt;
+    while((opt = getopt(argc, argv, "n:s:r:C:b:t:w:h")) != -1) {
+        switch(opt) {
+            case 'n':
+                runs = (int)strtol(optarg, NULL, 10);
+                if(runs < 1) {
+                    fprintf(stderr, "Unexpected argument: number of runs must be positive.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 's':
+                max_scale = strtoul(optarg, NULL, 10);
+                if(max_scale < 4) {
+                    fprintf(stderr, "Unexpected argument: the largest scale must be at least 4.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'r':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'C':
+                dir = optarg;
+                break;
+            case 'b':
+                baseline_path = optarg;
+                break;
+            case 't':
+                slack = strtod(optarg, NULL);
+                if(slack <= 0) {
+                    fprintf(stderr, "Unexpected argument: slack must be positive.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'w':
+                record_path = optarg;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    struct table_t baseline;
+    if(baseline_path != NULL && table_load(&baseline, baseline_path, 3)) {
+        fprintf(stderr, "Unexpected error: cannot read %s.\n", baseline_path);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE *record = NULL;
+    if(record_path != NULL) {
+        record = fopen(record_path, "w");
+        if(record == NULL) {
+            perror("Fatal error: Cannot open output file.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        fprintf(record, "# day\tseries\tscaling exponent, seed %llu, scales 1 to %lu\n", (unsigned long long)seed, max_scale);
+    }
+
+    int failures = 0;
+    for(size_t i = 0; i < suite_solvers_len; i++) {
+        const struct aoc_solver_t *solver = suite_solvers[i];
+
+        int wanted = optind == argc;
+        for(int arg = optind; arg < argc && !wanted; arg++) {
+            wanted = strcmp(argv[arg], solver->name) == 0;
+        }
+
+        if(!wanted) {
+            continue;
+        }
+
+        struct probe_point_t points[MAX_SIZES];
+        int points_len;
+        if(probe_solver(solver, dir, seed, max_scale, runs, points, &points_len)) {
+            failures++;
+            continue;
+        }
+
+        if(points_len < MIN_FIT_SIZES) {
+            fprintf(stdout, "%s (input stops growing at %zu bytes, nothing to fit)\n", solver->name, points[points_len - 1].bytes);
+            continue;
+        }
+
+        fprintf(stdout, "%s (%d sizes, %zu to %zu bytes)\n", solver->name, points_len, points[0].bytes, points[points_len - 1].bytes);
+
+        for(int series = 0; series < PROBE_SERIES; series++) {
+            const char *name = series == PROBE_TOTAL ? "total" : aoc_phase_names[series];
+
+            struct probe_fit_t result;
+            if(fit(points, points_len, series, &result)) {
+                fprintf(stdout, "  %-6s too fast or too few sizes to fit\n", name);
+                continue;
+            }
+
+            fprintf(stdout, "  %-6s exponent %5.2f  best fit %-7s (", name, result.exponent, model_names[result.best]);
+            for(int m = 0; m < MODELS; m++) {
+                fprintf(stdout, "%s%s %.0f%%", m ? ", " : "", model_names[m], result.error[m] * 100.0);
+            }
+            fprintf(stdout, ")\n");
+
+            if(baseline_path != NULL) {
+                failures += check_exponent(&baseline, slack, solver->name, name, result.exponent);
+            }
+
+            if(record != NULL) {
+                fprintf(record, "%s\t%s\t%.2f\n", solver->name, name, result.exponent);
+            }
+        }
+    }
+
+    for(int arg = optind; arg < argc; arg++) {
+        if(suite_find(argv[arg]) == NULL) {
+            fprintf(stderr, "Unexpected argument: no solver named %s.\n", argv[arg]);
+            failures++;
+        }
+    }
+
+    if(record != NULL) {
+        fclose(record);
+    }
+
+    if(baseline_path != NULL) {
+        table_release(&baseline);
+    }
+
+    return failures ? EXIT_FAILURE : 0;
+}
+
+/*
+ * Scales double from 1 up to max_scale. A generator that caps the scale
+ * writes the same input again, so sizes stop when an input does not grow.
+ */
+static int probe_solver(const struct aoc_solver_t *solver, const char *dir, uint64_t seed, unsigned long int max_scale, int runs, struct probe_point_t points[], int *points_len)
+{
+    *points_len = 0;
+
+    for(unsigned long int scale = 1; scale <= max_scale && *points_len < MAX_SIZES; scale *= 2) {
+        char path[PATH_LEN];
+        snprintf(path, PATH_LEN, "%s/%s/input.%lux.in", dir, solver->name, scale);
+
+        struct stat st;
+        if(stat(path, &st) != 0 && generate(dir, solver->name, seed, scale, path)) {
+            return 1;
+        }
+
+        FILE *file = fopen(path, "rb");
+        if(file == NULL) {
+            fprintf(stderr, "Unexpected error: cannot read %s.\n", path);
+            return 1;
+        }
+
+        struct input_t input;
+        input_open(&input, file);
+        fclose(file);
+
+        if(*points_len > 0 && input.len <= points[*points_len - 1].bytes) {
+            input_release(&input);
+            break;
+        }
+
+        struct probe_point_t *point = points + *points_len;
+        point->bytes = input.len;
+        int ret = time_solver(solver, &input, runs, point->min_ns);
+        input_release(&input);
+
+        if(ret) {
+            fprintf(stderr, "Unexpected error: %s failed on %s.\n", solver->name, path);
+            return 1;
+        }
+
+        (*points_len)++;
+    }
+
+    return 0;
+}
+
+static int generate(const char *dir, const char *day, uint64_t seed, unsigned long int scale, const char *path)
+{
+    char gen[PATH_LEN];
+    char seed_arg[32];
+    char scale_arg[32];
+    snprintf(gen, PATH_LEN, "%s/%s/aocd%s_gen", dir, day, day + 3);
+    snprintf(seed_arg, sizeof(seed_arg), "%llu", (unsigned long long)seed);
+    snprintf(scale_arg, sizeof(scale_arg), "%lu", scale);
+
+    fflush(stdout);
+
+    pid_t pid = fork();
+    if(pid < 0) {
+        fprintf(stderr, "Unexpected error: cannot run %s: %s.\n", gen, strerror(errno));
+        return 1;
+    }
+
+    if(pid == 0) {
+        execl(gen, gen, seed_arg, scale_arg, path, (char *)NULL);
+        fprintf(stderr, "Unexpected error: cannot run %s: %s.\n", gen, strerror(errno));
+        _exit(EXIT_FAILURE);
+    }
+
+    int status;
+    while(waitpid(pid, &status, 0) < 0) {
+        if(errno != EINTR) {
+            return 1;
+        }
+    }
+
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "Unexpected error: %s failed to write %s.\n", gen, path);
+        unlink(path);
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * The fastest of the runs, per phase and in total: noise only ever adds time.
+ */
+static int time_solver(const struct aoc_solver_t *solver, const struct input_t *input, int runs, uint64_t min_ns[])
+{
+    for(int series = 0; series < PROBE_SERIES; series++) {
+        min_ns[series] = UINT64_MAX;
+    }
+
+    for(int run = 0; run < runs; run++) {
+        FILE *stream = fmemopen((void *)input->data, input->len, "r");
+        if(stream == NULL) {
+            perror("Fatal error: Cannot open input stream.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        struct aoc_answer_t answer;
+        answer_init(&answer);
+
+        uint64_t start = clock_now_ns();
+        int ret = solver->solve(stream, &answer);
+        uint64_t total = clock_now_ns() - start;
+
+        fclose(stream);
+
+        if(ret) {
+            answer_release(&answer);
+            return 1;
+        }
+
+        for(int phase = 0; phase < AOC_PHASES; phase++) {
+            if(answer.phase_ns[phase] < min_ns[phase]) {
+                min_ns[phase] = answer.phase_ns[phase];
+            }
+        }
+        if(total < min_ns[PROBE_TOTAL]) {
+            min_ns[PROBE_TOTAL] = total;
+        }
+
+        answer_release(&answer);
+    }
+
+    return 0;
+}
+
+/*
+ * A least squares line through log time over log size gives the exponent.
+ * Each model is fitted with a fixed cost, t = c + a * f(n), minimising the
+ * relative error: with u = 1 / t and r = f(n) / t that is the sum of
+ * (c * u + a * r - 1)^2, two normal equations in c and a. f is scaled to 1 at
+ * the largest size to keep the sums in range. A negative c, from a model that
+ * grows too slowly, is refitted as 0. The model with the smallest remaining
+ * error is the best fit. Returns 1 when too few sizes are slow enough to fit.
+ */
+static int fit(const struct probe_point_t points[], int points_len, int series, struct probe_fit_t *result)
+{
+    double n[MAX_SIZES], t[MAX_SIZES];
+    int sizes = 0;
+
+    for(int i = 0; i < points_len; i++) {
+        if(points[i].min_ns[series] >= MIN_FIT_NS) {
+            n[sizes] = (double)points[i].bytes;
+            t[sizes] = (double)points[i].min_ns[series];
+            sizes++;
+        }
+    }
+
+    if(sizes < MIN_FIT_SIZES) {
+        return 1;
+    }
+
+    double sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+    for(int i = 0; i < sizes; i++) {
+        double x = log(n[i]);
+        double y = log(t[i]);
+
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+    }
+
+    result->sizes = sizes;
+    result->exponent = (sizes * sum_xy - sum_x * sum_y) / (sizes * sum_xx - sum_x * sum_x);
+    result->best = MODEL_N;
+
+    for(int m = 0; m < MODELS; m++) {
+        double largest = model((enum model_t)m, n[sizes - 1]);
+        double u[MAX_SIZES], r[MAX_SIZES];
+        double sum_u = 0.0, sum_uu = 0.0, sum_r = 0.0, sum_rr = 0.0, sum_ur = 0.0;
+
+        for(int i = 0; i < sizes; i++) {
+            u[i] = 1.0 / t[i];
+            r[i] = model((enum model_t)m, n[i]) / largest / t[i];
+
+            sum_u += u[i];
+            sum_uu += u[i] * u[i];
+            sum_r += r[i];
+            sum_rr += r[i] * r[i];
+            sum_ur += u[i] * r[i];
+        }
+
+        double det = sum_uu * sum_rr - sum_ur * sum_ur;
+        double c = (sum_u * sum_rr - sum_r * sum_ur) / det;
+        double a = (sum_uu * sum_r - sum_ur * sum_u) / det;
+        if(!(c >= 0.0)) {
+            c = 0.0;
+            a = sum_r / sum_rr;
+        }
+
+        double residual = 0.0;
+        for(int i = 0; i < sizes; i++) {
+            double e = c * u[i] + a * r[i] - 1.0;
+            residual += e * e;
+        }
+        result->error[m] = sqrt(residual / sizes);
+
+        if(result->error[m] < result->error[result->best]) {
+            result->best = (enum model_t)m;
+        }
+    }
+
+    return 0;
+}
+
+static double model(enum model_t model, double n)
+{
+    switch(model) {
+        case MODEL_N:
+            return n;
+        case MODEL_N_LOG_N:
+            return n * log2(n);
+        case MODEL_N2:
+            return n * n;
+        case MODEL_N3:
+            return n * n * n;
+        default:
+            return n;
+    }
+}
+
+/*
+ * A series without a recorded exponent passes, like a day without a baseline
+ * time in aoc_bench.
+ */
+static int check_exponent(const struct table_t *baseline, double slack, const char *day, const char *series, double exponent)
+{
+    const struct table_row_t *row = table_find(baseline, day, series);
+    if(row == NULL || row->fields[2] == NULL) {
+        fprintf(stdout, "  no baseline exponent for %s %s\n", day, series);
+        return 0;
+    }
+
+    double baseline_exponent = strtod(row->fields[2], NULL);
+    if(fabs(exponent - baseline_exponent) <= slack) {
+        return 0;
+    }
+
+    fprintf(stderr, "Unexpected result: %s %s now scales as n^%.2f, its baseline is n^%.2f.\n", day, series, exponent, baseline_exponent);
+
+    return 1;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-n runs] [-s max scale] [-r seed] [-C dir]\n"
+                    "          [-b exponents.tsv [-t slack]] [-w exponents.tsv] [day...]\n"
+                    "\n"
+                    "Runs each solver in-process on generated inputs at scales 1, 2, 4, ... up to\n"
+                    "<max scale>, keeping the fastest of <runs> runs of each, and fits how the\n"
+                    "time of each phase grows with the input's size: the exponent of the best\n"
+                    "power law, and how far off n, n log n, n^2 and n^3 each are. Inputs are\n"
+                    "read from <dir>/<day>/input.<scale>x.in, and generated there with the day's\n"
+                    "generator and <seed> when missing.\n"
+                    "\n"
+                    "-b fails when an exponent is more than <slack> (default 0.5) away from the\n"
+                    "recorded one, and -w records the exponents as a new baseline.\n", prog);
+}
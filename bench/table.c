@@ -0,0 +1,178 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "table.h"
+
+#define DEFAULT_ROWS_LEN 64
+
+static char *read_text(FILE *file);
+static void unescape(char *field);
+
+/*
+ * Returns 1 if the file cannot be read. A row with the wrong number of fields
+ * is bad input and exits.
+ */
+int table_load(struct table_t *table, const char *path, size_t fields_len)
+{
+    FILE *file = fopen(path, "rb");
+    if(file == NULL) {
+        return 1;
+    }
+
+    table->data = read_text(file);
+    fclose(file);
+
+    size_t rows_cap = DEFAULT_ROWS_LEN;
+    table->rows_len = 0;
+    table->rows = (struct table_row_t *)malloc(sizeof(struct table_row_t) * rows_cap);
+    if(table->rows == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t line_no = 0;
+    char *line = table->data;
+    while(*line) {
+        char *end = strchr(line, '\n');
+        char *next = end != NULL ? end + 1 : line + strlen(line);
+        if(end != NULL) {
+            *end = 0;
+        }
+        line_no++;
+
+        if(line[0] != 0 && line[0] != '#') {
+            if(table->rows_len >= rows_cap) {
+                rows_cap *= 2;
+                table->rows = (struct table_row_t *)realloc(table->rows, sizeof(struct table_row_t) * rows_cap);
+                if(table->rows == NULL) {
+                    perror("Fatal error: Cannot allocate memory.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+
+            struct table_row_t *row = &table->rows[table->rows_len++];
+            size_t field = 0;
+            char *start = line;
+            while(1) {
+                char *tab = strchr(start, '\t');
+                if(field >= fields_len) {
+                    fprintf(stderr, "Unexpected input: %s:%zu has more than %zu fields.\n", path, line_no, fields_len);
+                    exit(1);
+                }
+
+                row->fields[field++] = start;
+                if(tab == NULL) {
+                    break;
+                }
+
+                *tab = 0;
+                start = tab + 1;
+            }
+
+            if(field != fields_len) {
+                fprintf(stderr, "Unexpected input: %s:%zu has %zu fields, expected %zu.\n", path, line_no, field, fields_len);
+                exit(1);
+            }
+
+            for(size_t i = 2; i < fields_len; i++) {
+                if(strcmp(row->fields[i], "-") == 0) {
+                    row->fields[i] = NULL;
+                } else {
+                    unescape(row->fields[i]);
+                }
+            }
+        }
+
+        line = next;
+    }
+
+    return 0;
+}
+
+const struct table_row_t *table_find(const struct table_t *table, const char *day, const char *input)
+{
+    for(size_t i = 0; i < table->rows_len; i++) {
+        const struct table_row_t *row = &table->rows[i];
+        if(strcmp(row->fields[0], day) == 0 && strcmp(row->fields[1], input) == 0) {
+            return row;
+        }
+    }
+
+    return NULL;
+}
+
+void table_print_field(FILE *stream, const char *value)
+{
+    if(value == NULL) {
+        fputc('-', stream);
+        return;
+    }
+
+    for(const char *c = value; *c; c++) {
+        switch(*c) {
+            case '\n':
+                fputs("\\n", stream);
+                break;
+            case '\t':
+                fputs("\\t", stream);
+                break;
+            case '\\':
+                fputs("\\\\", stream);
+                break;
+            default:
+                fputc(*c, stream);
+        }
+    }
+}
+
+void table_release(struct table_t *table)
+{
+    free(table->rows);
+    free(table->data);
+
+    table->rows = NULL;
+    table->data = NULL;
+    table->rows_len = 0;
+}
+
+static char *read_text(FILE *file)
+{
+    size_t buff_len = 4096;
+    size_t buff_index = 0;
+    char *buffer = (char *)malloc(sizeof(char) * buff_len);
+    if(buffer == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t read;
+    while((read = fread(buffer + buff_index, 1, buff_len - buff_index - 1, file)) > 0) {
+        buff_index += read;
+        if(buff_index == buff_len - 1) {
+            buff_len *= 2;
+            buffer = (char *)realloc(buffer, sizeof(char) * buff_len);
+            if(buffer == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    buffer[buff_index] = 0;
+    return buffer;
+}
+
+static void unescape(char *field)
+{
+    char *out = field;
+    for(char *c = field; *c; c++) {
+        if(*c == '\\' && c[1] != 0) {
+            c++;
+            *out++ = *c == 'n' ? '\n' : *c == 't' ? '\t' : *c;
+        } else {
+            *out++ = *c;
+        }
+    }
+
+    *out = 0;
+}
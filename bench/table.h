@@ -0,0 +1,31 @@
+#ifndef AOC_TABLE_H
+#define AOC_TABLE_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define TABLE_MAX_FIELDS 4
+
+/*
+ * The tab separated files the tests compare against: one row per day and
+ * input, keyed by the first two fields (e.g. "day3", "input.10x.in").
+ * Empty lines and lines starting with '#' are skipped. In the other fields a
+ * newline, tab or backslash is written as "\n", "\t" or "\\", and a field that
+ * is just "-" stands for a missing value, which table_load() turns into NULL.
+ */
+struct table_row_t {
+    char *fields[TABLE_MAX_FIELDS];
+};
+
+struct table_t {
+    char *data;
+    struct table_row_t *rows;
+    size_t rows_len;
+};
+
+int table_load(struct table_t *table, const char *path, size_t fields_len);
+const struct table_row_t *table_find(const struct table_t *table, const char *day, const char *input);
+void table_print_field(FILE *stream, const char *value);
+void table_release(struct table_t *table);
+
+#endif //AOC_TABLE_H
@@ -0,0 +1,55 @@
+# Two-stage profile-guided build, run as cmake -P (the pgo target does this).
+#
+#   1. Configure ${AOC_BINARY_DIR}/pgo with AOC_PGO=GENERATE, build it, and run
+#      every solver once on input.in and the test-scale input to write profiles.
+#   2. Reconfigure the same tree with AOC_PGO=USE and AOC_LTO=ON and rebuild it
+#      from scratch. GCC finds each profile by the path of the object it was
+#      written for, which is why both stages share one tree.
+#   3. Build a plain Release tree in ${AOC_BINARY_DIR}/pgo-release, record its
+#      times, and benchmark the PGO build against them.
+
+foreach(var AOC_SOURCE_DIR AOC_BINARY_DIR AOC_GEN_SEED AOC_TEST_SCALE AOC_PGO_RUNS)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "pgo.cmake: ${var} is not set")
+    endif()
+endforeach()
+
+set(pgo_dir ${AOC_BINARY_DIR}/pgo)
+set(release_dir ${AOC_BINARY_DIR}/pgo-release)
+set(profile_dir ${pgo_dir}/profile)
+set(release_times ${release_dir}/release.tsv)
+set(common_args -DCMAKE_BUILD_TYPE=Release -DAOC_GEN_SEED=${AOC_GEN_SEED})
+
+function(run)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        string(REPLACE ";" " " command "${ARGN}")
+        message(FATAL_ERROR "pgo.cmake: '${command}' failed: ${result}")
+    endif()
+endfunction()
+
+message(STATUS "PGO stage 1: instrumented build in ${pgo_dir}")
+file(REMOVE_RECURSE ${profile_dir})
+run(${CMAKE_COMMAND} -S ${AOC_SOURCE_DIR} -B ${pgo_dir} ${common_args}
+        -DAOC_PGO=GENERATE -DAOC_PGO_DIR=${profile_dir} -DAOC_LTO=ON)
+run(${CMAKE_COMMAND} --build ${pgo_dir} --clean-first)
+run(${CMAKE_COMMAND} --build ${pgo_dir} --target test_inputs)
+
+message(STATUS "PGO stage 1: training on input.in and input.${AOC_TEST_SCALE}x.in")
+run(${pgo_dir}/bench/aoc_bench -n 1 -x ${AOC_TEST_SCALE}x -C ${pgo_dir})
+
+message(STATUS "PGO stage 2: optimized build in ${pgo_dir}")
+run(${CMAKE_COMMAND} -S ${AOC_SOURCE_DIR} -B ${pgo_dir} ${common_args}
+        -DAOC_PGO=USE -DAOC_PGO_DIR=${profile_dir} -DAOC_LTO=ON)
+run(${CMAKE_COMMAND} --build ${pgo_dir} --clean-first)
+
+message(STATUS "Plain Release build in ${release_dir}")
+run(${CMAKE_COMMAND} -S ${AOC_SOURCE_DIR} -B ${release_dir} ${common_args}
+        -DAOC_PGO=OFF -DAOC_LTO=OFF)
+run(${CMAKE_COMMAND} --build ${release_dir})
+run(${CMAKE_COMMAND} --build ${release_dir} --target test_inputs)
+run(${release_dir}/bench/aoc_bench -n ${AOC_PGO_RUNS} -x ${AOC_TEST_SCALE}x -w ${release_times} -C ${release_dir})
+
+message(STATUS "PGO+LTO build against plain Release")
+run(${CMAKE_COMMAND} --build ${pgo_dir} --target test_inputs)
+run(${pgo_dir}/bench/aoc_bench -n ${AOC_PGO_RUNS} -x ${AOC_TEST_SCALE}x -b ${release_times} -C ${pgo_dir})
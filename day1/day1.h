@@ -0,0 +1,8 @@
+#ifndef AOC_DAY1_H
+#define AOC_DAY1_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day1_solver;
+
+#endif //AOC_DAY1_H
@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gen.h"
+
+#define BASE_OFFSETS 1000
+#define MAX_OFFSET 19
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    long int offsets_len = BASE_OFFSETS * (long int)args.scale;
+    int *offsets = (int *)malloc(sizeof(int) * offsets_len);
+    if(offsets == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    long int total = 0;
+    for(long int i = 0; i < offsets_len; i++) {
+        int offset = (int)rng_range(&rng, 1, MAX_OFFSET);
+        offsets[i] = rng_chance(&rng, 50) ? offset : -offset;
+        total += offsets[i];
+    }
+
+    /*
+     * A frequency is only ever reached twice if the drift per pass is non-zero
+     * and smaller than the number of offsets, so steer the total into that
+     * range by nudging random offsets.
+     */
+    long int target = rng_range(&rng, 1, offsets_len / 4 > 1 ? offsets_len / 4 : 1);
+    if(rng_chance(&rng, 50)) {
+        target = -target;
+    }
+
+    while(total != target) {
+        long int index = rng_range(&rng, 0, offsets_len - 1);
+        long int delta = target - total;
+
+        long int adjusted = offsets[index] + delta;
+        if(adjusted > MAX_OFFSET) {
+            adjusted = MAX_OFFSET;
+        } else if(adjusted < -MAX_OFFSET) {
+            adjusted = -MAX_OFFSET;
+        }
+
+        if(adjusted == 0) {
+            adjusted = delta > 0 ? 1 : -1;
+        }
+
+        total += adjusted - offsets[index];
+        offsets[index] = (int)adjusted;
+    }
+
+    for(long int i = 0; i < offsets_len; i++) {
+        fprintf(args.out, "%+d\n", offsets[i]);
+    }
+
+    free(offsets);
+    gen_close(&args);
+
+    return 0;
+}
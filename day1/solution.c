@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hashmap.h"
+#include "input.h"
+#include "scan.h"
+#include "stream.h"
+#include "day1.h"
+
+#define BUFF_LEN 32
+
+static int parse_offset(struct view_t line, void *record);
+static int determine_frequency_reached_twice(const int32_t *offsets, int offset_len);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    int freq = 0;
+
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct view_t rest;
+    input_remaining(&reader, &rest);
+
+    int32_t *offsets = (int32_t *)malloc(sizeof(int32_t) * (SCAN_MAX_INTEGERS(rest.len) + 1));
+    if(offsets == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int offsets_index = (int)scan_int32(rest.ptr, rest.len, offsets, SCAN_MAX_INTEGERS(rest.len));
+    if(offsets_index == 0) {
+        fprintf(stderr, "Unexpected input: no frequency changes.\n");
+        exit(1);
+    }
+
+    input_release(&reader);
+
+    for(int i = 0; i < offsets_index; i++) {
+        freq = freq + offsets[i];
+    }
+
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    answer_printf(&answer->part1, "%d", freq);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    freq = determine_frequency_reached_twice(offsets, offsets_index);
+    answer_printf(&answer->part2, "%d", freq);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    free(offsets);
+
+    return 0;
+}
+
+/*
+ * The running frequency is part 1, so it is kept up to date as each change
+ * arrives; the changes themselves are still needed for part 2.
+ */
+static int solve_stream(FILE *input, struct aoc_answer_t *answer)
+{
+    struct stream_t stream;
+    stream_open(&stream, input, sizeof(int32_t), parse_offset);
+
+    int offsets_index = 0;
+    int offsets_len = BUFF_LEN;
+    int32_t *offsets = (int32_t *)malloc(sizeof(int32_t) * offsets_len);
+    if(offsets == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int freq = 0;
+    const int32_t *offset;
+    while((offset = (const int32_t *)stream_next(&stream)) != NULL) {
+        freq = freq + *offset;
+
+        if(offsets_index >= offsets_len) {
+            offsets_len = offsets_len * 2;
+            offsets = (int32_t *)realloc(offsets, sizeof(int32_t) * offsets_len);
+            if(offsets == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        offsets[offsets_index] = *offset;
+        offsets_index++;
+    }
+
+    stream_close(&stream);
+
+    if(offsets_index == 0) {
+        fprintf(stderr, "Unexpected input: no frequency changes.\n");
+        exit(1);
+    }
+
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    answer_printf(&answer->part1, "%d", freq);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    freq = determine_frequency_reached_twice(offsets, offsets_index);
+    answer_printf(&answer->part2, "%d", freq);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    free(offsets);
+
+    return 0;
+}
+
+static int parse_offset(struct view_t line, void *record)
+{
+    long int value;
+    if(view_parse_long(&line, &value)) {
+        return 1;
+    }
+
+    *(int32_t *)record = (int32_t)value;
+
+    return 0;
+}
+
+static int determine_frequency_reached_twice(const int32_t *offsets, int offset_len)
+{
+    int curr_freq = 0;
+
+    struct hashset_t freqs_encountered;
+    hashset_init(&freqs_encountered, (size_t)offset_len);
+    hashset_add(&freqs_encountered, (uint64_t)(uint32_t)curr_freq);
+
+    int offset_index = 0;
+    int found = 0;
+    while(!found) {
+        curr_freq = curr_freq + offsets[offset_index];
+        offset_index = (offset_index + 1) % offset_len;
+
+        if(!hashset_add(&freqs_encountered, (uint64_t)(uint32_t)curr_freq)) {
+            found = 1;
+        }
+    }
+
+    hashset_release(&freqs_encountered);
+
+    return curr_freq;
+}
+
+const struct aoc_solver_t day1_solver = {.name = "day1", .solve = solve, .solve_stream = solve_stream};
@@ -0,0 +1,8 @@
+#ifndef AOC_DAY10_H
+#define AOC_DAY10_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day10_solver;
+
+#endif //AOC_DAY10_H
@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gen.h"
+
+#define BASE_LETTERS 8
+#define GLYPH_WIDTH 6
+#define GLYPH_HEIGHT 10
+#define GLYPH_SPACING 8
+#define MAX_VELOCITY 5
+#define MIN_SECONDS 10000
+#define MAX_SECONDS 10999
+
+struct point_t {
+    long int x;
+    long int y;
+    int velocity_x;
+    int velocity_y;
+};
+
+/*
+ * The letters that appear in the real puzzle messages.
+ */
+static const char *const glyphs[][GLYPH_HEIGHT] = {
+    {"..##..", ".#..#.", "#....#", "#....#", "#....#", "######", "#....#", "#....#", "#....#", "#....#"},
+    {"#####.", "#....#", "#....#", "#....#", "#####.", "#....#", "#....#", "#....#", "#....#", "#####."},
+    {".####.", "#....#", "#.....", "#.....", "#.....", "#.....", "#.....", "#.....", "#....#", ".####."},
+    {"######", "#.....", "#.....", "#.....", "#####.", "#.....", "#.....", "#.....", "#.....", "######"},
+    {"######", "#.....", "#.....", "#.....", "#####.", "#.....", "#.....", "#.....", "#.....", "#....."},
+    {".####.", "#....#", "#.....", "#.....", "#.....", "#..###", "#....#", "#....#", "#...##", ".###.#"},
+    {"#....#", "#....#", "#....#", "#....#", "######", "#....#", "#....#", "#....#", "#....#", "#....#"},
+    {"...###", "....#.", "....#.", "....#.", "....#.", "....#.", "....#.", "#...#.", "#...#.", ".###.."},
+    {"#....#", "#...#.", "#..#..", "#.#...", "##....", "##....", "#.#...", "#..#..", "#...#.", "#....#"},
+    {"#.....", "#.....", "#.....", "#.....", "#.....", "#.....", "#.....", "#.....", "#.....", "######"},
+    {"#....#", "##...#", "##...#", "#.#..#", "#.#..#", "#..#.#", "#..#.#", "#...##", "#...##", "#....#"},
+    {"#####.", "#....#", "#....#", "#....#", "#####.", "#.....", "#.....", "#.....", "#.....", "#....."},
+    {"#####.", "#....#", "#....#", "#....#", "#####.", "#..#..", "#...#.", "#...#.", "#....#", "#....#"},
+    {"#....#", "#....#", ".#..#.", ".#..#.", "..##..", "..##..", ".#..#.", ".#..#.", "#....#", "#....#"},
+    {"######", ".....#", ".....#", "....#.", "...#..", "..#...", ".#....", "#.....", "#.....", "######"},
+};
+
+static long int pick_point(struct rng_t *rng, struct point_t points[], long int points_len, int on_edge(struct point_t, long int), long int edge, long int skip);
+static int on_row(struct point_t point, long int row);
+static int on_column(struct point_t point, long int column);
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    long int letters_len = BASE_LETTERS * (long int)args.scale;
+    long int glyphs_len = sizeof(glyphs) / sizeof(glyphs[0]);
+
+    long int points_len = 0;
+    long int points_cap = letters_len * GLYPH_WIDTH * GLYPH_HEIGHT;
+    struct point_t *points = (struct point_t *)malloc(sizeof(struct point_t) * points_cap);
+    if(points == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    long int origin_x = rng_range(&rng, 100, 200);
+    long int origin_y = rng_range(&rng, 100, 200);
+    for(long int letter = 0; letter < letters_len; letter++) {
+        const char *const *glyph = glyphs[rng_range(&rng, 0, glyphs_len - 1)];
+
+        for(int row = 0; row < GLYPH_HEIGHT; row++) {
+            for(int column = 0; column < GLYPH_WIDTH; column++) {
+                if(glyph[row][column] != '#') {
+                    continue;
+                }
+
+                struct point_t point;
+                point.x = origin_x + letter * GLYPH_SPACING + column;
+                point.y = origin_y + row;
+
+                do {
+                    point.velocity_x = (int)rng_range(&rng, -MAX_VELOCITY, MAX_VELOCITY);
+                } while(point.velocity_x == 0);
+
+                do {
+                    point.velocity_y = (int)rng_range(&rng, -MAX_VELOCITY, MAX_VELOCITY);
+                } while(point.velocity_y == 0);
+
+                points[points_len++] = point;
+            }
+        }
+    }
+
+    /*
+     * The solver looks for the moment both extents of the bounding box are
+     * smallest. Pinning the velocities of a few points on its edges makes the
+     * box strictly larger at every other moment: before the message appears
+     * the left and right edges close in and the top and bottom rows converge,
+     * and afterwards the top and bottom rows keep spreading.
+     */
+    long int top_row = points[0].y, bottom_row = points[0].y;
+    long int left_column = points[0].x, right_column = points[0].x;
+    for(long int i = 1; i < points_len; i++) {
+        if(points[i].y < top_row) {
+            top_row = points[i].y;
+        }
+
+        if(points[i].y > bottom_row) {
+            bottom_row = points[i].y;
+        }
+
+        if(points[i].x < left_column) {
+            left_column = points[i].x;
+        }
+
+        if(points[i].x > right_column) {
+            right_column = points[i].x;
+        }
+    }
+
+    long int top_a = pick_point(&rng, points, points_len, on_row, top_row, -1);
+    long int top_b = pick_point(&rng, points, points_len, on_row, top_row, top_a);
+    long int bottom_a = pick_point(&rng, points, points_len, on_row, bottom_row, -1);
+    long int bottom_b = pick_point(&rng, points, points_len, on_row, bottom_row, bottom_a);
+    points[top_a].velocity_y = MAX_VELOCITY;
+    points[bottom_a].velocity_y = -MAX_VELOCITY;
+    points[top_b].velocity_y = -MAX_VELOCITY;
+    points[bottom_b].velocity_y = MAX_VELOCITY;
+    points[pick_point(&rng, points, points_len, on_column, left_column, -1)].velocity_x = MAX_VELOCITY;
+    points[pick_point(&rng, points, points_len, on_column, right_column, -1)].velocity_x = -MAX_VELOCITY;
+
+    long int seconds = rng_range(&rng, MIN_SECONDS, MAX_SECONDS);
+    rng_shuffle(&rng, points, points_len, sizeof(struct point_t));
+
+    for(long int i = 0; i < points_len; i++) {
+        struct point_t point = points[i];
+        fprintf(args.out, "position=<%6ld, %6ld> velocity=<%2d, %2d>\n",
+                point.x - point.velocity_x * seconds, point.y - point.velocity_y * seconds, point.velocity_x, point.velocity_y);
+    }
+
+    free(points);
+    gen_close(&args);
+
+    return 0;
+}
+
+static long int pick_point(struct rng_t *rng, struct point_t points[], long int points_len, int on_edge(struct point_t, long int), long int edge, long int skip)
+{
+    long int candidates = 0;
+    for(long int i = 0; i < points_len; i++) {
+        if(i != skip && on_edge(points[i], edge)) {
+            candidates++;
+        }
+    }
+
+    if(candidates == 0) {
+        fprintf(stderr, "Unexpected error: message has too few points on its edge.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    long int pick = rng_range(rng, 0, candidates - 1);
+    for(long int i = 0; i < points_len; i++) {
+        if(i != skip && on_edge(points[i], edge) && pick-- == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static int on_row(struct point_t point, long int row)
+{
+    return point.y == row;
+}
+
+static int on_column(struct point_t point, long int column)
+{
+    return point.x == column;
+}
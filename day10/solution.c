@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "input.h"
+#include "scan.h"
+#include "day10.h"
+
+#define BUFF_LEN 64
+#define OFFSET 0
+#define PIXEL_ON "▓"
+#define PIXEL_OFF "░"
+
+struct moving_point_t {
+    long int x;
+    long int y;
+    int velocity_x;
+    int velocity_y;
+};
+
+static int build_point_from_input(struct view_t line, struct moving_point_t *point);
+static char *build_message(struct moving_point_t points[], int points_len);
+static long int find_smallest_point_distribution(const struct moving_point_t points[], int points_len);
+static struct moving_point_t *advance_points_n_seconds(struct moving_point_t points[], int points_len, long int seconds);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    int points_len = BUFF_LEN;
+    int points_index = 0;
+    struct moving_point_t *points = (struct moving_point_t *)malloc(sizeof(struct moving_point_t) * points_len);
+    if(points == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct view_t line;
+    while(input_next_line(&reader, &line)) {
+        if(points_index >= points_len) {
+            points_len = points_len * 2;
+            points = (struct moving_point_t *)realloc(points, sizeof(struct moving_point_t) * points_len);
+            if(points == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if(build_point_from_input(line, &points[points_index])) {
+            fprintf(stderr, "Unexpected input: %.*s\n", (int)line.len, line.ptr);
+            exit(1);
+        }
+        points_index++;
+    }
+
+    input_release(&reader);
+
+    points_len = points_index;
+    points = (struct moving_point_t *)realloc(points, sizeof(struct moving_point_t) * points_len);
+    if(points == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    long int smallest_distribution_time = find_smallest_point_distribution(points, points_len);
+    advance_points_n_seconds(points, points_len, smallest_distribution_time + OFFSET);
+
+    answer->part1 = build_message(points, points_len);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    answer_printf(&answer->part2, "%ld", smallest_distribution_time);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    free(points);
+
+    return 0;
+}
+
+static int build_point_from_input(struct view_t line, struct moving_point_t *point)
+{
+    int32_t fields[5];
+    if(scan_int32(line.ptr, line.len, fields, 5) != 4) {
+        return 1;
+    }
+
+    point->x = fields[0];
+    point->y = fields[1];
+    point->velocity_x = fields[2];
+    point->velocity_y = fields[3];
+
+    return 0;
+}
+
+static char *build_message(struct moving_point_t points[], int points_len)
+{
+    long int lower_x = points[0].x;
+    long int upper_x = points[0].x;
+    long int lower_y = points[0].y;
+    long int upper_y = points[0].y;
+    for(int i = 0; i < points_len; i++) {
+        if(points[i].x < lower_x) {
+            lower_x = points[i].x;
+        }
+
+        if(points[i].x > upper_x) {
+            upper_x = points[i].x;
+        }
+
+        if(points[i].y < lower_y) {
+            lower_y = points[i].y;
+        }
+
+        if(points[i].y > upper_y) {
+            upper_y = points[i].y;
+        }
+    }
+
+    size_t row_len = (size_t)(upper_x - lower_x + 3) * (sizeof(PIXEL_ON) - 1) + 1;
+    size_t message_len = (size_t)(upper_y - lower_y + 3) * row_len + 1;
+    char *message = (char *)malloc(sizeof(char) * message_len);
+    if(message == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    char *cursor = message;
+    for(long int y = lower_y - 1; y <= upper_y + 1; y++) {
+        for(long int x = lower_x - 1; x <= upper_x + 1; x++) {
+            int found = 0;
+            for(int i = 0; i < points_len; i++) {
+                if(points[i].x == x && points[i].y == y) {
+                    found = 1;
+                    break;
+                }
+            }
+
+            const char *pixel = found ? PIXEL_ON : PIXEL_OFF;
+            memcpy(cursor, pixel, sizeof(PIXEL_ON) - 1);
+            cursor += sizeof(PIXEL_ON) - 1;
+        }
+
+        *cursor++ = '\n';
+    }
+
+    *cursor = 0;
+
+    return message;
+}
+
+static long int find_smallest_point_distribution(const struct moving_point_t points[], int points_len)
+{
+    struct moving_point_t *mutable_points = (struct moving_point_t *)malloc(sizeof(struct moving_point_t) * points_len);
+    if(mutable_points == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(mutable_points, points, sizeof(struct moving_point_t) * points_len);
+
+    long int record_seconds = 0;
+    long int record_delta_x = 500000;
+    long int record_delta_y = 500000;
+
+    long int seconds = 0;
+    long int current_delta_x = 0;
+    long int current_delta_y = 0;
+    while(current_delta_x < 500000 && current_delta_y < 500000) {
+        seconds++;
+        advance_points_n_seconds(mutable_points, points_len, 1);
+
+        long int lower_x = mutable_points[0].x;
+        long int upper_x = mutable_points[0].x;
+        long int lower_y = mutable_points[0].y;
+        long int upper_y = mutable_points[0].y;
+        for(int i = 0; i < points_len; i++) {
+            if(mutable_points[i].x < lower_x) {
+                lower_x = mutable_points[i].x;
+            }
+
+            if(mutable_points[i].x > upper_x) {
+                upper_x = mutable_points[i].x;
+            }
+
+            if(mutable_points[i].y < lower_y) {
+                lower_y = mutable_points[i].y;
+            }
+
+            if(mutable_points[i].y > upper_y) {
+                upper_y = mutable_points[i].y;
+            }
+        }
+
+        current_delta_x = upper_x - lower_x;
+        current_delta_y = upper_y - lower_y;
+
+        if(current_delta_x < record_delta_x && current_delta_y < record_delta_y) {
+            record_delta_x = current_delta_x;
+            record_delta_y = current_delta_y;
+            record_seconds = seconds;
+        }
+    }
+
+    free(mutable_points);
+
+    return record_seconds;
+}
+
+static struct moving_point_t *advance_points_n_seconds(struct moving_point_t points[], int points_len, long int seconds)
+{
+    for(int i = 0; i < points_len; i++) {
+        points[i].x = points[i].x + (points[i].velocity_x * seconds);
+        points[i].y = points[i].y + (points[i].velocity_y * seconds);
+    }
+
+    return points;
+}
+
+const struct aoc_solver_t day10_solver = {.name = "day10", .solve = solve};
@@ -0,0 +1,8 @@
+#ifndef AOC_DAY11_H
+#define AOC_DAY11_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day11_solver;
+
+#endif //AOC_DAY11_H
@@ -0,0 +1,25 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gen.h"
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    /*
+     * The grid is fixed at 300x300 by the puzzle and the input is only its
+     * serial number, so there is nothing to scale.
+     */
+    if(args.scale > 1) {
+        fprintf(stderr, "day11: the grid size is fixed, ignoring scale %lu.\n", args.scale);
+    }
+
+    fprintf(args.out, "%ld\n", rng_range(&rng, 1000, 9999));
+
+    gen_close(&args);
+
+    return 0;
+}
@@ -0,0 +1,353 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "cpu.h"
+#include "grid.h"
+#include "input.h"
+#include "parallel.h"
+#include "warm.h"
+#include "day11.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+#define CELL_DIM 300
+#define INTERFACE_DIM 3
+
+struct coord_t {
+    int x;
+    int y;
+};
+
+struct power_info_t {
+    struct coord_t coord;
+    int largest_power;
+    int dim;
+};
+
+/*
+ * Returns the largest total power of the count squares of side dim in a row,
+ * given the summed area table rows above the squares and along their bottom
+ * edge.
+ */
+typedef int (*row_max_t)(const int *above, const int *bottom, int dim, int count);
+
+struct power_table_t {
+    const struct grid_t *sat;
+    row_max_t row_max;
+};
+
+static struct grid_t *build_power_table(int grid_serial_num);
+static void release_power_table(void *sat);
+static void build_power_values_table(struct grid_t *power_values, int grid_serial_num);
+static int determine_power_value(struct coord_t coord, int grid_serial_number);
+static void build_summed_area_table(struct grid_t *sat, const struct grid_t *power_values);
+static struct power_info_t determine_largest_total_power_interface(const struct power_table_t *table, int interface_dim);
+static row_max_t select_row_max(void);
+static int row_max_scalar(const int *above, const int *bottom, int dim, int count);
+#ifdef CPU_X86
+CPU_TARGET_SSE42 static int row_max_sse42(const int *above, const int *bottom, int dim, int count);
+CPU_TARGET_AVX2 static int row_max_avx2(const int *above, const int *bottom, int dim, int count);
+CPU_TARGET_AVX512 static int row_max_avx512(const int *above, const int *bottom, int dim, int count);
+#endif
+static void largest_over_interface_dims(void *ctx, size_t begin, size_t end, void *acc);
+static void keep_largest(void *ctx, void *acc, const void *other);
+static int is_larger_interface(const struct power_info_t *a, const struct power_info_t *b);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct view_t token;
+    long int grid_serial_num;
+    if(!input_next_token(&reader, &token)) {
+        fprintf(stderr, "Unexpected error: cannot read puzzle input.\n");
+        exit(1);
+    }
+
+    if(view_parse_long(&token, &grid_serial_num) || token.len != 0) {
+        fprintf(stderr, "Unexpected input: %.*s\n", (int)token.len, token.ptr);
+        exit(1);
+    }
+
+    input_release(&reader);
+
+    struct grid_t *sat = (struct grid_t *)warm_take(&day11_solver, (uint64_t)grid_serial_num);
+    if(sat == NULL) {
+        sat = build_power_table((int)grid_serial_num);
+    }
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    struct power_table_t table = {.sat = sat, .row_max = select_row_max()};
+
+    struct power_info_t largest_pow_int = determine_largest_total_power_interface(&table, INTERFACE_DIM);
+    answer_printf(&answer->part1, "%d,%d", largest_pow_int.coord.x, largest_pow_int.coord.y);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    parallel_reduce(1, CELL_DIM + 1, 1, largest_over_interface_dims, keep_largest, &table, &largest_pow_int, sizeof(largest_pow_int));
+
+    answer_printf(&answer->part2, "%d,%d,%d", largest_pow_int.coord.x, largest_pow_int.coord.y, largest_pow_int.dim);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    warm_keep(&day11_solver, (uint64_t)grid_serial_num, sat, release_power_table);
+
+    return 0;
+}
+
+/*
+ * The summed area table only depends on the serial number, so a worker that
+ * is asked about the same grid again keeps it (see warm.h).
+ */
+static struct grid_t *build_power_table(int grid_serial_num)
+{
+    struct grid_t power_values;
+    grid_init(&power_values, CELL_DIM, CELL_DIM, 0, sizeof(int));
+    build_power_values_table(&power_values, grid_serial_num);
+
+    struct grid_t *sat = (struct grid_t *)malloc(sizeof(struct grid_t));
+    if(sat == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    grid_init(sat, CELL_DIM, CELL_DIM, 1, sizeof(int));
+    build_summed_area_table(sat, &power_values);
+
+    grid_release(&power_values);
+
+    return sat;
+}
+
+static void release_power_table(void *sat)
+{
+    grid_release((struct grid_t *)sat);
+    free(sat);
+}
+
+static void build_power_values_table(struct grid_t *power_values, int grid_serial_num)
+{
+    for(int i = 0; i < power_values->height; i++) {
+        int *row = GRID_ROW(power_values, int, i);
+
+        for(int j = 0; j < power_values->width; j++) {
+            struct coord_t this = {.x = j, .y = i};
+            row[j] = determine_power_value(this, grid_serial_num);
+        }
+    }
+}
+
+static int determine_power_value(struct coord_t coord, int grid_serial_number)
+{
+    coord.x += 1;
+    coord.y += 1;
+
+    int rack_id = coord.x + 10;
+
+    return (rack_id * coord.y + grid_serial_number) * rack_id / 100 % 10 - 5;
+}
+
+/*
+ * sat(x, y) is the sum of every power value at or above and left of (x, y).
+ * The table's zeroed border stands in for the empty sums at x = -1 and
+ * y = -1, so neither building it nor reading squares out of it needs edge
+ * cases.
+ */
+static void build_summed_area_table(struct grid_t *sat, const struct grid_t *power_values)
+{
+    for(int i = 0; i < sat->height; i++) {
+        const int *above = GRID_ROW(sat, int, i - 1);
+        const int *values = GRID_ROW(power_values, int, i);
+        int *row = GRID_ROW(sat, int, i);
+
+        for(int j = 0; j < sat->width; j++) {
+            row[j] = values[j] + above[j] + row[j - 1] - above[j - 1];
+        }
+    }
+}
+
+/*
+ * Only a row whose largest square beats the best so far is searched again
+ * for where that square is, so the position is that of the first largest
+ * square in reading order, as if every square were compared one by one.
+ */
+static struct power_info_t determine_largest_total_power_interface(const struct power_table_t *table, int interface_dim)
+{
+    const struct grid_t *sat = table->sat;
+    int count = sat->width - interface_dim + 1;
+
+    struct coord_t best = {.x = 0, .y = 0};
+    int best_val = 0;
+    int initialized = 0;
+
+    for(int y = 0; y <= sat->height - interface_dim; y++) {
+        const int *above = GRID_ROW(sat, int, y - 1);
+        const int *bottom = GRID_ROW(sat, int, y + interface_dim - 1);
+
+        int row_best = table->row_max(above, bottom, interface_dim, count);
+        if(initialized && row_best <= best_val) {
+            continue;
+        }
+
+        for(int x = 0; x < count; x++) {
+            int total = bottom[x + interface_dim - 1] - above[x + interface_dim - 1] - bottom[x - 1] + above[x - 1];
+
+            if(total == row_best) {
+                best.x = x + 1;
+                best.y = y + 1;
+                best_val = total;
+                initialized = 1;
+                break;
+            }
+        }
+    }
+
+    struct power_info_t power_info = {.coord = best, .largest_power = best_val, .dim = interface_dim};
+    return power_info;
+}
+
+static row_max_t select_row_max(void)
+{
+#ifdef CPU_X86
+    switch(cpu_tier()) {
+        case CPU_TIER_AVX512:
+            return row_max_avx512;
+        case CPU_TIER_AVX2:
+            return row_max_avx2;
+        case CPU_TIER_SSE42:
+            return row_max_sse42;
+        default:
+            break;
+    }
+#endif
+
+    return row_max_scalar;
+}
+
+static int row_max_scalar(const int *above, const int *bottom, int dim, int count)
+{
+    int best = INT_MIN;
+    for(int x = 0; x < count; x++) {
+        int total = bottom[x + dim - 1] - above[x + dim - 1] - bottom[x - 1] + above[x - 1];
+        if(total > best) {
+            best = total;
+        }
+    }
+
+    return best;
+}
+
+#ifdef CPU_X86
+/*
+ * A square's total is (bottom right - above right) + (above left - bottom
+ * left), a vector of neighbouring squares at a time. The SSE and AVX2
+ * versions finish with one vector ending at the last square, overlapping
+ * the one before, which cannot change a maximum.
+ */
+CPU_TARGET_SSE42 static int row_max_sse42(const int *above, const int *bottom, int dim, int count)
+{
+    if(count < 4) {
+        return row_max_scalar(above, bottom, dim, count);
+    }
+
+    __m128i best = _mm_set1_epi32(INT_MIN);
+    for(int x = 0; x < count; x += 4) {
+        int at = x + 4 <= count ? x : count - 4;
+
+        __m128i right = _mm_sub_epi32(_mm_loadu_si128((const __m128i *)(bottom + at + dim - 1)),
+                                      _mm_loadu_si128((const __m128i *)(above + at + dim - 1)));
+        __m128i left = _mm_sub_epi32(_mm_loadu_si128((const __m128i *)(above + at - 1)),
+                                     _mm_loadu_si128((const __m128i *)(bottom + at - 1)));
+        best = _mm_max_epi32(best, _mm_add_epi32(right, left));
+    }
+
+    best = _mm_max_epi32(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(1, 0, 3, 2)));
+    best = _mm_max_epi32(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return _mm_cvtsi128_si32(best);
+}
+
+CPU_TARGET_AVX2 static int row_max_avx2(const int *above, const int *bottom, int dim, int count)
+{
+    if(count < 8) {
+        return row_max_scalar(above, bottom, dim, count);
+    }
+
+    __m256i best = _mm256_set1_epi32(INT_MIN);
+    for(int x = 0; x < count; x += 8) {
+        int at = x + 8 <= count ? x : count - 8;
+
+        __m256i right = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)(bottom + at + dim - 1)),
+                                         _mm256_loadu_si256((const __m256i *)(above + at + dim - 1)));
+        __m256i left = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)(above + at - 1)),
+                                        _mm256_loadu_si256((const __m256i *)(bottom + at - 1)));
+        best = _mm256_max_epi32(best, _mm256_add_epi32(right, left));
+    }
+
+    __m128i half = _mm_max_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+    half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return _mm_cvtsi128_si32(half);
+}
+
+/*
+ * The last vector is masked instead, so rows shorter than a vector need no
+ * separate path.
+ */
+CPU_TARGET_AVX512 static int row_max_avx512(const int *above, const int *bottom, int dim, int count)
+{
+    __m512i best = _mm512_set1_epi32(INT_MIN);
+    for(int x = 0; x < count; x += 16) {
+        __mmask16 lanes = count - x >= 16 ? (__mmask16)0xffff : (__mmask16)((1u << (count - x)) - 1);
+
+        __m512i right = _mm512_sub_epi32(_mm512_maskz_loadu_epi32(lanes, bottom + x + dim - 1),
+                                         _mm512_maskz_loadu_epi32(lanes, above + x + dim - 1));
+        __m512i left = _mm512_sub_epi32(_mm512_maskz_loadu_epi32(lanes, above + x - 1),
+                                        _mm512_maskz_loadu_epi32(lanes, bottom + x - 1));
+        best = _mm512_mask_max_epi32(best, lanes, best, _mm512_add_epi32(right, left));
+    }
+
+    return _mm512_reduce_max_epi32(best);
+}
+#endif
+
+/*
+ * Larger squares have fewer positions to try, so the work per size shrinks
+ * quadratically; one size per range lets idle workers steal the small ones.
+ */
+static void largest_over_interface_dims(void *ctx, size_t begin, size_t end, void *acc)
+{
+    const struct power_table_t *table = (const struct power_table_t *)ctx;
+    struct power_info_t *largest = (struct power_info_t *)acc;
+
+    for(size_t i = begin; i < end; i++) {
+        struct power_info_t tmp = determine_largest_total_power_interface(table, (int)i);
+        if(is_larger_interface(&tmp, largest)) {
+            *largest = tmp;
+        }
+    }
+}
+
+static void keep_largest(void *ctx, void *acc, const void *other)
+{
+    (void)ctx;
+
+    if(is_larger_interface((const struct power_info_t *)other, (struct power_info_t *)acc)) {
+        *(struct power_info_t *)acc = *(const struct power_info_t *)other;
+    }
+}
+
+/*
+ * Ties go to the smaller square, so the answer does not depend on the order
+ * in which the sizes were tried.
+ */
+static int is_larger_interface(const struct power_info_t *a, const struct power_info_t *b)
+{
+    return a->largest_power > b->largest_power || (a->largest_power == b->largest_power && a->dim < b->dim);
+}
+
+const struct aoc_solver_t day11_solver = {.name = "day11", .solve = solve};
@@ -0,0 +1,14 @@
+#ifndef AOC_DAY12_H
+#define AOC_DAY12_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day12_solver;
+
+/*
+ * A plain, slow solver for the same puzzle, which aoc_verify checks
+ * day12_solver against (see verify/verify.c).
+ */
+extern const struct aoc_solver_t day12_reference;
+
+#endif //AOC_DAY12_H
@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gen.h"
+
+#define BASE_POTS 100
+#define RULES 32
+#define GENERATIONS_LIMIT 10000
+#define EQ_TOLERANCE 50
+#define MAX_ATTEMPTS 1000
+#define RULE_FLIPS 6
+#define WIDTH_SLACK 1000
+
+static int reaches_equilibrium(const unsigned char initial[], long int pots_len, const unsigned char rules[]);
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    long int pots_len = BASE_POTS * (long int)args.scale;
+    unsigned char *initial = (unsigned char *)malloc(sizeof(unsigned char) * pots_len);
+    if(initial == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(long int i = 0; i < pots_len; i++) {
+        initial[i] = (unsigned char)rng_chance(&rng, 50);
+    }
+
+    /*
+     * Part 2 only has an answer if the pots settle into a pattern whose sum
+     * grows by a positive constant every generation. Fully random rule sets
+     * almost never do, so each attempt starts from a rule set that moves
+     * every plant one or two pots to the right, and flips a few of its rules.
+     * An empty neighbourhood never grows a plant, or the row would be
+     * infinite.
+     */
+    unsigned char rules[RULES];
+    int attempts = 0;
+    do {
+        if(++attempts > MAX_ATTEMPTS) {
+            fprintf(stderr, "Unexpected error: no rule set reached equilibrium.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        int shift = (int)rng_range(&rng, 3, 4);
+        for(int i = 0; i < RULES; i++) {
+            rules[i] = (unsigned char)((i >> shift) & 1);
+        }
+
+        for(int i = 0; i < RULE_FLIPS; i++) {
+            int pattern = (int)rng_range(&rng, 1, RULES - 1);
+            rules[pattern] = (unsigned char)!rules[pattern];
+        }
+    } while(!reaches_equilibrium(initial, pots_len, rules));
+
+    fprintf(args.out, "initial state: ");
+    for(long int i = 0; i < pots_len; i++) {
+        fputc(initial[i] ? '#' : '.', args.out);
+    }
+
+    fprintf(args.out, "\n\n");
+
+    for(int i = 0; i < RULES; i++) {
+        for(int bit = 4; bit >= 0; bit--) {
+            fputc((i >> bit) & 1 ? '#' : '.', args.out);
+        }
+
+        fprintf(args.out, " => %c\n", rules[i] ? '#' : '.');
+    }
+
+    free(initial);
+    gen_close(&args);
+
+    return 0;
+}
+
+/*
+ * Mirrors the solver's test: the generation-to-generation change in the sum
+ * of plant positions must hold steady for EQ_TOLERANCE generations before
+ * GENERATIONS_LIMIT is reached. A row that dies out or drifts left settles
+ * too, but is rejected, and so is one that keeps spreading.
+ */
+static int reaches_equilibrium(const unsigned char initial[], long int pots_len, const unsigned char rules[])
+{
+    long int margin = 2 * GENERATIONS_LIMIT + 16;
+    long int row_len = pots_len + 2 * margin;
+    unsigned char *row = (unsigned char *)calloc(row_len, sizeof(unsigned char));
+    unsigned char *next = (unsigned char *)calloc(row_len, sizeof(unsigned char));
+    if(row == NULL || next == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(row + margin, initial, pots_len);
+
+    long int lower = margin, upper = margin + pots_len - 1;
+    long long int sum = 0;
+    for(long int i = lower; i <= upper; i++) {
+        sum += row[i] ? i - margin : 0;
+    }
+
+    long long int diff = 0;
+    int count = 0;
+    int generations = 0;
+    int settled = 0;
+    while(generations < GENERATIONS_LIMIT) {
+        long int next_lower = upper, next_upper = lower;
+        long long int next_sum = 0;
+
+        for(long int i = lower - 2; i <= upper + 2; i++) {
+            int pattern = row[i - 2] << 4 | row[i - 1] << 3 | row[i] << 2 | row[i + 1] << 1 | row[i + 2];
+            next[i] = rules[pattern];
+
+            if(next[i]) {
+                next_sum += i - margin;
+                next_lower = i < next_lower ? i : next_lower;
+                next_upper = i > next_upper ? i : next_upper;
+            }
+        }
+
+        memset(row + lower - 2, 0, upper - lower + 5);
+
+        unsigned char *tmp = row;
+        row = next;
+        next = tmp;
+
+        if(next_sum - sum == diff) {
+            count++;
+        } else {
+            count = 0;
+            diff = next_sum - sum;
+        }
+
+        sum = next_sum;
+        generations++;
+
+        if(count >= EQ_TOLERANCE) {
+            settled = 1;
+            break;
+        }
+
+        if(next_lower > next_upper) {
+            next_lower = next_upper = margin;
+        }
+
+        if(next_upper - next_lower > pots_len + WIDTH_SLACK) {
+            break;
+        }
+
+        lower = next_lower;
+        upper = next_upper;
+    }
+
+    free(row);
+    free(next);
+
+    return settled && diff > 0;
+}
@@ -0,0 +1,266 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "input.h"
+#include "day12.h"
+
+#define RULES 32
+#define GENERATIONS 20
+#define SEARCH_LIMIT 10000
+#define EXTENDED_GENERATIONS 50000000000LL
+
+/*
+ * A row of pots as a string of '.' and '#' from its first plant to its last
+ * one, with first the number of the first pot. An empty row has no plants.
+ */
+struct row_t {
+    char *pots;
+    size_t len;
+    long long int first;
+};
+
+static int parse_pots(struct view_t pots, unsigned int *pattern);
+static struct row_t advance(struct row_t row, const char rules[]);
+static int pot_at(struct row_t row, long long int pot);
+static long long int row_sum(struct row_t row);
+static long long int row_count(struct row_t row);
+static int same_pattern(struct row_t a, struct row_t b);
+
+/*
+ * The plain version of the puzzle, kept to check the solver's linked rows and
+ * cycle finder against (see verify/): rows are strings, each generation is
+ * worked out pot by pot from a table of all 32 rules, and for part 2 every
+ * row is kept until one repeats an earlier one's pattern.
+ *
+ * Inputs the puzzle rules out are refused: a rule listed twice, and a rule
+ * that grows a plant out of five empty pots, which would fill the whole row.
+ */
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct view_t line;
+    if(!input_next_line(&reader, &line) || view_expect(&line, "initial state: ")) {
+        fprintf(stderr, "Unexpected input: invalid initial state\n");
+        exit(1);
+    }
+
+    struct row_t initial = {.pots = NULL, .len = 0, .first = 0};
+    for(size_t i = 0; i < line.len; i++) {
+        if(line.ptr[i] != '.' && line.ptr[i] != '#') {
+            fprintf(stderr, "Unexpected input: invalid initial state\n");
+            exit(1);
+        }
+    }
+
+    const char *first = memchr(line.ptr, '#', line.len);
+    if(first != NULL) {
+        const char *last = line.ptr + line.len - 1;
+        while(*last != '#') {
+            last--;
+        }
+
+        initial.first = first - line.ptr;
+        initial.len = (size_t)(last - first + 1);
+        initial.pots = (char *)malloc(sizeof(char) * initial.len);
+        if(initial.pots == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+        memcpy(initial.pots, first, initial.len);
+    }
+
+    if(!input_next_line(&reader, &line) || line.len != 0) {
+        fprintf(stderr, "Unexpected input: end of input or error occurred\n");
+        exit(1);
+    }
+
+    char rules[RULES] = {0};
+    char seen[RULES] = {0};
+    while(input_next_line(&reader, &line)) {
+        unsigned int pattern;
+        struct view_t pots = {.ptr = line.ptr, .len = 5};
+        if(line.len != 10 || parse_pots(pots, &pattern) || memcmp(line.ptr + 5, " => ", 4) != 0 ||
+           (line.ptr[9] != '.' && line.ptr[9] != '#') || seen[pattern]) {
+            fprintf(stderr, "Unexpected input: invalid claim\n");
+            exit(1);
+        }
+
+        seen[pattern] = 1;
+        rules[pattern] = line.ptr[9] == '#';
+    }
+
+    input_release(&reader);
+
+    if(rules[0]) {
+        fprintf(stderr, "Unexpected input: plants grow out of empty pots\n");
+        exit(1);
+    }
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    struct row_t row = {.pots = NULL, .len = initial.len, .first = initial.first};
+    row.pots = (char *)malloc(sizeof(char) * (row.len > 0 ? row.len : 1));
+    if(row.pots == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    if(row.len > 0) {
+        memcpy(row.pots, initial.pots, row.len);
+    }
+
+    for(int generation = 0; generation < GENERATIONS; generation++) {
+        struct row_t next = advance(row, rules);
+        free(row.pots);
+        row = next;
+    }
+
+    answer_printf(&answer->part1, "%lld", row_sum(row));
+    answer_lap(answer, AOC_PHASE_PART1);
+    free(row.pots);
+
+    /*
+     * history[g] is the row after g generations. Once row j has the pattern
+     * of row i, the rows from i on repeat every j - i generations, moved along
+     * by the same distance each time.
+     */
+    struct row_t *history = (struct row_t *)malloc(sizeof(struct row_t) * (SEARCH_LIMIT + 1));
+    if(history == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    history[0] = initial;
+    long long int history_len = 1;
+    long long int sum = 0;
+    int found = 0;
+    while(!found) {
+        if(history_len > SEARCH_LIMIT) {
+            fprintf(stderr, "Limit reached: the plants did not settle into a pattern after %d generations.\n", SEARCH_LIMIT);
+            exit(1);
+        }
+
+        long long int j = history_len++;
+        history[j] = advance(history[j - 1], rules);
+
+        for(long long int i = 0; i < j && !found; i++) {
+            if(!same_pattern(history[i], history[j])) {
+                continue;
+            }
+
+            long long int len = j - i;
+            long long int shift = history[j].first - history[i].first;
+            long long int laps = (EXTENDED_GENERATIONS - i) / len;
+            struct row_t last = history[i + (EXTENDED_GENERATIONS - i) % len];
+
+            sum = row_sum(last) + row_count(last) * shift * laps;
+            found = 1;
+        }
+    }
+
+    answer_printf(&answer->part2, "%lld", sum);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    for(long long int g = 0; g < history_len; g++) {
+        free(history[g].pots);
+    }
+    free(history);
+
+    return 0;
+}
+
+/*
+ * The five pots as a rule index, leftmost pot in the highest bit.
+ */
+static int parse_pots(struct view_t pots, unsigned int *pattern)
+{
+    *pattern = 0;
+
+    for(size_t i = 0; i < pots.len; i++) {
+        if(pots.ptr[i] != '.' && pots.ptr[i] != '#') {
+            return 1;
+        }
+
+        *pattern = (*pattern << 1) | (pots.ptr[i] == '#');
+    }
+
+    return 0;
+}
+
+/*
+ * With no rule growing plants out of empty pots, only pots within two of a
+ * plant can hold one in the next generation.
+ */
+static struct row_t advance(struct row_t row, const char rules[])
+{
+    struct row_t next = {.pots = NULL, .len = 0, .first = 0};
+
+    size_t span = row.len + 4;
+    char *pots = (char *)malloc(sizeof(char) * (span > 0 ? span : 1));
+    if(pots == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t first = span;
+    size_t last = 0;
+    for(size_t i = 0; i < span && row.len > 0; i++) {
+        long long int pot = row.first - 2 + (long long int)i;
+
+        unsigned int pattern = 0;
+        for(long long int k = pot - 2; k <= pot + 2; k++) {
+            pattern = (pattern << 1) | (unsigned int)pot_at(row, k);
+        }
+
+        pots[i] = rules[pattern] ? '#' : '.';
+        if(rules[pattern]) {
+            first = first < i ? first : i;
+            last = i;
+        }
+    }
+
+    if(first < span) {
+        next.first = row.first - 2 + (long long int)first;
+        next.len = last - first + 1;
+        memmove(pots, pots + first, next.len);
+    }
+
+    next.pots = pots;
+
+    return next;
+}
+
+static int pot_at(struct row_t row, long long int pot)
+{
+    return pot >= row.first && pot < row.first + (long long int)row.len && row.pots[pot - row.first] == '#';
+}
+
+static long long int row_sum(struct row_t row)
+{
+    long long int sum = 0;
+    for(size_t i = 0; i < row.len; i++) {
+        if(row.pots[i] == '#') {
+            sum += row.first + (long long int)i;
+        }
+    }
+
+    return sum;
+}
+
+static long long int row_count(struct row_t row)
+{
+    long long int count = 0;
+    for(size_t i = 0; i < row.len; i++) {
+        count += row.pots[i] == '#';
+    }
+
+    return count;
+}
+
+static int same_pattern(struct row_t a, struct row_t b)
+{
+    return a.len == b.len && memcmp(a.pots, b.pots, a.len) == 0;
+}
+
+const struct aoc_solver_t day12_reference = {.name = "day12", .solve = solve};
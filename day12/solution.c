@@ -0,0 +1,517 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "cycle.h"
+#include "input.h"
+#include "trace.h"
+#include "day12.h"
+
+#define BUFF_LEN 128
+#define GENERATIONS 20
+#define SEARCH_LIMIT 10000
+#define EXTENDED_GENERATIONS 50000000000
+
+struct list_t {
+    struct list_node_t *head;
+    struct list_node_t *tail;
+};
+
+struct list_node_t {
+    struct list_node_t *next;
+    struct list_node_t *prev;
+    long int id;
+};
+
+/*
+ * Each generation is built in one of two pools from the generation before it,
+ * which lives in the other, so dropping a generation is resetting its pool.
+ */
+struct generation_pools_t {
+    struct pool_t pools[2];
+    int current;
+};
+
+/*
+ * What advancing a generation needs besides the state itself, for the cycle
+ * finder's callbacks. The one copy of a state the cycle finder keeps at a
+ * time lives in saved.
+ */
+struct generations_t {
+    struct claim_t *claims;
+    int claims_len;
+    struct generation_pools_t *pools;
+    struct pool_t saved;
+};
+
+struct claim_t {
+    unsigned int next_gen_plant: 1;
+    unsigned int ll: 1;
+    unsigned int l: 1;
+    unsigned int c: 1;
+    unsigned int r: 1;
+    unsigned int rr: 1;
+};
+
+static struct list_t build_initial_state_from_input(struct view_t line, struct pool_t *nodes);
+static struct pool_t *next_generation_pool(struct generation_pools_t *pools);
+static void release_state_resources(struct generation_pools_t *pools);
+static struct claim_t build_claim_from_input(struct view_t line);
+static int is_valid_claim(struct view_t line);
+static struct list_t advance_n_generations(struct list_t initial_state, struct claim_t claims[], int claims_len, int generations, struct generation_pools_t *pools);
+static struct list_t advance_generation(struct list_t initial_state_list, struct claim_t claims[], int claims_len, struct pool_t *nodes);
+static struct list_t duplicate_list(struct list_t list, struct pool_t *nodes);
+static int claim_matches_list(struct claim_t *claim, struct list_node_t *closest_node, long int pos);
+static long long int sum_state_values(struct list_t list);
+static long long int count_state_values(struct list_t list);
+static long long int state_sum_after_n_generations(struct list_t initial_state_list, struct claim_t claims[], int claims_len, long int generations, struct generation_pools_t *pools);
+static void step_generation(void *ctx, void *state);
+static uint64_t hash_pattern(void *ctx, const void *state);
+static int same_pattern(void *ctx, const void *a, const void *b);
+static void *clone_state(void *ctx, const void *state);
+static void release_clone(void *ctx, void *state);
+static int64_t state_offset(void *ctx, const void *state);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct view_t line;
+    if(!input_next_line(&reader, &line)) {
+        fprintf(stderr, "Unexpected input: end of input or error occurred\n");
+        exit(1);
+    }
+
+    struct pool_t nodes;
+    POOL_INIT(&nodes, struct list_node_t, 1024);
+
+    struct list_t initial_state_list = build_initial_state_from_input(line, &nodes);
+
+    struct generation_pools_t generations = {.current = 0};
+    POOL_INIT(&generations.pools[0], struct list_node_t, 1024);
+    POOL_INIT(&generations.pools[1], struct list_node_t, 1024);
+
+    if(!input_next_line(&reader, &line) || line.len != 0) {
+        fprintf(stderr, "Unexpected input: end of input or error occurred\n");
+        exit(1);
+    }
+
+    int claims_len = BUFF_LEN;
+    int claims_index = 0;
+    struct claim_t *claims = (struct claim_t *)malloc(sizeof(struct claim_t) * claims_len);
+    if(claims == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    while(input_next_line(&reader, &line)) {
+        if(claims_index >= claims_len) {
+            claims_len = claims_len * 2;
+            claims = (struct claim_t *)realloc(claims, sizeof(struct claim_t) * claims_len);
+            if(claims == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        claims[claims_index] = build_claim_from_input(line);
+        claims_index++;
+    }
+
+    input_release(&reader);
+
+    claims_len = claims_index;
+    claims = (struct claim_t *)realloc(claims, sizeof(struct claim_t) * claims_len);
+    if(claims == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    TRACE_BEGIN(advance_n_generations);
+    struct list_t advanced_state_list = advance_n_generations(initial_state_list, claims, claims_len, GENERATIONS, &generations);
+    TRACE_END(advance_n_generations);
+    long long int sum = sum_state_values(advanced_state_list);
+    answer_printf(&answer->part1, "%lld", sum);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    TRACE_BEGIN(state_sum_after_n_generations);
+    sum = state_sum_after_n_generations(initial_state_list, claims, claims_len, EXTENDED_GENERATIONS, &generations);
+    TRACE_END(state_sum_after_n_generations);
+    answer_printf(&answer->part2, "%lld", sum);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    free(claims);
+    pool_release(&nodes);
+    pool_release(&generations.pools[0]);
+    pool_release(&generations.pools[1]);
+
+    return 0;
+}
+
+static struct list_t build_initial_state_from_input(struct view_t line, struct pool_t *nodes)
+{
+    struct list_t list = {.head = NULL, .tail = NULL};
+
+    if(view_skip_past(&line, ':') || view_expect(&line, " ")) {
+        fprintf(stderr, "Unexpected input: invalid initial state\n");
+        exit(1);
+    }
+
+    for(size_t i = 0; i < line.len; i++) {
+        if(line.ptr[i] != '.' && line.ptr[i] != '#') {
+            fprintf(stderr, "Unexpected input: invalid initial state\n");
+            exit(1);
+        }
+
+        if(line.ptr[i] == '#') {
+            struct list_node_t *new_node = POOL_NEW(nodes, struct list_node_t);
+
+            if(list.tail == NULL) {
+                list.head = new_node;
+                list.tail = new_node;
+
+                new_node->next = NULL;
+                new_node->prev = NULL;
+            } else {
+                list.tail->next = new_node;
+                new_node->prev = list.tail;
+                new_node->next = NULL;
+                list.tail = new_node;
+            }
+
+            new_node->id = (long int)i;
+        }
+    }
+
+    return list;
+}
+
+/*
+ * The pool for the next generation, emptied of the one before the current
+ * generation.
+ */
+static struct pool_t *next_generation_pool(struct generation_pools_t *pools)
+{
+    pools->current ^= 1;
+    pool_reset(&pools->pools[pools->current]);
+
+    return &pools->pools[pools->current];
+}
+
+/*
+ * Drops the current generation.
+ */
+static void release_state_resources(struct generation_pools_t *pools)
+{
+    pool_reset(&pools->pools[pools->current]);
+}
+
+static struct claim_t build_claim_from_input(struct view_t line)
+{
+    struct claim_t claim = {.ll = 0, .l = 0, .c = 0, .r = 0, .rr = 0, .next_gen_plant = 0};
+
+    if(!is_valid_claim(line)) {
+        fprintf(stderr, "Unexpected input: invalid claim\n");
+        exit(1);
+    }
+
+    claim.ll = line.ptr[0] == '.' ? 0 : 1;
+    claim.l = line.ptr[1] == '.' ? 0 : 1;
+    claim.c = line.ptr[2] == '.' ? 0 : 1;
+    claim.r = line.ptr[3] == '.' ? 0 : 1;
+    claim.rr = line.ptr[4] == '.' ? 0 : 1;
+    claim.next_gen_plant = line.ptr[9] == '.' ? 0 : 1;
+
+    return claim;
+}
+
+static int is_valid_claim(struct view_t line)
+{
+    if(line.len != 10) {
+        return 0;
+    }
+
+    for(int i = 0; i < 10; i++) {
+        if((i < 5 || i > 8) && (line.ptr[i] != '.' && line.ptr[i] != '#')) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static struct list_t advance_n_generations(struct list_t initial_state_list, struct claim_t claims[], int claims_len, int generations, struct generation_pools_t *pools)
+{
+    struct list_t advanced_generation_list = duplicate_list(initial_state_list, next_generation_pool(pools));
+
+    for(int generation = 0; generation < generations; generation++) {
+        advanced_generation_list = advance_generation(advanced_generation_list, claims, claims_len, next_generation_pool(pools));
+    }
+
+    return advanced_generation_list;
+}
+
+static struct list_t advance_generation(struct list_t initial_state_list, struct claim_t claims[], int claims_len, struct pool_t *nodes)
+{
+    if(initial_state_list.head == NULL) {
+        return initial_state_list;
+    }
+
+    struct list_t new_list = {.head = NULL, .tail = NULL};
+
+    struct list_node_t *closest_relative_node = initial_state_list.head;
+    for(long int pos = initial_state_list.head->id - 3; pos <= initial_state_list.tail->id + 3; pos++) {
+        while(closest_relative_node->next != NULL && closest_relative_node->id < pos) {
+            closest_relative_node = closest_relative_node->next;
+        }
+
+        for(struct claim_t *claim = claims; claim < claims + claims_len; claim++) {
+            if(!claim_matches_list(claim, closest_relative_node, pos)) {
+                continue;
+            }
+
+            if(claim->next_gen_plant) {
+                struct list_node_t *new_node = POOL_NEW(nodes, struct list_node_t);
+
+                if(new_list.head == NULL) {
+                    new_node->id = pos;
+                    new_node->next = NULL;
+                    new_node->prev = NULL;
+
+                    new_list.head = new_node;
+                    new_list.tail = new_node;
+                } else {
+                    new_node->id = pos;
+                    new_node->prev = new_list.tail;
+                    new_node->next = NULL;
+
+                    new_list.tail->next = new_node;
+                    new_list.tail = new_node;
+                }
+            }
+        }
+    }
+
+    return new_list;
+}
+
+static struct list_t duplicate_list(struct list_t list, struct pool_t *nodes)
+{
+    struct list_t new_list = {.head = NULL, .tail = NULL};
+
+    struct list_node_t *current = list.head;
+    while(current != NULL) {
+        struct list_node_t *new_node = POOL_NEW(nodes, struct list_node_t);
+
+        new_node->next = NULL;
+        new_node->prev = NULL;
+        new_node->id = current->id;
+
+        if(new_list.head == NULL) {
+            new_list.head = new_node;
+            new_list.tail = new_node;
+        } else {
+            new_node->prev = new_list.tail;
+            new_list.tail->next = new_node;
+            new_list.tail = new_node;
+        }
+
+        current = current->next;
+    }
+
+    return new_list;
+}
+
+static int claim_matches_list(struct claim_t *claim, struct list_node_t *closest_node, long int pos)
+{
+    struct list_node_t *c = NULL;
+    struct list_node_t *l = NULL;
+    struct list_node_t *ll = NULL;
+    struct list_node_t *r = NULL;
+    struct list_node_t *rr = NULL;
+
+    struct list_node_t *current = closest_node;
+    while(current->next != NULL && current->id <= pos + 3) {
+        current = current->next;
+    }
+
+    while(current != NULL && current->id >= pos - 3) {
+        if(current->id == pos + 2)
+            rr = current;
+        else if(current->id == pos + 1)
+            r = current;
+        else if(current->id == pos)
+            c = current;
+        else if(current->id == pos - 1)
+            l = current;
+        else if(current->id == pos - 2)
+            ll = current;
+
+        current = current->prev;
+    }
+
+    if((rr == NULL) == claim->rr)
+        return 0;
+
+    if((r == NULL) == claim->r)
+        return 0;
+
+    if((c == NULL) == claim->c)
+        return 0;
+
+    if((l == NULL) == claim->l)
+        return 0;
+
+    if((ll == NULL) == claim->ll)
+        return 0;
+
+    return 1;
+}
+
+static long long int sum_state_values(struct list_t list)
+{
+    long long int sum = 0;
+    struct list_node_t *current = list.head;
+    while(current != NULL) {
+        sum += current->id;
+        current = current->next;
+    }
+
+    return sum;
+}
+
+static long long int count_state_values(struct list_t list)
+{
+    long long int count = 0;
+    for(struct list_node_t *current = list.head; current != NULL; current = current->next) {
+        count++;
+    }
+
+    return count;
+}
+
+/*
+ * The plants settle into a pattern that repeats, usually every generation,
+ * while drifting along the row. Once the cycle finder has seen the pattern
+ * repeat, the generations left are skipped a whole lap at a time, and every
+ * plant is moved by the distance the pattern would have drifted meanwhile.
+ */
+static long long int state_sum_after_n_generations(struct list_t initial_state_list, struct claim_t claims[], int claims_len, long int generations, struct generation_pools_t *pools)
+{
+    struct list_t state_list = duplicate_list(initial_state_list, next_generation_pool(pools));
+
+    struct generations_t ctx = {.claims = claims, .claims_len = claims_len, .pools = pools};
+    POOL_INIT(&ctx.saved, struct list_node_t, 1024);
+
+    struct cycle_sim_t sim = {
+        .ctx = &ctx,
+        .step = step_generation,
+        .hash = hash_pattern,
+        .equal = same_pattern,
+        .clone = clone_state,
+        .release = release_clone,
+        .offset = state_offset,
+        .search_limit = SEARCH_LIMIT
+    };
+
+    struct cycle_t cycle;
+    if(cycle_advance(&sim, &state_list, CYCLE_HASHED, (uint64_t)generations, &cycle)) {
+        fprintf(stderr, "Limit reached: the plants did not settle into a pattern after %d generations.\n", SEARCH_LIMIT);
+        exit(1);
+    }
+
+    TRACE_COUNT(cycle_start, cycle.start);
+    TRACE_COUNT(cycle_len, cycle.len);
+
+    long long int sum = sum_state_values(state_list) +
+                        count_state_values(state_list) * cycle.shift * (long long int)cycle.laps;
+
+    release_state_resources(pools);
+    pool_release(&ctx.saved);
+
+    return sum;
+}
+
+static void step_generation(void *ctx, void *state)
+{
+    struct generations_t *gens = (struct generations_t *)ctx;
+    struct list_t *state_list = (struct list_t *)state;
+
+    *state_list = advance_generation(*state_list, gens->claims, gens->claims_len, next_generation_pool(gens->pools));
+}
+
+/*
+ * Two rows hold the same pattern when their plants are at the same
+ * distances from the first one, so those are what is hashed.
+ */
+static uint64_t hash_pattern(void *ctx, const void *state)
+{
+    (void)ctx;
+
+    const struct list_t *state_list = (const struct list_t *)state;
+
+    uint64_t hash = CYCLE_HASH_SEED;
+    for(const struct list_node_t *current = state_list->head; current != NULL; current = current->next) {
+        hash = cycle_hash_word(hash, (uint64_t)(current->id - state_list->head->id));
+    }
+
+    return hash;
+}
+
+static int same_pattern(void *ctx, const void *a, const void *b)
+{
+    (void)ctx;
+
+    const struct list_t *list_a = (const struct list_t *)a;
+    const struct list_t *list_b = (const struct list_t *)b;
+
+    const struct list_node_t *node_a = list_a->head;
+    const struct list_node_t *node_b = list_b->head;
+    while(node_a != NULL && node_b != NULL) {
+        if(node_a->id - list_a->head->id != node_b->id - list_b->head->id) {
+            return 0;
+        }
+
+        node_a = node_a->next;
+        node_b = node_b->next;
+    }
+
+    return node_a == NULL && node_b == NULL;
+}
+
+static void *clone_state(void *ctx, const void *state)
+{
+    struct generations_t *gens = (struct generations_t *)ctx;
+
+    struct list_t *clone = (struct list_t *)malloc(sizeof(struct list_t));
+    if(clone == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    *clone = duplicate_list(*(const struct list_t *)state, &gens->saved);
+
+    return clone;
+}
+
+static void release_clone(void *ctx, void *state)
+{
+    struct generations_t *gens = (struct generations_t *)ctx;
+
+    pool_reset(&gens->saved);
+    free(state);
+}
+
+static int64_t state_offset(void *ctx, const void *state)
+{
+    (void)ctx;
+
+    const struct list_t *state_list = (const struct list_t *)state;
+
+    return state_list->head != NULL ? (int64_t)state_list->head->id : 0;
+}
+
+const struct aoc_solver_t day12_solver = {.name = "day12", .solve = solve, .version = 1};
@@ -0,0 +1,14 @@
+#ifndef AOC_DAY13_H
+#define AOC_DAY13_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day13_solver;
+
+/*
+ * A plain, slow solver for the same puzzle, which aoc_verify checks
+ * day13_solver against (see verify/verify.c).
+ */
+extern const struct aoc_solver_t day13_reference;
+
+#endif //AOC_DAY13_H
@@ -0,0 +1,302 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gen.h"
+
+#define BASE_AREA (150 * 150)
+#define WIDTH 250
+#define MAX_ROWS 65000
+#define MIN_UNIT 12
+#define MAX_UNIT 30
+#define GAP 2
+#define MAX_TICKS 4000
+#define MAX_ATTEMPTS 256
+
+#define DIR_UP 0
+#define DIR_RIGHT 1
+#define DIR_DOWN 2
+#define DIR_LEFT 3
+
+struct cart_t {
+    int x;
+    int y;
+    int dir;
+    int turn;
+    int crashed;
+};
+
+/*
+ * A unit is a self-contained piece of track: either a single loop, or a
+ * wide loop crossed by a tall one at four intersections. Units never touch,
+ * so the carts on one unit can only ever collide with each other.
+ */
+struct unit_t {
+    long int x;
+    long int y;
+    int width;
+    int height;
+    char *cells;
+};
+
+static void build_unit(struct rng_t *rng, struct unit_t *unit);
+static void draw_loop(struct unit_t *unit, int x0, int y0, int x1, int y1);
+static void place_carts(struct rng_t *rng, const struct unit_t *unit, struct cart_t carts[], int carts_len);
+static int carts_left_after_crashes(const struct unit_t *unit, const struct cart_t carts[], int carts_len);
+static int compare_carts(const void *a, const void *b);
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    /*
+     * The solver stores coordinates as unsigned shorts and reads lines into
+     * a fixed buffer, so the map grows downwards and stops short of 65536
+     * rows.
+     */
+    unsigned long int scale = gen_clamp_scale("day13", args.scale, (unsigned long int)MAX_ROWS * WIDTH / BASE_AREA);
+    long int rows_len = (long int)(BASE_AREA * scale / WIDTH);
+    if(rows_len < MAX_UNIT + GAP) {
+        rows_len = MAX_UNIT + GAP;
+    }
+
+    char *map = (char *)malloc(sizeof(char) * rows_len * WIDTH);
+    if(map == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memset(map, ' ', rows_len * WIDTH);
+
+    /*
+     * Units are packed left to right into strips. One of them is picked to
+     * carry the odd cart that survives every crash.
+     */
+    size_t units_len = 0;
+    size_t units_index = 0;
+    struct unit_t *units = NULL;
+
+    long int strip_y = 0;
+    while(strip_y + MAX_UNIT <= rows_len) {
+        int strip_x = 0;
+        int strip_height = 0;
+
+        while(1) {
+            if(units_index >= units_len) {
+                units_len += units_len ? units_len : 64;
+                units = (struct unit_t *)realloc(units, sizeof(struct unit_t) * units_len);
+                if(units == NULL) {
+                    perror("Fatal error: Cannot allocate memory.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+
+            struct unit_t *unit = units + units_index;
+            build_unit(&rng, unit);
+
+            if(strip_x + unit->width > WIDTH) {
+                free(unit->cells);
+                break;
+            }
+
+            unit->x = strip_x;
+            unit->y = strip_y;
+            units_index++;
+
+            strip_x += unit->width + GAP;
+            if(unit->height > strip_height) {
+                strip_height = unit->height;
+            }
+        }
+
+        strip_y += strip_height + GAP;
+    }
+
+    size_t odd_unit = (size_t)rng_range(&rng, 0, (long int)units_index - 1);
+    for(size_t i = 0; i < units_index; i++) {
+        struct unit_t *unit = units + i;
+        int carts_len = i == odd_unit ? 3 : 2;
+        struct cart_t carts[3];
+
+        int attempts = 0;
+        do {
+            if(++attempts > MAX_ATTEMPTS) {
+                fprintf(stderr, "Unexpected error: cannot place carts that crash.\n");
+                exit(EXIT_FAILURE);
+            }
+
+            place_carts(&rng, unit, carts, carts_len);
+        } while(carts_left_after_crashes(unit, carts, carts_len) != carts_len - 2);
+
+        for(int y = 0; y < unit->height; y++) {
+            memcpy(map + (unit->y + y) * WIDTH + unit->x, unit->cells + y * unit->width, unit->width);
+        }
+
+        for(int j = 0; j < carts_len; j++) {
+            map[(unit->y + carts[j].y) * WIDTH + unit->x + carts[j].x] = "^>v<"[carts[j].dir];
+        }
+
+        free(unit->cells);
+    }
+
+    free(units);
+
+    for(long int y = 0; y < rows_len; y++) {
+        int len = WIDTH;
+        while(len > 0 && map[y * WIDTH + len - 1] == ' ') {
+            len--;
+        }
+
+        fprintf(args.out, "%.*s\n", len, map + y * WIDTH);
+    }
+
+    free(map);
+    gen_close(&args);
+
+    return 0;
+}
+
+static void build_unit(struct rng_t *rng, struct unit_t *unit)
+{
+    unit->width = (int)rng_range(rng, MIN_UNIT, MAX_UNIT);
+    unit->height = (int)rng_range(rng, MIN_UNIT, MAX_UNIT);
+    unit->cells = (char *)malloc(sizeof(char) * unit->width * unit->height);
+    if(unit->cells == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memset(unit->cells, ' ', unit->width * unit->height);
+
+    if(rng_chance(rng, 20)) {
+        draw_loop(unit, 0, 0, unit->width - 1, unit->height - 1);
+        return;
+    }
+
+    int ay0 = (int)rng_range(rng, 2, unit->height - 5);
+    int ay1 = (int)rng_range(rng, ay0 + 2, unit->height - 3);
+    int bx0 = (int)rng_range(rng, 2, unit->width - 5);
+    int bx1 = (int)rng_range(rng, bx0 + 2, unit->width - 3);
+
+    draw_loop(unit, 0, ay0, unit->width - 1, ay1);
+    draw_loop(unit, bx0, 0, bx1, unit->height - 1);
+}
+
+static void draw_loop(struct unit_t *unit, int x0, int y0, int x1, int y1)
+{
+    for(int x = x0 + 1; x < x1; x++) {
+        for(int y = y0; y <= y1; y += y1 - y0) {
+            char *cell = unit->cells + y * unit->width + x;
+            *cell = *cell == '|' ? '+' : '-';
+        }
+    }
+
+    for(int y = y0 + 1; y < y1; y++) {
+        for(int x = x0; x <= x1; x += x1 - x0) {
+            char *cell = unit->cells + y * unit->width + x;
+            *cell = *cell == '-' ? '+' : '|';
+        }
+    }
+
+    unit->cells[y0 * unit->width + x0] = '/';
+    unit->cells[y0 * unit->width + x1] = '\\';
+    unit->cells[y1 * unit->width + x0] = '\\';
+    unit->cells[y1 * unit->width + x1] = '/';
+}
+
+/*
+ * Places carts on random straight pieces of track, facing along it.
+ */
+static void place_carts(struct rng_t *rng, const struct unit_t *unit, struct cart_t carts[], int carts_len)
+{
+    for(int i = 0; i < carts_len; i++) {
+        int free_cell;
+        do {
+            carts[i].x = (int)rng_range(rng, 0, unit->width - 1);
+            carts[i].y = (int)rng_range(rng, 0, unit->height - 1);
+
+            char cell = unit->cells[carts[i].y * unit->width + carts[i].x];
+            free_cell = cell == '-' || cell == '|';
+            for(int j = 0; j < i; j++) {
+                if(carts[j].x == carts[i].x && carts[j].y == carts[i].y) {
+                    free_cell = 0;
+                }
+            }
+
+            if(cell == '-') {
+                carts[i].dir = rng_chance(rng, 50) ? DIR_LEFT : DIR_RIGHT;
+            } else {
+                carts[i].dir = rng_chance(rng, 50) ? DIR_UP : DIR_DOWN;
+            }
+        } while(!free_cell);
+
+        carts[i].turn = 0;
+        carts[i].crashed = 0;
+    }
+}
+
+/*
+ * Runs the carts of a single unit the way the solver does, and returns how
+ * many are left once no more crashes happen within MAX_TICKS.
+ */
+static int carts_left_after_crashes(const struct unit_t *unit, const struct cart_t carts[], int carts_len)
+{
+    struct cart_t sim[3];
+    memcpy(sim, carts, sizeof(struct cart_t) * carts_len);
+
+    const int dx[4] = {0, 1, 0, -1};
+    const int dy[4] = {-1, 0, 1, 0};
+
+    int left = carts_len;
+    for(int tick = 0; tick < MAX_TICKS && left > carts_len - 2; tick++) {
+        qsort(sim, carts_len, sizeof(struct cart_t), compare_carts);
+
+        for(int i = 0; i < carts_len; i++) {
+            if(sim[i].crashed) {
+                continue;
+            }
+
+            sim[i].x += dx[sim[i].dir];
+            sim[i].y += dy[sim[i].dir];
+
+            for(int j = 0; j < carts_len; j++) {
+                if(j != i && !sim[j].crashed && sim[j].x == sim[i].x && sim[j].y == sim[i].y) {
+                    sim[i].crashed = 1;
+                    sim[j].crashed = 1;
+                    left -= 2;
+                }
+            }
+
+            switch(unit->cells[sim[i].y * unit->width + sim[i].x]) {
+                case '/':
+                    sim[i].dir = (sim[i].dir == DIR_UP || sim[i].dir == DIR_DOWN) ? (sim[i].dir + 1) % 4 : (sim[i].dir + 3) % 4;
+                    break;
+                case '\\':
+                    sim[i].dir = (sim[i].dir == DIR_UP || sim[i].dir == DIR_DOWN) ? (sim[i].dir + 3) % 4 : (sim[i].dir + 1) % 4;
+                    break;
+                case '+':
+                    sim[i].dir = (sim[i].dir + 3 + sim[i].turn) % 4;
+                    sim[i].turn = (sim[i].turn + 1) % 3;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    return left;
+}
+
+static int compare_carts(const void *a, const void *b)
+{
+    const struct cart_t *cart_a = (const struct cart_t *)a;
+    const struct cart_t *cart_b = (const struct cart_t *)b;
+
+    if(cart_a->y != cart_b->y) {
+        return cart_a->y - cart_b->y;
+    }
+
+    return cart_a->x - cart_b->x;
+}
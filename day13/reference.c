@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "input.h"
+#include "day13.h"
+
+#define BUFF_LEN 64
+#define TICKS_LIMIT 100000
+
+enum dir_t {
+    DIR_UP,
+    DIR_RIGHT,
+    DIR_DOWN,
+    DIR_LEFT
+};
+
+enum turn_t {
+    TURN_LEFT,
+    TURN_STRAIGHT,
+    TURN_RIGHT,
+    TURNS
+};
+
+struct cart_t {
+    long int x;
+    long int y;
+    enum dir_t dir;
+    enum turn_t turn;
+    int crashed;
+};
+
+/*
+ * The map as read, one row per line, with every cart replaced by the track
+ * under it.
+ */
+struct map_t {
+    struct view_t *rows;
+    size_t rows_len;
+};
+
+static void refuse(const char *reason);
+static char track_at(const struct map_t *map, long int x, long int y);
+static void move_cart(const struct map_t *map, struct cart_t *cart);
+static int compare_carts(const void *a, const void *b);
+
+/*
+ * The plain version of the puzzle, kept to check the solver's tracks and
+ * intersections against (see verify/): carts move cell by cell over the map
+ * as drawn, in reading order each tick, and turn on whatever track they land
+ * on.
+ *
+ * Inputs the puzzle rules out are refused: a cart that runs off its track,
+ * carts that never crash, or crashes that leave no cart standing.
+ */
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    size_t rows_cap = BUFF_LEN;
+    struct map_t map = {.rows = NULL, .rows_len = 0};
+    map.rows = (struct view_t *)malloc(sizeof(struct view_t) * rows_cap);
+
+    size_t carts_cap = BUFF_LEN;
+    size_t carts_len = 0;
+    struct cart_t *carts = (struct cart_t *)malloc(sizeof(struct cart_t) * carts_cap);
+    if(map.rows == NULL || carts == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct view_t line;
+    while(input_next_line(&reader, &line)) {
+        if(map.rows_len >= rows_cap) {
+            rows_cap *= 2;
+            map.rows = (struct view_t *)realloc(map.rows, sizeof(struct view_t) * rows_cap);
+            if(map.rows == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        char *row = (char *)malloc(sizeof(char) * (line.len > 0 ? line.len : 1));
+        if(row == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        for(size_t x = 0; x < line.len; x++) {
+            const char *cart_dirs = strchr("^>v<", line.ptr[x]);
+            if(line.ptr[x] == 0 || (cart_dirs == NULL && strchr(" -|/\\+", line.ptr[x]) == NULL)) {
+                refuse("invalid input");
+            }
+
+            row[x] = line.ptr[x];
+            if(cart_dirs == NULL) {
+                continue;
+            }
+
+            if(carts_len >= carts_cap) {
+                carts_cap *= 2;
+                carts = (struct cart_t *)realloc(carts, sizeof(struct cart_t) * carts_cap);
+                if(carts == NULL) {
+                    perror("Fatal error: Cannot allocate memory.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+
+            enum dir_t dir = (enum dir_t)(cart_dirs - "^>v<");
+            carts[carts_len++] = (struct cart_t){.x = (long int)x, .y = (long int)map.rows_len, .dir = dir, .turn = TURN_LEFT, .crashed = 0};
+            row[x] = dir == DIR_UP || dir == DIR_DOWN ? '|' : '-';
+        }
+
+        map.rows[map.rows_len].ptr = row;
+        map.rows[map.rows_len].len = line.len;
+        map.rows_len++;
+    }
+
+    input_release(&reader);
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    struct cart_t first_crash = {.x = 0, .y = 0};
+    int crashed = 0;
+    size_t carts_left = carts_len;
+    for(long int tick = 0; carts_left > 1; tick++) {
+        if(tick >= TICKS_LIMIT) {
+            refuse("the carts never crash");
+        }
+
+        qsort(carts, carts_len, sizeof(struct cart_t), compare_carts);
+
+        for(size_t i = 0; i < carts_len; i++) {
+            if(carts[i].crashed) {
+                continue;
+            }
+
+            move_cart(&map, carts + i);
+
+            for(size_t j = 0; j < carts_len; j++) {
+                if(j == i || carts[j].crashed || carts[j].x != carts[i].x || carts[j].y != carts[i].y) {
+                    continue;
+                }
+
+                if(!crashed) {
+                    first_crash = carts[i];
+                    crashed = 1;
+                }
+
+                carts[i].crashed = 1;
+                carts[j].crashed = 1;
+                carts_left -= 2;
+                break;
+            }
+        }
+    }
+
+    if(!crashed || carts_left == 0) {
+        refuse("no single cart is left");
+    }
+
+    const struct cart_t *last_cart = carts;
+    while(last_cart->crashed) {
+        last_cart++;
+    }
+
+    answer_printf(&answer->part1, "%ld,%ld", first_crash.x, first_crash.y);
+    answer_printf(&answer->part2, "%ld,%ld", last_cart->x, last_cart->y);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    for(size_t y = 0; y < map.rows_len; y++) {
+        free((char *)map.rows[y].ptr);
+    }
+    free(map.rows);
+    free(carts);
+
+    return 0;
+}
+
+static void refuse(const char *reason)
+{
+    fprintf(stderr, "Unexpected input: %s.\n", reason);
+    exit(1);
+}
+
+static char track_at(const struct map_t *map, long int x, long int y)
+{
+    if(y < 0 || (size_t)y >= map->rows_len || x < 0 || (size_t)x >= map->rows[y].len) {
+        return ' ';
+    }
+
+    return map->rows[y].ptr[x];
+}
+
+/*
+ * Curves swap vertical and horizontal travel: '/' turns up into right and
+ * left into down, '\' turns up into left and right into down.
+ */
+static void move_cart(const struct map_t *map, struct cart_t *cart)
+{
+    static const long int dx[] = {[DIR_UP] = 0, [DIR_RIGHT] = 1, [DIR_DOWN] = 0, [DIR_LEFT] = -1};
+    static const long int dy[] = {[DIR_UP] = -1, [DIR_RIGHT] = 0, [DIR_DOWN] = 1, [DIR_LEFT] = 0};
+
+    cart->x += dx[cart->dir];
+    cart->y += dy[cart->dir];
+
+    int vertical = cart->dir == DIR_UP || cart->dir == DIR_DOWN;
+    switch(track_at(map, cart->x, cart->y)) {
+        case '|':
+            if(!vertical) {
+                refuse("a cart runs off its track");
+            }
+            break;
+        case '-':
+            if(vertical) {
+                refuse("a cart runs off its track");
+            }
+            break;
+        case '/':
+            cart->dir = (enum dir_t)(cart->dir ^ 1);
+            break;
+        case '\\':
+            cart->dir = (enum dir_t)(3 - cart->dir);
+            break;
+        case '+':
+            if(cart->turn == TURN_LEFT) {
+                cart->dir = (enum dir_t)((cart->dir + 3) % 4);
+            } else if(cart->turn == TURN_RIGHT) {
+                cart->dir = (enum dir_t)((cart->dir + 1) % 4);
+            }
+            cart->turn = (enum turn_t)((cart->turn + 1) % TURNS);
+            break;
+        default:
+            refuse("a cart runs off its track");
+    }
+}
+
+static int compare_carts(const void *a, const void *b)
+{
+    const struct cart_t *lhs = (const struct cart_t *)a;
+    const struct cart_t *rhs = (const struct cart_t *)b;
+
+    if(lhs->y != rhs->y) {
+        return (lhs->y > rhs->y) - (lhs->y < rhs->y);
+    }
+
+    return (lhs->x > rhs->x) - (lhs->x < rhs->x);
+}
+
+const struct aoc_solver_t day13_reference = {.name = "day13", .solve = solve};
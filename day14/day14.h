@@ -0,0 +1,8 @@
+#ifndef AOC_DAY14_H
+#define AOC_DAY14_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day14_solver;
+
+#endif //AOC_DAY14_H
@@ -0,0 +1,33 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gen.h"
+
+#define BASE_DIGITS 6
+#define MAX_DIGITS 18
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    /*
+     * The input doubles as the digit sequence searched for in part 2, which
+     * takes on the order of 10^digits recipes to find, so every tenfold step
+     * in scale adds a digit.
+     */
+    int digits = BASE_DIGITS;
+    for(unsigned long int scale = args.scale; scale >= 10 && digits < MAX_DIGITS; scale /= 10) {
+        digits++;
+    }
+
+    fprintf(args.out, "%ld", rng_range(&rng, 1, 9));
+    for(int i = 1; i < digits; i++) {
+        fprintf(args.out, "%ld", rng_range(&rng, 0, 9));
+    }
+
+    gen_close(&args);
+
+    return 0;
+}
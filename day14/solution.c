@@ -0,0 +1,226 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "hugemem.h"
+#include "input.h"
+#include "day14.h"
+
+#define BUFF_LEN 64
+#define LAST_RECIPES 10
+
+static int fill_last_n_recipe_scores(size_t recipes_count, uint8_t last_recipes[], size_t last_count);
+static size_t find_recipes_before_sequence(size_t sequence, size_t sequence_len);
+static uint8_t get_nibble(const uint8_t *numbers, size_t nibble_len, size_t nibble_index);
+static uint8_t set_nibble(uint8_t *numbers, size_t nibble_len, size_t nibble_index, uint8_t value);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct view_t token;
+    if(!input_next_token(&reader, &token)) {
+        fprintf(stderr, "Unexpected error: unable to read puzzle input.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t sequence_len = token.len;
+    long int sequence;
+    if(view_parse_long(&token, &sequence) || token.len != 0 || sequence < 0) {
+        fprintf(stderr, "Unexpected input: %.*s\n", (int)sequence_len, token.ptr);
+        exit(EXIT_FAILURE);
+    }
+
+    input_release(&reader);
+
+    size_t recipes = (size_t)sequence;
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    uint8_t *last_recipes = (uint8_t *)calloc(LAST_RECIPES, sizeof(uint8_t));
+    if(last_recipes == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if(fill_last_n_recipe_scores(recipes, last_recipes, LAST_RECIPES)) {
+        fprintf(stderr, "Unexpected error: unable to compute last %d scores.\n", LAST_RECIPES);
+        exit(EXIT_FAILURE);
+    }
+
+    char scores[LAST_RECIPES + 1];
+    for(int index = 0; index < LAST_RECIPES; index++) {
+        scores[index] = (char)('0' + last_recipes[index]);
+    }
+
+    scores[LAST_RECIPES] = 0;
+    answer_printf(&answer->part1, "%s", scores);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    size_t recipes_before_sequence = find_recipes_before_sequence(recipes, sequence_len);
+    answer_printf(&answer->part2, "%zu", recipes_before_sequence);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    free(last_recipes);
+
+    return 0;
+}
+
+static int fill_last_n_recipe_scores(size_t recipes_count, uint8_t last_recipes[], size_t last_count)
+{
+    size_t scores_len = (recipes_count + 10) * 2;
+    size_t recipes_index = 0;
+    uint8_t *scores = (uint8_t *)hugemem_calloc((recipes_count + 10) * sizeof(uint8_t));
+
+    size_t p1i = 0, p2i = 1;
+
+    set_nibble(scores, scores_len, recipes_index, 3);
+    recipes_index++;
+    set_nibble(scores, scores_len, recipes_index, 7);
+    recipes_index++;
+
+    while(recipes_index < (recipes_count + last_count)) {
+        uint8_t sum = get_nibble(scores, scores_len, p1i) + get_nibble(scores, scores_len, p2i);
+
+        if(sum < 10) {
+            set_nibble(scores, scores_len, recipes_index, sum);
+            recipes_index++;
+        } else {
+            uint8_t msd = sum / (uint8_t)10;
+            uint8_t lsd = sum % (uint8_t)10;
+
+            set_nibble(scores, scores_len, recipes_index, msd);
+            recipes_index++;
+
+            set_nibble(scores, scores_len, recipes_index, lsd);
+            recipes_index++;
+        }
+
+        p1i = (p1i + 1 + get_nibble(scores, scores_len, p1i)) % recipes_index;
+        p2i = (p2i + 1 + get_nibble(scores, scores_len, p2i)) % recipes_index;
+    }
+
+    for(size_t index = recipes_count; index < recipes_count + last_count; index++) {
+        last_recipes[index - recipes_count] = get_nibble(scores, scores_len, index);
+    }
+
+    hugemem_free(scores, (recipes_count + 10) * sizeof(uint8_t));
+
+    return 0;
+}
+
+static size_t find_recipes_before_sequence(size_t sequence, size_t sequence_len)
+{
+    uint8_t *digits = (uint8_t *)malloc(sequence_len * sizeof(uint8_t));
+    if(digits == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t sequence_tmp = sequence;
+    for(size_t index = sequence_len; index > 0; index--) {
+        digits[index - 1] = (uint8_t)(sequence_tmp % 10);
+        sequence_tmp /= 10;
+    }
+
+    size_t scores_len = BUFF_LEN;
+    size_t recipes_index = 0;
+    uint8_t *scores = (uint8_t *)hugemem_calloc(sizeof(uint8_t) * scores_len);
+
+    size_t p1i = 0, p2i = 1;
+
+    set_nibble(scores, scores_len * 2, recipes_index, 3);
+    recipes_index++;
+    set_nibble(scores, scores_len * 2, recipes_index, 7);
+    recipes_index++;
+
+    size_t match_index = 0;
+    while(match_index < sequence_len) {
+        uint8_t sum = get_nibble(scores, scores_len * 2, p1i) + get_nibble(scores, scores_len * 2, p2i);
+
+        if((recipes_index+1) >= (scores_len * 2)) {
+            scores = (uint8_t *)hugemem_realloc(scores, sizeof(uint8_t) * scores_len, sizeof(uint8_t) * scores_len * 2);
+            scores_len *= 2;
+        }
+
+        if(sum < 10) {
+            set_nibble(scores, scores_len * 2, recipes_index, sum);
+            recipes_index++;
+
+            if(sum == digits[match_index]) {
+                match_index++;
+            } else {
+                match_index = (sum == digits[0]) ? 1 : 0;
+            }
+        } else {
+            uint8_t msd = sum / (uint8_t)10;
+            uint8_t lsd = sum % (uint8_t)10;
+
+            set_nibble(scores, scores_len * 2, recipes_index, msd);
+            recipes_index++;
+
+            set_nibble(scores, scores_len * 2, recipes_index, lsd);
+            recipes_index++;
+
+            if(msd == digits[match_index]) {
+                match_index++;
+            } else {
+                match_index = (msd == digits[0]) ? 1 : 0;
+            }
+
+            if(match_index == sequence_len) {
+                break;
+            }
+
+            if(lsd == digits[match_index]) {
+                match_index++;
+            } else {
+                match_index = (lsd == digits[0]) ? 1 : 0;
+            }
+        }
+
+        p1i = (p1i + 1 + get_nibble(scores, scores_len * 2, p1i)) % recipes_index;
+        p2i = (p2i + 1 + get_nibble(scores, scores_len * 2, p2i)) % recipes_index;
+    }
+
+    hugemem_free(scores, sizeof(uint8_t) * scores_len);
+    free(digits);
+
+    return recipes_index - sequence_len;
+}
+
+static uint8_t get_nibble(const uint8_t *numbers, size_t nibble_len, size_t nibble_index)
+{
+    if(nibble_index >= nibble_len) {
+        return 0;
+    }
+
+    size_t index = nibble_index / 2;
+
+    return (nibble_index % 2 == 0) ? numbers[index] >> 4 : numbers[index] & (uint8_t)0x0f;
+}
+
+static uint8_t set_nibble(uint8_t *numbers, size_t nibble_len, size_t nibble_index, uint8_t value)
+{
+    if(nibble_index >= nibble_len) {
+        return 0;
+    }
+
+    size_t index = nibble_index / 2;
+
+    if(nibble_index % 2 == 0) {
+        value = (value << 4) & (uint8_t)0xf0;
+        numbers[index] = numbers[index] & (uint8_t)0x0f;
+    } else {
+        value = value & (uint8_t)0x0f;
+        numbers[index] = numbers[index] & (uint8_t)0xf0;
+    }
+
+    numbers[index] = numbers[index] | value;
+
+    return 1;
+}
+
+const struct aoc_solver_t day14_solver = {.name = "day14", .solve = solve};
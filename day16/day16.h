@@ -0,0 +1,8 @@
+#ifndef AOC_DAY16_H
+#define AOC_DAY16_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day16_solver;
+
+#endif //AOC_DAY16_H
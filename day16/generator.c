@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "gen.h"
+
+#define OPS_LEN 16
+#define REGS_LEN 4
+#define BASE_SAMPLES 780
+#define BASE_PROGRAM 1000
+#define MAX_ATTEMPTS 100000
+
+enum opname_t {
+    ADDR, ADDI, MULR, MULI, BANR, BANI, BORR, BORI,
+    SETR, SETI, GTIR, GTRI, GTRR, EQIR, EQRI, EQRR
+};
+
+static long long int execute(int name, long long int regs[], int a, int b);
+static int matching_ops(const long long int before[], const long long int after[], int a, int b, int c);
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    /*
+     * opcodes maps each opcode number to the operation it stands for. The
+     * solver deduces the mapping by repeatedly pinning down an opcode that
+     * has a single candidate left, so the operations are assigned a rank in
+     * that elimination and every sample may only also match operations of a
+     * lower rank than its own.
+     */
+    int opcodes[OPS_LEN];
+    int ranks[OPS_LEN];
+    int order[OPS_LEN];
+    for(int i = 0; i < OPS_LEN; i++) {
+        opcodes[i] = i;
+        order[i] = i;
+    }
+
+    rng_shuffle(&rng, opcodes, OPS_LEN, sizeof(int));
+    rng_shuffle(&rng, order, OPS_LEN, sizeof(int));
+    for(int i = 0; i < OPS_LEN; i++) {
+        ranks[order[i]] = i;
+    }
+
+    size_t samples_len = BASE_SAMPLES * args.scale;
+    int *sample_opcodes = (int *)malloc(sizeof(int) * samples_len);
+    if(sample_opcodes == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(size_t i = 0; i < samples_len; i++) {
+        sample_opcodes[i] = (int)(i % OPS_LEN);
+    }
+
+    rng_shuffle(&rng, sample_opcodes, samples_len, sizeof(int));
+
+    for(size_t i = 0; i < samples_len; i++) {
+        int opcode = sample_opcodes[i];
+        int name = opcodes[opcode];
+        int allowed = 1 << name;
+        for(int j = 0; j < OPS_LEN; j++) {
+            if(ranks[j] < ranks[name]) {
+                allowed |= 1 << j;
+            }
+        }
+
+        long long int before[REGS_LEN];
+        long long int after[REGS_LEN];
+        int a, b, c;
+
+        int attempts = 0;
+        do {
+            if(++attempts > MAX_ATTEMPTS) {
+                fprintf(stderr, "Unexpected error: cannot find an unambiguous sample.\n");
+                exit(EXIT_FAILURE);
+            }
+
+            for(int j = 0; j < REGS_LEN; j++) {
+                before[j] = rng_range(&rng, 0, 3);
+            }
+
+            a = (int)rng_range(&rng, 0, 3);
+            b = (int)rng_range(&rng, 0, 3);
+            c = (int)rng_range(&rng, 0, 3);
+
+            memcpy(after, before, sizeof(before));
+            after[c] = execute(name, before, a, b);
+        } while(matching_ops(before, after, a, b, c) & ~allowed);
+
+        fprintf(args.out, "Before: [%lld, %lld, %lld, %lld]\n", before[0], before[1], before[2], before[3]);
+        fprintf(args.out, "%d %d %d %d\n", opcode, a, b, c);
+        fprintf(args.out, "After:  [%lld, %lld, %lld, %lld]\n\n", after[0], after[1], after[2], after[3]);
+    }
+
+    free(sample_opcodes);
+
+    fprintf(args.out, "\n\n");
+
+    /*
+     * The solver runs the program on ints, so instructions that would take a
+     * register out of range are dropped.
+     */
+    long long int regs[REGS_LEN] = {0};
+    size_t program_len = BASE_PROGRAM * args.scale;
+    for(size_t i = 0; i < program_len; i++) {
+        int opcode = (int)rng_range(&rng, 0, OPS_LEN - 1);
+        int a = (int)rng_range(&rng, 0, 3);
+        int b = (int)rng_range(&rng, 0, 3);
+        int c = (int)rng_range(&rng, 0, 3);
+
+        long long int value = execute(opcodes[opcode], regs, a, b);
+        if(value > INT_MAX || value < INT_MIN) {
+            i--;
+            continue;
+        }
+
+        regs[c] = value;
+        fprintf(args.out, "%d %d %d %d\n", opcode, a, b, c);
+    }
+
+    gen_close(&args);
+
+    return 0;
+}
+
+static long long int execute(int name, long long int regs[], int a, int b)
+{
+    switch(name) {
+        case ADDR:
+            return regs[a] + regs[b];
+        case ADDI:
+            return regs[a] + b;
+        case MULR:
+            return regs[a] * regs[b];
+        case MULI:
+            return regs[a] * b;
+        case BANR:
+            return regs[a] & regs[b];
+        case BANI:
+            return regs[a] & b;
+        case BORR:
+            return regs[a] | regs[b];
+        case BORI:
+            return regs[a] | b;
+        case SETR:
+            return regs[a];
+        case SETI:
+            return a;
+        case GTIR:
+            return a > regs[b];
+        case GTRI:
+            return regs[a] > b;
+        case GTRR:
+            return regs[a] > regs[b];
+        case EQIR:
+            return a == regs[b];
+        case EQRI:
+            return regs[a] == b;
+        default:
+            return regs[a] == regs[b];
+    }
+}
+
+static int matching_ops(const long long int before[], const long long int after[], int a, int b, int c)
+{
+    int matches = 0;
+
+    for(int name = 0; name < OPS_LEN; name++) {
+        long long int regs[REGS_LEN];
+        memcpy(regs, before, sizeof(regs));
+        regs[c] = execute(name, regs, a, b);
+
+        if(!memcmp(regs, after, sizeof(regs))) {
+            matches |= 1 << name;
+        }
+    }
+
+    return matches;
+}
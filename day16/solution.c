@@ -0,0 +1,381 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "input.h"
+#include "parallel.h"
+#include "scan.h"
+#include "vm.h"
+#include "day16.h"
+
+#define OPCODES 16
+#define REGISTERS 4
+#define SAMPLES_GRAIN 256
+
+struct operation_t {
+    int opcode;
+    int in_a;
+    int in_b;
+    int out;
+};
+
+struct sample_t {
+    struct operation_t op;
+    int before[4];
+    int after[4];
+};
+
+struct behaviours_t {
+    int count;
+    int likely_codes[OPCODES][OPCODES];
+};
+
+struct puzzle_t {
+    struct sample_t *samples;
+    struct operation_t *program;
+    size_t samples_len;
+    size_t program_len;
+};
+
+static struct puzzle_t build_from_input(FILE *stream);
+static int build_sample_from_input(struct view_t line, int regs[]);
+static int build_op_from_input(struct view_t line, struct operation_t *op);
+static int find_similar_behaviours(struct sample_t *samples, size_t samples_len, int **likely_codes);
+static void check_samples(void *ctx, size_t begin, size_t end, void *acc);
+static void add_behaviours(void *ctx, void *acc, const void *other);
+static int execute_program(struct operation_t *program, size_t program_len, int **likely_codes);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct puzzle_t puzzle = build_from_input(input);
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    int **counts = (int **)malloc(sizeof(int *) * 16);
+    if(counts == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(size_t i = 0; i < 16; i++) {
+        counts[i] = (int *)calloc(16, sizeof(int));
+        if(counts[i] == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    int count = find_similar_behaviours(puzzle.samples, puzzle.samples_len, counts);
+    answer_printf(&answer->part1, "%d", count);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    int reg_val = execute_program(puzzle.program, puzzle.program_len, counts);
+    answer_printf(&answer->part2, "%d", reg_val);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    for(size_t i = 0; i < 16; i++)
+        free(counts[i]);
+    free(counts);
+
+    free(puzzle.samples);
+    free(puzzle.program);
+
+    return 0;
+}
+
+static struct puzzle_t build_from_input(FILE *stream)
+{
+    struct puzzle_t puzzle = {.samples = NULL, .samples_len = 0, .program = NULL, .program_len = 0};
+
+    struct input_t reader;
+    input_open(&reader, stream);
+
+    size_t samples_index = 0;
+    size_t program_index = 0;
+    struct view_t line;
+    while(input_next_line(&reader, &line)) {
+        if(line.len == 0) {
+            continue;
+        }
+
+        if(memchr(line.ptr, ':', line.len) != NULL) {
+            struct sample_t sample = {
+                    .before = {0},
+                    .after = {0},
+                    .op = {
+                            .opcode = 0,
+                            .in_a = 0,
+                            .in_b = 0,
+                            .out = 0
+                    }
+            };
+
+            if(build_sample_from_input(line, sample.before)) {
+                fprintf(stderr, "Unexpected error: invalid input: %.*s.\n", (int)line.len, line.ptr);
+                exit(EXIT_FAILURE);
+            }
+
+            if(!input_next_line(&reader, &line)) {
+                fprintf(stderr, "Unexpected error: unexpected end of input.\n");
+                exit(EXIT_FAILURE);
+            }
+
+            if(build_op_from_input(line, &sample.op)) {
+                fprintf(stderr, "Unexpected error: invalid input: %.*s.\n", (int)line.len, line.ptr);
+                exit(EXIT_FAILURE);
+            }
+
+            if(!input_next_line(&reader, &line)) {
+                fprintf(stderr, "Unexpected error: unexpected end of input.\n");
+                exit(EXIT_FAILURE);
+            }
+
+            if(build_sample_from_input(line, sample.after)) {
+                fprintf(stderr, "Unexpected error: invalid input: %.*s.\n", (int)line.len, line.ptr);
+                exit(EXIT_FAILURE);
+            }
+
+            if(samples_index >= puzzle.samples_len) {
+                puzzle.samples_len = (puzzle.samples_len < 16) ? 16 : puzzle.samples_len * 2;
+                puzzle.samples = (struct sample_t *)realloc(puzzle.samples, puzzle.samples_len * sizeof(struct sample_t));
+                if(puzzle.samples == NULL) {
+                    perror("Fatal error: Cannot allocate memory.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+
+            puzzle.samples[samples_index++] = sample;
+        } else {
+            struct operation_t op = {.opcode = 0, .in_a = 0, .in_b = 0, .out = 0};
+
+            if(build_op_from_input(line, &op)) {
+                fprintf(stderr, "Unexpected error: invalid input: %.*s.\n", (int)line.len, line.ptr);
+                exit(EXIT_FAILURE);
+            }
+
+            if(program_index >= puzzle.program_len) {
+                puzzle.program_len = (puzzle.program_len < 16) ? 16 : puzzle.program_len * 2;
+                puzzle.program = (struct operation_t *)realloc(puzzle.program, puzzle.program_len * sizeof(struct operation_t));
+                if(puzzle.program == NULL) {
+                    perror("Fatal error: Cannot allocate memory.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+
+            puzzle.program[program_index++] = op;
+        }
+    }
+
+    input_release(&reader);
+
+    puzzle.samples_len = samples_index;
+    puzzle.samples = (struct sample_t *)realloc(puzzle.samples, puzzle.samples_len * sizeof(struct sample_t));
+    if(puzzle.samples == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    puzzle.program_len = program_index;
+    puzzle.program = (struct operation_t *)realloc(puzzle.program, puzzle.program_len * sizeof(struct operation_t));
+    if(puzzle.program == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return puzzle;
+}
+
+/*
+ * Parses the register listing of a "Before: [a, b, c, d]" or
+ * "After:  [a, b, c, d]" line.
+ */
+static int build_sample_from_input(struct view_t line, int regs[])
+{
+    int32_t fields[5];
+    if(scan_int32(line.ptr, line.len, fields, 5) != 4) {
+        return 1;
+    }
+
+    for(int i = 0; i < 4; i++) {
+        regs[i] = fields[i];
+    }
+
+    return 0;
+}
+
+static int build_op_from_input(struct view_t line, struct operation_t *op)
+{
+    int32_t fields[5];
+    if(scan_int32(line.ptr, line.len, fields, 5) != 4) {
+        return 1;
+    }
+
+    op->opcode = fields[0];
+    op->in_a = fields[1];
+    op->in_b = fields[2];
+    op->out = fields[3];
+
+    if(op->opcode > 15 || op->in_a > 3 || op->in_b > 3 || op->out > 3) {
+        return 1;
+    }
+
+    return 0;
+}
+
+static int find_similar_behaviours(struct sample_t *samples, size_t samples_len, int **likely_codes)
+{
+    struct behaviours_t behaviours;
+    memset(&behaviours, 0, sizeof(behaviours));
+
+    parallel_reduce(0, samples_len, SAMPLES_GRAIN, check_samples, add_behaviours, samples, &behaviours, sizeof(behaviours));
+
+    for(int i = 0; i < OPCODES; i++) {
+        for(int j = 0; j < OPCODES; j++) {
+            likely_codes[i][j] += behaviours.likely_codes[i][j];
+        }
+    }
+
+    return behaviours.count;
+}
+
+/*
+ * Tries every opcode on samples [begin, end), tallying in acc which opcodes
+ * each sample's number behaves like. A sample is run as one program of every
+ * opcode, each writing its own spare register after the four real ones, so
+ * only the register a sample writes needs comparing.
+ */
+static void check_samples(void *ctx, size_t begin, size_t end, void *acc)
+{
+    const struct sample_t *samples = (const struct sample_t *)ctx;
+    struct behaviours_t *behaviours = (struct behaviours_t *)acc;
+
+    struct vm_t vm;
+    vm_init(&vm, REGISTERS + OPCODES, 32, VM_NO_IP);
+
+    struct vm_instr_t probes[OPCODES];
+    for(size_t index = begin; index < end; index++) {
+        const struct sample_t *sample = samples + index;
+
+        int unchanged = 1;
+        for(int i = 0; i < REGISTERS; i++) {
+            unchanged &= i == sample->op.out || sample->before[i] == sample->after[i];
+        }
+
+        if(!unchanged) {
+            continue;
+        }
+
+        for(int opcode = 0; opcode < OPCODES; opcode++) {
+            if(vm_decode(&vm, (enum vm_op_t)opcode, sample->op.in_a, sample->op.in_b, REGISTERS + opcode, &probes[opcode])) {
+                fprintf(stderr, "Unexpected error: invalid sample.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        for(int i = 0; i < REGISTERS; i++) {
+            vm.regs[i] = sample->before[i];
+        }
+
+        vm_exec(&vm, probes, OPCODES);
+
+        int curr = 0;
+        for(int opcode = 0; opcode < OPCODES; opcode++) {
+            if(vm.regs[REGISTERS + opcode] == sample->after[sample->op.out]) {
+                curr++;
+                behaviours->likely_codes[sample->op.opcode][opcode]++;
+            }
+        }
+
+        if(curr >= 3) {
+            behaviours->count++;
+        }
+    }
+
+    vm_release(&vm);
+}
+
+static void add_behaviours(void *ctx, void *acc, const void *other)
+{
+    (void)ctx;
+
+    struct behaviours_t *behaviours = (struct behaviours_t *)acc;
+    const struct behaviours_t *more = (const struct behaviours_t *)other;
+
+    behaviours->count += more->count;
+    for(int i = 0; i < OPCODES; i++) {
+        for(int j = 0; j < OPCODES; j++) {
+            behaviours->likely_codes[i][j] += more->likely_codes[i][j];
+        }
+    }
+}
+
+static int execute_program(struct operation_t *program, size_t program_len, int **likely_codes)
+{
+    int done = 0;
+    do {
+        done = 0;
+
+        int tot = 0;
+        for(size_t i = 0; i < 16; i++) {
+            int count = 0;
+            size_t col = 0;
+
+            for(size_t j = 0; j < 16; j++) {
+                if(likely_codes[i][j] > 0) {
+                    count++;
+                    col = j;
+                }
+            }
+
+            if(count == 0) {
+                fprintf(stderr, "Unexpected error: nondeterministic sample.\n");
+                exit(EXIT_FAILURE);
+            }
+
+            if(count == 1) {
+                for(size_t k = 0; k < 16; k++) {
+                    if(k == i)
+                        continue;
+
+                    likely_codes[k][col] = 0;
+                }
+
+                done++;
+            } else {
+                tot++;
+            }
+        }
+
+        if(tot == 16) {
+            fprintf(stderr, "Unexpected error: nondeterministic sample.\n");
+            exit(EXIT_FAILURE);
+        }
+    } while(done < 16);
+
+    enum vm_op_t ops[16] = {VM_ADDR};
+    for(int i = 0; i < 16; i++) {
+        for(int j = 0; j < 16; j++) {
+            if(likely_codes[i][j] > 0) {
+                ops[i] = (enum vm_op_t)j;
+            }
+        }
+    }
+
+    struct vm_t vm;
+    vm_init(&vm, REGISTERS, 32, VM_NO_IP);
+
+    for(size_t pc = 0; pc < program_len; pc++) {
+        if(vm_push(&vm, ops[program[pc].opcode], program[pc].in_a, program[pc].in_b, program[pc].out)) {
+            fprintf(stderr, "Unexpected error: invalid instruction.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    vm_run(&vm);
+    int reg_val = (int)vm.regs[0];
+
+    vm_release(&vm);
+
+    return reg_val;
+}
+
+const struct aoc_solver_t day16_solver = {.name = "day16", .solve = solve};
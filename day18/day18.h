@@ -0,0 +1,8 @@
+#ifndef AOC_DAY18_H
+#define AOC_DAY18_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day18_solver;
+
+#endif //AOC_DAY18_H
@@ -0,0 +1,38 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gen.h"
+
+#define BASE_DIM 50
+#define MAX_DIM 4000
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    /*
+     * The area is square, so scaling the number of acres scales each side by
+     * the square root of the scale.
+     */
+    unsigned long int scale = gen_clamp_scale("day18", args.scale, (MAX_DIM / BASE_DIM) * (MAX_DIM / BASE_DIM));
+    unsigned long int area = BASE_DIM * BASE_DIM * scale;
+    unsigned long int dim = BASE_DIM;
+    while((dim + 1) * (dim + 1) <= area) {
+        dim++;
+    }
+
+    for(unsigned long int y = 0; y < dim; y++) {
+        for(unsigned long int x = 0; x < dim; x++) {
+            long int acre = rng_range(&rng, 0, 99);
+            fputc(acre < 60 ? '.' : acre < 80 ? '|' : '#', args.out);
+        }
+
+        fputc('\n', args.out);
+    }
+
+    gen_close(&args);
+
+    return 0;
+}
@@ -0,0 +1,460 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "cycle.h"
+#include "grid.h"
+#include "input.h"
+#include "day18.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+#define SEARCH_LIMIT 100000
+
+/*
+ * The area as it is and the one being written for the next minute.
+ */
+struct forest_t {
+    struct grid_t current;
+    struct grid_t next;
+};
+
+/*
+ * Writes the next minute's row of width acres from the current row and the
+ * rows around it.
+ */
+typedef void (*step_row_t)(const unsigned char *above, const unsigned char *row, const unsigned char *below,
+        unsigned char *next, int width);
+
+static long long int value_after_n_minutes(const struct grid_t *area, int minutes);
+static void advance_minute(void *ctx, void *state);
+static uint64_t hash_area(void *ctx, const void *state);
+static int same_area(void *ctx, const void *a, const void *b);
+static void *clone_forest(void *ctx, const void *state);
+static void release_forest(void *ctx, void *state);
+static step_row_t select_step_row(void);
+static void step_row_scalar(const unsigned char *above, const unsigned char *row, const unsigned char *below,
+        unsigned char *next, int width);
+#ifdef CPU_X86
+CPU_TARGET_SSE42 static void step_row_sse42(const unsigned char *above, const unsigned char *row,
+        const unsigned char *below, unsigned char *next, int width);
+CPU_TARGET_AVX2 static void step_row_avx2(const unsigned char *above, const unsigned char *row,
+        const unsigned char *below, unsigned char *next, int width);
+CPU_TARGET_AVX512 static void step_row_avx512(const unsigned char *above, const unsigned char *row,
+        const unsigned char *below, unsigned char *next, int width);
+#endif
+static int adjacent_acres_count(const unsigned char *above, const unsigned char *row, const unsigned char *below,
+        int x, unsigned char type);
+static long long int compute_value(const struct grid_t *area);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    size_t dim = 0;
+    size_t area_index = 0;
+    struct grid_t area = {.cells = NULL};
+
+    struct view_t line;
+    while(input_next_line(&reader, &line)) {
+        if(area.cells != NULL && area_index >= dim) {
+            fprintf(stderr, "Unexpected error: unexpected dimensions.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        /*
+         * The area is square, so the first line gives the number of rows to
+         * expect as well. Its border is open ground, which never counts
+         * towards a neighbouring acre's change.
+         */
+        if(area.cells == NULL) {
+            dim = line.len;
+            if(dim == 0) {
+                fprintf(stderr, "Unexpected error: unexpected dimensions.\n");
+                exit(EXIT_FAILURE);
+            }
+
+            grid_init(&area, (int)dim, (int)dim, 1, sizeof(unsigned char));
+        }
+
+        if(line.len != dim) {
+            fprintf(stderr, "Unexpected error: unexpected dimensions.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        unsigned char *row = GRID_ROW(&area, unsigned char, area_index);
+        for(size_t c = 0; c < line.len; c++) {
+            switch(line.ptr[c]) {
+                case '.':
+                    row[c] = 0;
+                    break;
+                case '|':
+                    row[c] = 1;
+                    break;
+                case '#':
+                    row[c] = 2;
+                    break;
+                default:
+                    fprintf(stderr, "Unexpected error: unexpected input %.*s.\n", (int)line.len, line.ptr);
+                    exit(EXIT_FAILURE);
+            }
+        }
+
+        area_index++;
+    }
+
+    input_release(&reader);
+
+    if(area.cells == NULL || area_index != dim) {
+        fprintf(stderr, "Unexpected error: unexpected dimensions.\n");
+        exit(EXIT_FAILURE);
+    }
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    long long int value = value_after_n_minutes(&area, 10);
+    answer_printf(&answer->part1, "%lld", value);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    value = value_after_n_minutes(&area, 1000000000);
+    answer_printf(&answer->part2, "%lld", value);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    grid_release(&area);
+
+    return 0;
+}
+
+/*
+ * The area settles into a loop of states, which the cycle finder spots by
+ * hashing every minute's area and confirming a repeat over one more lap, so
+ * only the first two laps and the minutes left over after the last whole one
+ * are simulated.
+ */
+static long long int value_after_n_minutes(const struct grid_t *area, int minutes)
+{
+    struct forest_t forest;
+    grid_init(&forest.current, area->width, area->height, 1, sizeof(unsigned char));
+    grid_init(&forest.next, area->width, area->height, 1, sizeof(unsigned char));
+    grid_copy(&forest.current, area);
+
+    step_row_t step_row = select_step_row();
+
+    struct cycle_sim_t sim = {
+        .ctx = &step_row,
+        .step = advance_minute,
+        .hash = hash_area,
+        .equal = same_area,
+        .clone = clone_forest,
+        .release = release_forest,
+        .search_limit = SEARCH_LIMIT
+    };
+
+    struct cycle_t cycle;
+    if(cycle_advance(&sim, &forest, CYCLE_HASHED, (uint64_t)minutes, &cycle)) {
+        fprintf(stderr, "Limit reached: the area did not repeat after %d minutes.\n", SEARCH_LIMIT);
+        exit(1);
+    }
+
+    long long int value = compute_value(&forest.current);
+
+    grid_release(&forest.current);
+    grid_release(&forest.next);
+
+    return value;
+}
+
+/*
+ * Each minute reads the current area and writes every acre of the next one,
+ * then the two are swapped.
+ */
+static void advance_minute(void *ctx, void *state)
+{
+    step_row_t step_row = *(const step_row_t *)ctx;
+
+    struct forest_t *forest = (struct forest_t *)state;
+    const struct grid_t *current = &forest->current;
+
+    for(int i = 0; i < current->height; i++) {
+        step_row(GRID_ROW(current, unsigned char, i - 1), GRID_ROW(current, unsigned char, i),
+                 GRID_ROW(current, unsigned char, i + 1), GRID_ROW(&forest->next, unsigned char, i), current->width);
+    }
+
+    grid_swap(&forest->current, &forest->next);
+}
+
+static uint64_t hash_area(void *ctx, const void *state)
+{
+    (void)ctx;
+
+    const struct grid_t *area = &((const struct forest_t *)state)->current;
+
+    uint64_t hash = CYCLE_HASH_SEED;
+    for(int i = 0; i < area->height; i++) {
+        hash = cycle_hash_bytes(hash, GRID_ROW(area, unsigned char, i), (size_t)area->width);
+    }
+
+    return hash;
+}
+
+static int same_area(void *ctx, const void *a, const void *b)
+{
+    (void)ctx;
+
+    const struct grid_t *area_a = &((const struct forest_t *)a)->current;
+    const struct grid_t *area_b = &((const struct forest_t *)b)->current;
+
+    for(int i = 0; i < area_a->height; i++) {
+        if(memcmp(GRID_ROW(area_a, unsigned char, i), GRID_ROW(area_b, unsigned char, i), (size_t)area_a->width) != 0) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static void *clone_forest(void *ctx, const void *state)
+{
+    (void)ctx;
+
+    const struct forest_t *forest = (const struct forest_t *)state;
+
+    struct forest_t *clone = (struct forest_t *)malloc(sizeof(struct forest_t));
+    if(clone == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    grid_init(&clone->current, forest->current.width, forest->current.height, 1, sizeof(unsigned char));
+    grid_init(&clone->next, forest->next.width, forest->next.height, 1, sizeof(unsigned char));
+    grid_copy(&clone->current, &forest->current);
+
+    return clone;
+}
+
+static void release_forest(void *ctx, void *state)
+{
+    (void)ctx;
+
+    struct forest_t *forest = (struct forest_t *)state;
+
+    grid_release(&forest->current);
+    grid_release(&forest->next);
+    free(forest);
+}
+
+static step_row_t select_step_row(void)
+{
+#ifdef CPU_X86
+    switch(cpu_tier()) {
+        case CPU_TIER_AVX512:
+            return step_row_avx512;
+        case CPU_TIER_AVX2:
+            return step_row_avx2;
+        case CPU_TIER_SSE42:
+            return step_row_sse42;
+        default:
+            break;
+    }
+#endif
+
+    return step_row_scalar;
+}
+
+static void step_row_scalar(const unsigned char *above, const unsigned char *row, const unsigned char *below,
+        unsigned char *next, int width)
+{
+    for(int j = 0; j < width; j++) {
+        switch(row[j]) {
+            case 0:
+                next[j] = adjacent_acres_count(above, row, below, j, 1) >= 3 ? 1 : 0;
+                break;
+            case 1:
+                next[j] = adjacent_acres_count(above, row, below, j, 2) >= 3 ? 2 : 1;
+                break;
+            case 2:
+                if(adjacent_acres_count(above, row, below, j, 2) < 1 || adjacent_acres_count(above, row, below, j, 1) < 1) {
+                    next[j] = 0;
+                } else {
+                    next[j] = 2;
+                }
+                break;
+            default:
+                fprintf(stderr, "Unexpected error: unexpected acre value.\n");
+                exit(EXIT_FAILURE);
+        }
+    }
+}
+
+#ifdef CPU_X86
+/*
+ * The vector versions count the trees and lumberyards around a vector of
+ * acres at once, from the eight neighbouring vectors, each comparison adding
+ * -1 or 0 to a negated count, and then pick the next value for all three
+ * kinds of acre with masks instead of branches. The SSE and AVX2 versions
+ * finish with one vector ending at the last acre, overlapping the one before,
+ * which only writes the same values again.
+ */
+CPU_TARGET_SSE42 static void step_row_sse42(const unsigned char *above, const unsigned char *row,
+        const unsigned char *below, unsigned char *next, int width)
+{
+    if(width < 16) {
+        step_row_scalar(above, row, below, next, width);
+        return;
+    }
+
+    const unsigned char *rows[3] = {above, row, below};
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i two = _mm_set1_epi8(2);
+
+    for(int x = 0; x < width; x += 16) {
+        int at = x + 16 <= width ? x : width - 16;
+
+        __m128i trees = zero;
+        __m128i lumberyards = zero;
+        for(int r = 0; r < 3; r++) {
+            for(int dx = -1; dx <= 1; dx++) {
+                if(r == 1 && dx == 0) {
+                    continue;
+                }
+
+                __m128i acres = _mm_loadu_si128((const __m128i *)(rows[r] + at + dx));
+                trees = _mm_sub_epi8(trees, _mm_cmpeq_epi8(acres, one));
+                lumberyards = _mm_sub_epi8(lumberyards, _mm_cmpeq_epi8(acres, two));
+            }
+        }
+
+        __m128i acres = _mm_loadu_si128((const __m128i *)(row + at));
+        __m128i open = _mm_and_si128(_mm_cmpeq_epi8(acres, zero), _mm_and_si128(_mm_cmpgt_epi8(trees, two), one));
+        __m128i wooded = _mm_and_si128(_mm_cmpeq_epi8(acres, one), _mm_sub_epi8(one, _mm_cmpgt_epi8(lumberyards, two)));
+        __m128i lumber = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(acres, two), two),
+                                       _mm_and_si128(_mm_cmpgt_epi8(trees, zero), _mm_cmpgt_epi8(lumberyards, zero)));
+
+        _mm_storeu_si128((__m128i *)(next + at), _mm_or_si128(_mm_or_si128(open, wooded), lumber));
+    }
+}
+
+CPU_TARGET_AVX2 static void step_row_avx2(const unsigned char *above, const unsigned char *row,
+        const unsigned char *below, unsigned char *next, int width)
+{
+    if(width < 32) {
+        step_row_sse42(above, row, below, next, width);
+        return;
+    }
+
+    const unsigned char *rows[3] = {above, row, below};
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i two = _mm256_set1_epi8(2);
+
+    for(int x = 0; x < width; x += 32) {
+        int at = x + 32 <= width ? x : width - 32;
+
+        __m256i trees = zero;
+        __m256i lumberyards = zero;
+        for(int r = 0; r < 3; r++) {
+            for(int dx = -1; dx <= 1; dx++) {
+                if(r == 1 && dx == 0) {
+                    continue;
+                }
+
+                __m256i acres = _mm256_loadu_si256((const __m256i *)(rows[r] + at + dx));
+                trees = _mm256_sub_epi8(trees, _mm256_cmpeq_epi8(acres, one));
+                lumberyards = _mm256_sub_epi8(lumberyards, _mm256_cmpeq_epi8(acres, two));
+            }
+        }
+
+        __m256i acres = _mm256_loadu_si256((const __m256i *)(row + at));
+        __m256i open = _mm256_and_si256(_mm256_cmpeq_epi8(acres, zero),
+                                        _mm256_and_si256(_mm256_cmpgt_epi8(trees, two), one));
+        __m256i wooded = _mm256_and_si256(_mm256_cmpeq_epi8(acres, one),
+                                          _mm256_sub_epi8(one, _mm256_cmpgt_epi8(lumberyards, two)));
+        __m256i lumber = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(acres, two), two),
+                                          _mm256_and_si256(_mm256_cmpgt_epi8(trees, zero),
+                                                           _mm256_cmpgt_epi8(lumberyards, zero)));
+
+        _mm256_storeu_si256((__m256i *)(next + at), _mm256_or_si256(_mm256_or_si256(open, wooded), lumber));
+    }
+}
+
+/*
+ * AVX-512 masks off the acres past the end of the row instead, so a row
+ * narrower than a vector is a single masked step.
+ */
+CPU_TARGET_AVX512 static void step_row_avx512(const unsigned char *above, const unsigned char *row,
+        const unsigned char *below, unsigned char *next, int width)
+{
+    const unsigned char *rows[3] = {above, row, below};
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi8(1);
+    const __m512i two = _mm512_set1_epi8(2);
+
+    for(int x = 0; x < width; x += 64) {
+        __mmask64 lanes = width - x >= 64 ? ~(__mmask64)0 : ((__mmask64)1 << (width - x)) - 1;
+
+        __m512i trees = zero;
+        __m512i lumberyards = zero;
+        for(int r = 0; r < 3; r++) {
+            for(int dx = -1; dx <= 1; dx++) {
+                if(r == 1 && dx == 0) {
+                    continue;
+                }
+
+                __m512i acres = _mm512_maskz_loadu_epi8(lanes, rows[r] + x + dx);
+                trees = _mm512_mask_add_epi8(trees, _mm512_cmpeq_epi8_mask(acres, one), trees, one);
+                lumberyards = _mm512_mask_add_epi8(lumberyards, _mm512_cmpeq_epi8_mask(acres, two), lumberyards, one);
+            }
+        }
+
+        __m512i acres = _mm512_maskz_loadu_epi8(lanes, row + x);
+        __mmask64 open = _mm512_cmpeq_epi8_mask(acres, zero) & _mm512_cmpgt_epi8_mask(trees, two);
+        __mmask64 wooded = _mm512_cmpeq_epi8_mask(acres, one);
+        __mmask64 lumber = _mm512_cmpeq_epi8_mask(acres, two) & _mm512_cmpgt_epi8_mask(trees, zero) &
+                           _mm512_cmpgt_epi8_mask(lumberyards, zero);
+
+        __m512i wooded_next = _mm512_mask_mov_epi8(one, _mm512_cmpgt_epi8_mask(lumberyards, two), two);
+        __m512i result = _mm512_or_si512(_mm512_or_si512(_mm512_maskz_mov_epi8(open, one),
+                                                         _mm512_maskz_mov_epi8(wooded, wooded_next)),
+                                         _mm512_maskz_mov_epi8(lumber, two));
+
+        _mm512_mask_storeu_epi8(next + x, lanes, result);
+    }
+}
+#endif
+
+/*
+ * The border around the area lets every acre look at all eight neighbours
+ * without checking whether they exist.
+ */
+static int adjacent_acres_count(const unsigned char *above, const unsigned char *row, const unsigned char *below,
+        int x, unsigned char type)
+{
+    return (above[x - 1] == type) + (above[x] == type) + (above[x + 1] == type) +
+           (row[x - 1] == type) + (row[x + 1] == type) +
+           (below[x - 1] == type) + (below[x] == type) + (below[x + 1] == type);
+}
+
+static long long int compute_value(const struct grid_t *area)
+{
+    int wood_areas = 0;
+    int lumberyards = 0;
+    for(int i = 0; i < area->height; i++) {
+        const unsigned char *row = GRID_ROW(area, unsigned char, i);
+
+        for(int j = 0; j < area->width; j++) {
+            if(row[j] == 1) {
+                wood_areas++;
+            } else if(row[j] == 2) {
+                lumberyards++;
+            }
+        }
+    }
+
+    return (long long int)wood_areas * lumberyards;
+}
+
+const struct aoc_solver_t day18_solver = {.name = "day18", .solve = solve, .version = 1};
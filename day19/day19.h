@@ -0,0 +1,8 @@
+#ifndef AOC_DAY19_H
+#define AOC_DAY19_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day19_solver;
+
+#endif //AOC_DAY19_H
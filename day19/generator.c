@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gen.h"
+
+#define BASE_TARGET 1000
+#define MAX_TARGET 46340
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    /*
+     * The program sums the divisors of a target number by testing every pair
+     * of factors, so part 1 runs in time quadratic in the target. The product
+     * of two factors has to fit in an int, which caps the target.
+     */
+    unsigned long int scale = gen_clamp_scale("day19", args.scale, MAX_TARGET / BASE_TARGET);
+    long int target = rng_range(&rng, BASE_TARGET * (long int)scale - BASE_TARGET / 10, BASE_TARGET * (long int)scale);
+
+    /*
+     * The setup code at the end of the program builds the target as
+     * 76 * a + 22 * b + c; 76 and 22 come from reading the instruction
+     * pointer at fixed addresses.
+     */
+    long int a = target / 76 - rng_range(&rng, 0, target / 76 / 4);
+    long int b = (target - 76 * a) / 22;
+    long int c = target - 76 * a - 22 * b;
+
+    fprintf(args.out,
+            "#ip 3\n"
+            "addi 3 16 3\n"
+            "seti 1 3 1\n"
+            "seti 1 2 4\n"
+            "mulr 1 4 5\n"
+            "eqrr 5 2 5\n"
+            "addr 5 3 3\n"
+            "addi 3 1 3\n"
+            "addr 1 0 0\n"
+            "addi 4 1 4\n"
+            "gtrr 4 2 5\n"
+            "addr 3 5 3\n"
+            "seti 2 6 3\n"
+            "addi 1 1 1\n"
+            "gtrr 1 2 5\n"
+            "addr 5 3 3\n"
+            "seti 1 0 3\n"
+            "mulr 3 3 3\n"
+            "addi 2 2 2\n"
+            "mulr 2 2 2\n"
+            "mulr 3 2 2\n"
+            "muli 2 %ld 2\n"
+            "addi 5 %ld 5\n"
+            "mulr 5 3 5\n"
+            "addi 5 %ld 5\n"
+            "addr 2 5 2\n"
+            "addr 3 0 3\n"
+            "seti 0 5 3\n"
+            "setr 3 0 5\n"
+            "mulr 5 3 5\n"
+            "addr 3 5 5\n"
+            "mulr 3 5 5\n"
+            "muli 5 14 5\n"
+            "mulr 5 3 5\n"
+            "addr 2 5 2\n"
+            "seti 0 8 0\n"
+            "seti 0 9 3\n",
+            a, b, c);
+
+    gen_close(&args);
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "hashmap.h"
+#include "input.h"
+#include "vm.h"
+#include "trace.h"
+#include "warm.h"
+#include "day19.h"
+
+/*
+ * A decoded program along with the source it was decoded from, so that a warm
+ * one is only reused for the very same source, not merely one with the same
+ * key.
+ */
+struct program_t {
+    struct vm_t vm;
+    char *source;
+    size_t source_len;
+};
+
+static void build_op_table(struct hashmap_t *ops);
+static int compile(struct input_t *reader, struct vm_t *vm);
+static int same_source(const struct program_t *program, const char *source, size_t source_len);
+static void release_program(void *program);
+
+/*
+ * A worker that is handed the same program again keeps it decoded (see
+ * warm.h), keyed by a hash of the source bytes and checked against the bytes
+ * themselves.
+ */
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+    uint64_t key = warm_key_bytes(reader.data, reader.len);
+
+    struct program_t *program = (struct program_t *)warm_take(&day19_solver, key);
+    if(program != NULL && !same_source(program, reader.data, reader.len)) {
+        release_program(program);
+        program = NULL;
+    }
+
+    if(program == NULL) {
+        program = (struct program_t *)malloc(sizeof(struct program_t));
+        char *source = (char *)malloc(reader.len + 1);
+        if(program == NULL || source == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        memcpy(source, reader.data, reader.len);
+        program->source = source;
+        program->source_len = reader.len;
+
+        TRACE_BEGIN(compile);
+        int ret = compile(&reader, &program->vm);
+        TRACE_END(compile);
+        if(ret == 1) {
+            fprintf(stderr, "Fatal Error: unable to compile source.\n");
+            exit(EXIT_FAILURE);
+        }
+    } else {
+        vm_reset(&program->vm);
+    }
+
+    struct vm_t *vm = &program->vm;
+
+    input_release(&reader);
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    TRACE_BEGIN(execute);
+    vm_run(vm);
+    TRACE_END(execute);
+    TRACE_COUNT(instructions_retired, vm->retired);
+    answer_printf(&answer->part1, "%" PRId64, vm->regs[0]);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    warm_keep(&day19_solver, key, program, release_program);
+
+    return 0;
+}
+
+static int same_source(const struct program_t *program, const char *source, size_t source_len)
+{
+    return program->source_len == source_len && memcmp(program->source, source, source_len) == 0;
+}
+
+static void release_program(void *program)
+{
+    struct program_t *warm = (struct program_t *)program;
+
+    vm_release(&warm->vm);
+    free(warm->source);
+    free(warm);
+}
+
+/*
+ * Maps each instruction name, packed into a key, to its opcode.
+ */
+static void build_op_table(struct hashmap_t *ops)
+{
+    hashmap_init(ops, VM_OPS);
+
+    for(int op = 0; op < VM_OPS; op++) {
+        const char *name = vm_op_name((enum vm_op_t)op);
+        hashmap_put(ops, hashmap_key_bytes(name, strlen(name)), (uint64_t)op);
+    }
+}
+
+static int compile(struct input_t *reader, struct vm_t *vm)
+{
+    struct hashmap_t ops;
+    build_op_table(&ops);
+
+    /* Without an #ip line, the instruction pointer is bound to register 0. */
+    vm_init(vm, 6, 32, 0);
+
+    struct view_t line;
+    while(input_next_line(reader, &line)) {
+        if(!view_expect(&line, "#ip")) {
+            long int ip_reg;
+            if(view_parse_long(&line, &ip_reg) || ip_reg < 0 || ip_reg >= 6) {
+                hashmap_release(&ops);
+                vm_release(vm);
+                return 1;
+            }
+
+            vm->ip_reg = (int)ip_reg;
+        } else {
+            size_t name_len = line.len;
+            const char *space = memchr(line.ptr, ' ', line.len);
+            if(space != NULL)
+                name_len = (size_t)(space - line.ptr);
+
+            uint64_t *code = name_len <= sizeof(uint64_t) ? hashmap_get(&ops, hashmap_key_bytes(line.ptr, name_len)) : NULL;
+            if(code == NULL) {
+                hashmap_release(&ops);
+                vm_release(vm);
+                return 1;
+            }
+
+            enum vm_op_t op = (enum vm_op_t)*code;
+            line.ptr += name_len;
+            line.len -= name_len;
+
+            long int fields[3];
+            for(int field = 0; field < 3; field++) {
+                if(view_parse_long(&line, &fields[field])) {
+                    hashmap_release(&ops);
+                    vm_release(vm);
+                    return 1;
+                }
+            }
+
+            if(vm_push(vm, op, fields[0], fields[1], fields[2])) {
+                hashmap_release(&ops);
+                vm_release(vm);
+                return 1;
+            }
+        }
+    }
+
+    hashmap_release(&ops);
+
+    return 0;
+}
+
+const struct aoc_solver_t day19_solver = {.name = "day19", .solve = solve, .version = 1};
@@ -0,0 +1,8 @@
+#ifndef AOC_DAY2_H
+#define AOC_DAY2_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day2_solver;
+
+#endif //AOC_DAY2_H
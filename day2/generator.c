@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gen.h"
+
+#define BASE_IDS 250
+#define ID_LEN 26
+
+static void random_id(struct rng_t *rng, char id[]);
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    long int ids_len = BASE_IDS * (long int)args.scale;
+    char (*ids)[ID_LEN + 1] = malloc(sizeof(*ids) * ids_len);
+    if(ids == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(long int i = 0; i < ids_len; i++) {
+        random_id(&rng, ids[i]);
+    }
+
+    /*
+     * Random IDs of this length practically never differ by a single
+     * character, so plant exactly one such pair.
+     */
+    long int a = rng_range(&rng, 0, ids_len - 1);
+    long int b = rng_range(&rng, 0, ids_len - 2);
+    if(b >= a) {
+        b++;
+    }
+
+    long int pos = rng_range(&rng, 0, ID_LEN - 1);
+    memcpy(ids[b], ids[a], ID_LEN + 1);
+    ids[b][pos] = (char)('a' + (ids[a][pos] - 'a' + rng_range(&rng, 1, 25)) % 26);
+
+    for(long int i = 0; i < ids_len; i++) {
+        fprintf(args.out, "%s\n", ids[i]);
+    }
+
+    free(ids);
+    gen_close(&args);
+
+    return 0;
+}
+
+static void random_id(struct rng_t *rng, char id[])
+{
+    for(int i = 0; i < ID_LEN; i++) {
+        id[i] = (char)('a' + rng_range(rng, 0, 25));
+    }
+
+    id[ID_LEN] = 0;
+}
@@ -0,0 +1,251 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "arena.h"
+#include "input.h"
+#include "stream.h"
+#include "day2.h"
+
+#define BUFF_LEN 32
+#define ID_MAX_LEN 64
+
+struct id_record_t {
+    size_t len;
+    char id[ID_MAX_LEN];
+};
+
+static int parse_id(struct view_t line, void *record);
+static void solve_common_chars(struct aoc_answer_t *answer, struct view_t *ids, int len, size_t id_max_len);
+static unsigned char id_multiples(struct view_t id, int occr);
+static char *find_common_chars(struct view_t *ids, int len, char *buffer, size_t buffer_len);
+static char *find_common_chars_ids(struct view_t id_a, struct view_t id_b, char *buffer, size_t buffer_len);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    int ids_index = 0;
+    int ids_len = BUFF_LEN;
+
+    struct view_t *ids = (struct view_t *)malloc(sizeof(struct view_t) * ids_len);
+    if(ids == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t id_max_len = 0;
+    int freq2 = 0;
+    int freq3 = 0;
+    struct view_t id;
+    while(input_next_line(&reader, &id)) {
+        if(id_multiples(id, 2)) {
+            freq2++;
+        }
+
+        if(id_multiples(id, 3)) {
+            freq3++;
+        }
+
+        if(ids_index >= ids_len) {
+            ids_len = ids_len * 2;
+            ids = (struct view_t *)realloc(ids, sizeof(struct view_t) * ids_len);
+            if(ids == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if(id.len > id_max_len) {
+            id_max_len = id.len;
+        }
+
+        ids[ids_index] = id;
+        ids_index++;
+    }
+
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    answer_printf(&answer->part1, "%d (%d * %d)", freq2 * freq3, freq2, freq3);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    solve_common_chars(answer, ids, ids_index, id_max_len);
+    free(ids);
+    input_release(&reader);
+
+    return 0;
+}
+
+/*
+ * The checksum is tallied as each id arrives. The ids are copied into an
+ * arena, since part 2 compares every pair of them.
+ */
+static int solve_stream(FILE *input, struct aoc_answer_t *answer)
+{
+    struct stream_t stream;
+    stream_open(&stream, input, sizeof(struct id_record_t), parse_id);
+
+    struct arena_t arena;
+    arena_init(&arena, ARENA_DEFAULT_BLOCK_SIZE);
+
+    int ids_index = 0;
+    int ids_len = BUFF_LEN;
+
+    struct view_t *ids = (struct view_t *)malloc(sizeof(struct view_t) * ids_len);
+    if(ids == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t id_max_len = 0;
+    int freq2 = 0;
+    int freq3 = 0;
+    const struct id_record_t *record;
+    while((record = (const struct id_record_t *)stream_next(&stream)) != NULL) {
+        char *copy = (char *)arena_alloc(&arena, record->len);
+        memcpy(copy, record->id, record->len);
+
+        struct view_t id = {.ptr = copy, .len = record->len};
+        if(id_multiples(id, 2)) {
+            freq2++;
+        }
+
+        if(id_multiples(id, 3)) {
+            freq3++;
+        }
+
+        if(ids_index >= ids_len) {
+            ids_len = ids_len * 2;
+            ids = (struct view_t *)realloc(ids, sizeof(struct view_t) * ids_len);
+            if(ids == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if(id.len > id_max_len) {
+            id_max_len = id.len;
+        }
+
+        ids[ids_index] = id;
+        ids_index++;
+    }
+
+    stream_close(&stream);
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    answer_printf(&answer->part1, "%d (%d * %d)", freq2 * freq3, freq2, freq3);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    solve_common_chars(answer, ids, ids_index, id_max_len);
+    free(ids);
+    arena_release(&arena);
+
+    return 0;
+}
+
+static int parse_id(struct view_t line, void *record)
+{
+    struct id_record_t *id = (struct id_record_t *)record;
+    if(line.len > ID_MAX_LEN) {
+        return 1;
+    }
+
+    memcpy(id->id, line.ptr, line.len);
+    id->len = line.len;
+
+    return 0;
+}
+
+static void solve_common_chars(struct aoc_answer_t *answer, struct view_t *ids, int len, size_t id_max_len)
+{
+    size_t buffer_len = id_max_len + 1;
+    char *buffer = (char *)malloc(sizeof(char) * buffer_len);
+    if(buffer == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    buffer = find_common_chars(ids, len, buffer, buffer_len);
+    if(buffer == NULL) {
+        fprintf(stderr, "Fatal error: Unexpected error occurred while finding matching characters.\n");
+        exit(1);
+    }
+
+    answer_printf(&answer->part2, "%s", buffer);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    free(buffer);
+}
+
+static unsigned char id_multiples(struct view_t id, int occr)
+{
+    const char *end = id.ptr + id.len;
+
+    for(const char *ptr_a = id.ptr; ptr_a < end; ptr_a++) {
+        int count = 1;
+
+        for(const char *ptr_b = id.ptr; ptr_b < end; ptr_b++) {
+            if(ptr_a == ptr_b) {
+                continue;
+            }
+
+            if(*ptr_b == *ptr_a) {
+                count++;
+            }
+        }
+
+
+        if(count == occr) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static char *find_common_chars(struct view_t *ids, int len, char *buffer, size_t buffer_len)
+{
+    for(int ids_a = 0; ids_a < len; ids_a++) {
+        for(int ids_b = 0; ids_b < len; ids_b++) {
+            if(ids_a == ids_b) {
+                continue;
+            }
+
+            buffer = find_common_chars_ids(ids[ids_a], ids[ids_b], buffer, buffer_len);
+            if(buffer == NULL) {
+                return NULL;
+            }
+
+            if(strlen(buffer) == (ids[ids_a].len - 1)) {
+                return buffer;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static char *find_common_chars_ids(struct view_t id_a, struct view_t id_b, char *buffer, size_t buffer_len)
+{
+    size_t len = id_a.len;
+
+    if(len != id_b.len || len >= buffer_len) {
+        return NULL;
+    }
+
+    memset(buffer, 0, sizeof(char) * buffer_len);
+
+    int buff_index = 0;
+    for(size_t i = 0; i < len; i++) {
+        if(id_a.ptr[i] == id_b.ptr[i]) {
+            buffer[buff_index] = id_a.ptr[i];
+            buff_index++;
+        }
+    }
+
+    return buffer;
+}
+
+const struct aoc_solver_t day2_solver = {.name = "day2", .solve = solve, .solve_stream = solve_stream, .version = 1};
@@ -0,0 +1,8 @@
+#ifndef AOC_DAY3_H
+#define AOC_DAY3_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day3_solver;
+
+#endif //AOC_DAY3_H
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gen.h"
+
+#define BASE_CLAIMS 1250
+#define FABRIC_DIM 1000
+#define MIN_DIM 3
+#define MAX_DIM 29
+#define MAX_ATTEMPTS 64
+
+struct claim_t {
+    long int pos_x;
+    long int pos_y;
+    long int dim_x;
+    long int dim_y;
+};
+
+static struct claim_t random_claim(struct rng_t *rng);
+static struct claim_t random_overlapping_claim(struct rng_t *rng, struct claim_t other);
+static int claims_overlap(struct claim_t a, struct claim_t b);
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    long int claims_len = BASE_CLAIMS * (long int)args.scale;
+    struct claim_t *claims = (struct claim_t *)malloc(sizeof(struct claim_t) * claims_len);
+    if(claims == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /*
+     * Exactly one claim may be left without an overlap. Every other claim is
+     * generated next to a partner it overlaps, and nothing may touch the
+     * reserved claim.
+     */
+    long int reserved_index = rng_range(&rng, 0, claims_len - 1);
+    struct claim_t reserved = random_claim(&rng);
+
+    struct claim_t previous = reserved;
+    int paired = 1;
+    for(long int i = 0; i < claims_len; i++) {
+        if(i == reserved_index) {
+            claims[i] = reserved;
+            continue;
+        }
+
+        struct claim_t claim;
+        int attempts = 0;
+        do {
+            claim = paired ? random_claim(&rng) : random_overlapping_claim(&rng, previous);
+            attempts++;
+        } while(claims_overlap(claim, reserved) && (paired || attempts < MAX_ATTEMPTS));
+
+        if(claims_overlap(claim, reserved)) {
+            claim = previous;
+        }
+
+        claims[i] = claim;
+        previous = claim;
+        paired = !paired;
+    }
+
+    /*
+     * A trailing unpaired claim is moved on top of the one before it.
+     */
+    if(!paired) {
+        long int last = claims_len - 1 == reserved_index ? claims_len - 2 : claims_len - 1;
+        long int before = last - 1 == reserved_index ? last - 2 : last - 1;
+        if(before >= 0) {
+            claims[last] = claims[before];
+        }
+    }
+
+    for(long int i = 0; i < claims_len; i++) {
+        fprintf(args.out, "#%ld @ %ld,%ld: %ldx%ld\n", i + 1, claims[i].pos_x, claims[i].pos_y, claims[i].dim_x, claims[i].dim_y);
+    }
+
+    free(claims);
+    gen_close(&args);
+
+    return 0;
+}
+
+static struct claim_t random_claim(struct rng_t *rng)
+{
+    struct claim_t claim;
+
+    claim.dim_x = rng_range(rng, MIN_DIM, MAX_DIM);
+    claim.dim_y = rng_range(rng, MIN_DIM, MAX_DIM);
+    claim.pos_x = rng_range(rng, 0, FABRIC_DIM - claim.dim_x);
+    claim.pos_y = rng_range(rng, 0, FABRIC_DIM - claim.dim_y);
+
+    return claim;
+}
+
+static struct claim_t random_overlapping_claim(struct rng_t *rng, struct claim_t other)
+{
+    struct claim_t claim;
+
+    claim.dim_x = rng_range(rng, MIN_DIM, MAX_DIM);
+    claim.dim_y = rng_range(rng, MIN_DIM, MAX_DIM);
+
+    long int lower_x = other.pos_x - claim.dim_x + 1;
+    long int upper_x = other.pos_x + other.dim_x - 1;
+    long int lower_y = other.pos_y - claim.dim_y + 1;
+    long int upper_y = other.pos_y + other.dim_y - 1;
+
+    claim.pos_x = rng_range(rng, lower_x < 0 ? 0 : lower_x, upper_x > FABRIC_DIM - claim.dim_x ? FABRIC_DIM - claim.dim_x : upper_x);
+    claim.pos_y = rng_range(rng, lower_y < 0 ? 0 : lower_y, upper_y > FABRIC_DIM - claim.dim_y ? FABRIC_DIM - claim.dim_y : upper_y);
+
+    return claim;
+}
+
+static int claims_overlap(struct claim_t a, struct claim_t b)
+{
+    return a.pos_x < b.pos_x + b.dim_x && b.pos_x < a.pos_x + a.dim_x &&
+           a.pos_y < b.pos_y + b.dim_y && b.pos_y < a.pos_y + a.dim_y;
+}
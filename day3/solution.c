@@ -0,0 +1,227 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "grid.h"
+#include "input.h"
+#include "scan.h"
+#include "stream.h"
+#include "day3.h"
+
+#define FABRIC_DIM 1000
+#define BUFF_LEN 32
+
+struct claim_t {
+    long int claim_id;
+    long int pos_x;
+    long int pos_y;
+    long int dim_x;
+    long int dim_y;
+};
+
+static int build_claim(struct view_t line, struct claim_t *claim);
+static int parse_claim(struct view_t line, void *record);
+static void add_claim(struct grid_t *fabric, struct claim_t claim);
+static int find_overlapping_fabric_inches(const struct grid_t *fabric);
+static long int find_non_overlapping_id(const struct grid_t *fabric, struct claim_t *claims, int claims_len);
+static int claim_overlaps(const struct grid_t *fabric, struct claim_t claim);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct grid_t fabric;
+    grid_init(&fabric, FABRIC_DIM, FABRIC_DIM, 0, sizeof(int));
+
+    struct input_t reader;
+    input_open(&reader, input);
+
+    int claims_len = BUFF_LEN;
+    int claims_index = 0;
+    struct claim_t *claims = (struct claim_t *)malloc(sizeof(struct claim_t) * claims_len);
+    if(claims == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct view_t line;
+    while(input_next_line(&reader, &line)) {
+        struct claim_t claim;
+        if(build_claim(line, &claim)) {
+            fprintf(stderr, "Unexpected input: %.*s\n", (int)line.len, line.ptr);
+            exit(1);
+        }
+
+        add_claim(&fabric, claim);
+
+        if(claims_index >= claims_len) {
+            claims_len = claims_len * 2;
+            claims = (struct claim_t *)realloc(claims, sizeof(struct claim_t) * claims_len);
+            if(claims == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        claims[claims_index] = claim;
+        claims_index++;
+    }
+
+    input_release(&reader);
+
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    int fabric_inches = find_overlapping_fabric_inches(&fabric);
+    answer_printf(&answer->part1, "%d", fabric_inches);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    long int non_overlapping_id = find_non_overlapping_id(&fabric, claims, claims_index);
+    answer_printf(&answer->part2, "%ld", non_overlapping_id);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    grid_release(&fabric);
+    free(claims);
+
+    return 0;
+}
+
+/*
+ * Each claim is cut out of the fabric as it arrives, so part 1 is one pass
+ * over the fabric once the input ends. The claims are kept for part 2.
+ */
+static int solve_stream(FILE *input, struct aoc_answer_t *answer)
+{
+    struct grid_t fabric;
+    grid_init(&fabric, FABRIC_DIM, FABRIC_DIM, 0, sizeof(int));
+
+    struct stream_t stream;
+    stream_open(&stream, input, sizeof(struct claim_t), parse_claim);
+
+    int claims_len = BUFF_LEN;
+    int claims_index = 0;
+    struct claim_t *claims = (struct claim_t *)malloc(sizeof(struct claim_t) * claims_len);
+    if(claims == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    const struct claim_t *claim;
+    while((claim = (const struct claim_t *)stream_next(&stream)) != NULL) {
+        add_claim(&fabric, *claim);
+
+        if(claims_index >= claims_len) {
+            claims_len = claims_len * 2;
+            claims = (struct claim_t *)realloc(claims, sizeof(struct claim_t) * claims_len);
+            if(claims == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        claims[claims_index] = *claim;
+        claims_index++;
+    }
+
+    stream_close(&stream);
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    int fabric_inches = find_overlapping_fabric_inches(&fabric);
+    answer_printf(&answer->part1, "%d", fabric_inches);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    long int non_overlapping_id = find_non_overlapping_id(&fabric, claims, claims_index);
+    answer_printf(&answer->part2, "%ld", non_overlapping_id);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    grid_release(&fabric);
+    free(claims);
+
+    return 0;
+}
+
+/*
+ * A claim reads "#<id> @ <y>,<x>: <height>x<width>"; only its five numbers
+ * are checked.
+ */
+static int build_claim(struct view_t line, struct claim_t *claim)
+{
+    int32_t fields[6];
+    if(scan_int32(line.ptr, line.len, fields, 6) != 5) {
+        return 1;
+    }
+
+    for(int i = 1; i < 5; i++) {
+        if(fields[i] < 0) {
+            return 1;
+        }
+    }
+
+    claim->claim_id = fields[0];
+    claim->pos_y = fields[1];
+    claim->pos_x = fields[2];
+    claim->dim_y = fields[3];
+    claim->dim_x = fields[4];
+
+    return 0;
+}
+
+static int parse_claim(struct view_t line, void *record)
+{
+    return build_claim(line, (struct claim_t *)record);
+}
+
+static void add_claim(struct grid_t *fabric, struct claim_t claim)
+{
+    for(long int i = claim.pos_y; (i < (claim.pos_y + claim.dim_y)) && (i < FABRIC_DIM); i++) {
+        int *row = GRID_ROW(fabric, int, i);
+
+        for(long int j = claim.pos_x; (j < (claim.pos_x + claim.dim_x)) && (j < FABRIC_DIM); j++) {
+            row[j] = row[j] + 1;
+        }
+    }
+}
+
+static int find_overlapping_fabric_inches(const struct grid_t *fabric)
+{
+    int fabric_inches = 0;
+    for(long int i = 0; i < FABRIC_DIM; i++) {
+        const int *row = GRID_ROW(fabric, int, i);
+
+        for(long int j = 0; j < FABRIC_DIM; j++) {
+            if(row[j] >= 2) {
+                fabric_inches++;
+            }
+        }
+    }
+
+    return fabric_inches;
+}
+
+static long int find_non_overlapping_id(const struct grid_t *fabric, struct claim_t *claims, int claims_len)
+{
+    for(int claim_index = 0; claim_index < claims_len; claim_index++) {
+        struct claim_t claim = claims[claim_index];
+
+        if(!claim_overlaps(fabric, claim)) {
+            return claim.claim_id;
+        }
+
+    }
+
+    return -1;
+}
+
+static int claim_overlaps(const struct grid_t *fabric, struct claim_t claim)
+{
+    for(long int i = claim.pos_y; (i < (claim.pos_y + claim.dim_y)) && (i < FABRIC_DIM); i++) {
+        const int *row = GRID_ROW(fabric, int, i);
+
+        for(long int j = claim.pos_x; (j < (claim.pos_x + claim.dim_x)) && (j < FABRIC_DIM); j++) {
+            if(row[j] != 1) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+const struct aoc_solver_t day3_solver = {.name = "day3", .solve = solve, .solve_stream = solve_stream};
@@ -0,0 +1,8 @@
+#ifndef AOC_DAY4_H
+#define AOC_DAY4_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day4_solver;
+
+#endif //AOC_DAY4_H
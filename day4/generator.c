@@ -0,0 +1,217 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gen.h"
+
+#define BASE_SHIFTS 300
+#define MIN_GUARDS 16
+#define MAX_GUARDS 32
+#define MAX_NAPS 3
+#define LINE_LEN 64
+
+/*
+ * Room for any year snprintf() could be handed, not just four digits.
+ */
+#define DATE_LEN 32
+
+struct shift_t {
+    int guard;
+    int naps;
+    int sleep[MAX_NAPS];
+    int wake[MAX_NAPS];
+};
+
+static int pick_best_guard(struct shift_t shifts[], long int shifts_len, int guards_len, int *best_min);
+static void format_date(long int day, char buffer[], size_t buff_len);
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    int guards_len = (int)rng_range(&rng, MIN_GUARDS, MAX_GUARDS);
+    int guard_ids[MAX_GUARDS];
+    for(int i = 0; i < guards_len; i++) {
+        int unique;
+        do {
+            guard_ids[i] = (int)rng_range(&rng, 10, 3499);
+            unique = 1;
+            for(int j = 0; j < i; j++) {
+                if(guard_ids[j] == guard_ids[i]) {
+                    unique = 0;
+                }
+            }
+        } while(!unique);
+    }
+
+    long int shifts_len = BASE_SHIFTS * (long int)args.scale;
+    long int shifts_cap = shifts_len + 64;
+    struct shift_t *shifts = (struct shift_t *)malloc(sizeof(struct shift_t) * shifts_cap);
+    if(shifts == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(long int i = 0; i < shifts_len; i++) {
+        shifts[i].guard = (int)rng_range(&rng, 0, guards_len - 1);
+        shifts[i].naps = (int)rng_range(&rng, 0, MAX_NAPS);
+
+        int points[MAX_NAPS * 2];
+        for(int j = 0; j < shifts[i].naps * 2; j++) {
+            int unique;
+            do {
+                points[j] = (int)rng_range(&rng, 0, 59);
+                unique = 1;
+                for(int k = 0; k < j; k++) {
+                    if(points[k] == points[j]) {
+                        unique = 0;
+                    }
+                }
+            } while(!unique);
+        }
+
+        for(int j = 1; j < shifts[i].naps * 2; j++) {
+            for(int k = j; k > 0 && points[k - 1] > points[k]; k--) {
+                int tmp = points[k];
+                points[k] = points[k - 1];
+                points[k - 1] = tmp;
+            }
+        }
+
+        for(int j = 0; j < shifts[i].naps; j++) {
+            shifts[i].sleep[j] = points[j * 2];
+            shifts[i].wake[j] = points[j * 2 + 1];
+        }
+    }
+
+    /*
+     * The first strategy has no answer if the sleepiest guard is tied with
+     * another, or sleeps the most on more than one minute. Break ties with
+     * short extra naps until both are unique.
+     */
+    int best_min = 0;
+    int best_guard;
+    while((best_guard = pick_best_guard(shifts, shifts_len, guards_len, &best_min)) < 0) {
+        if(shifts_len >= shifts_cap) {
+            shifts_cap += 64;
+            shifts = (struct shift_t *)realloc(shifts, sizeof(struct shift_t) * shifts_cap);
+            if(shifts == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        int nap_min = best_min < 59 ? best_min : 58;
+        struct shift_t extra = {.guard = -best_guard - 1, .naps = 1, .sleep = {nap_min}, .wake = {nap_min + 1}};
+        shifts[shifts_len] = extra;
+        shifts_len++;
+    }
+
+    long int lines_len = 0;
+    for(long int i = 0; i < shifts_len; i++) {
+        lines_len += 1 + shifts[i].naps * 2;
+    }
+
+    char (*lines)[LINE_LEN] = malloc(sizeof(*lines) * lines_len);
+    if(lines == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    long int line_index = 0;
+    char date[DATE_LEN];
+    for(long int i = 0; i < shifts_len; i++) {
+        int first_nap = shifts[i].naps ? shifts[i].sleep[0] : 60;
+        if(first_nap == 0 || rng_chance(&rng, 75)) {
+            format_date(i - 1, date, sizeof(date));
+            snprintf(lines[line_index++], LINE_LEN, "[%s 23:%02ld] Guard #%d begins shift", date, rng_range(&rng, 45, 59), guard_ids[shifts[i].guard]);
+        } else {
+            format_date(i, date, sizeof(date));
+            snprintf(lines[line_index++], LINE_LEN, "[%s 00:%02ld] Guard #%d begins shift", date, rng_range(&rng, 0, first_nap - 1 < 3 ? first_nap - 1 : 3), guard_ids[shifts[i].guard]);
+        }
+
+        format_date(i, date, sizeof(date));
+        for(int j = 0; j < shifts[i].naps; j++) {
+            snprintf(lines[line_index++], LINE_LEN, "[%s 00:%02d] falls asleep", date, shifts[i].sleep[j]);
+            snprintf(lines[line_index++], LINE_LEN, "[%s 00:%02d] wakes up", date, shifts[i].wake[j]);
+        }
+    }
+
+    rng_shuffle(&rng, lines, lines_len, sizeof(*lines));
+
+    for(long int i = 0; i < lines_len; i++) {
+        fprintf(args.out, "%s\n", lines[i]);
+    }
+
+    free(lines);
+    free(shifts);
+    gen_close(&args);
+
+    return 0;
+}
+
+/*
+ * Returns the index of the sleepiest guard and stores their most slept
+ * minute, or returns -(index + 1) if either is tied.
+ */
+static int pick_best_guard(struct shift_t shifts[], long int shifts_len, int guards_len, int *best_min)
+{
+    long int totals[MAX_GUARDS] = {0};
+    long int minutes[MAX_GUARDS][60];
+    memset(minutes, 0, sizeof(minutes));
+
+    for(long int i = 0; i < shifts_len; i++) {
+        for(int j = 0; j < shifts[i].naps; j++) {
+            for(int min = shifts[i].sleep[j]; min < shifts[i].wake[j]; min++) {
+                minutes[shifts[i].guard][min]++;
+                totals[shifts[i].guard]++;
+            }
+        }
+    }
+
+    int best = 0;
+    int tied = 0;
+    for(int i = 1; i < guards_len; i++) {
+        if(totals[i] > totals[best]) {
+            best = i;
+            tied = 0;
+        } else if(totals[i] == totals[best]) {
+            tied = 1;
+        }
+    }
+
+    int min_tied = 0;
+    *best_min = 0;
+    for(int min = 1; min < 60; min++) {
+        if(minutes[best][min] > minutes[best][*best_min]) {
+            *best_min = min;
+            min_tied = 0;
+        } else if(minutes[best][min] == minutes[best][*best_min]) {
+            min_tied = 1;
+        }
+    }
+
+    return (tied || min_tied) ? -best - 1 : best;
+}
+
+static void format_date(long int day, char buffer[], size_t buff_len)
+{
+    const int month_days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    long int year = 1518 + day / 365;
+    long int day_of_year = day % 365;
+    if(day_of_year < 0) {
+        year--;
+        day_of_year += 365;
+    }
+
+    int month = 0;
+    while(day_of_year >= month_days[month]) {
+        day_of_year -= month_days[month];
+        month++;
+    }
+
+    snprintf(buffer, buff_len, "%04ld-%02d-%02ld", year, month + 1, day_of_year + 1);
+}
@@ -0,0 +1,448 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "arena.h"
+#include "hashmap.h"
+#include "input.h"
+#include "day4.h"
+
+#define MOST_MIN_ASLEEP_STRATEGY 0
+#define MOST_FREQ_ASLEEP_SAME_MIN_STRATEGY 1
+
+#define BUFF_LEN 64
+
+struct instant_t {
+    unsigned int year;
+    unsigned int month: 4;
+    unsigned int day: 5;
+    unsigned int hour: 5;
+    unsigned int min: 6;
+};
+
+struct entry_t {
+    unsigned int guard_id;
+    struct instant_t instant;
+    unsigned int shift_begin: 1;
+    unsigned int sleep: 1;
+    unsigned int wake: 1;
+};
+
+struct list_node_t {
+    struct entry_t data;
+    struct list_node_t *next;
+};
+
+struct list_t {
+    struct list_node_t *head;
+    int len;
+};
+
+struct guard_info_t {
+    unsigned int guard_id;
+    unsigned int sleep_mins[60];
+    unsigned int candidate_min: 6;
+};
+
+static int build_entry_from_str(struct view_t line, struct entry_t *entry);
+static int insert_entry_into_list_sorted(struct list_t *list, struct list_node_t *node);
+static int entry_cmp(struct entry_t entry_a, struct entry_t entry_b);
+static struct guard_info_t determine_candidate_guard(struct list_t *entry_list, int strategy);
+static struct guard_info_t most_frequently_asleep_guard(struct guard_info_t *guard_info, int guard_info_len);
+static struct guard_info_t most_frequently_asleep_same_min_guard(struct guard_info_t *guard_info, int guard_info_len);
+static struct guard_info_t *update_guard_info(struct guard_info_t *guard_info, struct entry_t asleep, struct entry_t awake);
+static int instant_cmp(struct instant_t instant_a, struct instant_t instant_b);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct arena_t arena;
+    arena_init(&arena, 0);
+
+    struct list_t entry_list;
+    struct list_node_t *node;
+    entry_list.head = NULL;
+    entry_list.len = 0;
+    struct view_t line;
+    while(input_next_line(&reader, &line)) {
+        struct entry_t entry;
+        if(build_entry_from_str(line, &entry)) {
+            fprintf(stderr, "Unexpected input: %.*s\n", (int)line.len, line.ptr);
+            exit(1);
+        }
+
+        node = ARENA_NEW(&arena, struct list_node_t);
+        node->data = entry;
+        node->next = NULL;
+        insert_entry_into_list_sorted(&entry_list, node);
+    }
+
+    input_release(&reader);
+
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    struct guard_info_t candidate_guard = determine_candidate_guard(&entry_list, MOST_MIN_ASLEEP_STRATEGY);
+    answer_printf(&answer->part1, "%d (%d * %d)", candidate_guard.guard_id * candidate_guard.candidate_min,
+                  candidate_guard.guard_id, candidate_guard.candidate_min);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    candidate_guard = determine_candidate_guard(&entry_list, MOST_FREQ_ASLEEP_SAME_MIN_STRATEGY);
+    answer_printf(&answer->part2, "%d (%d * %d)", candidate_guard.guard_id * candidate_guard.candidate_min,
+                  candidate_guard.guard_id, candidate_guard.candidate_min);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    arena_release(&arena);
+
+    return 0;
+}
+
+static int build_entry_from_str(struct view_t line, struct entry_t *entry)
+{
+    long int year, month, day, hour, min;
+
+    if(view_expect(&line, "[") || view_parse_long(&line, &year)) {
+        return 1;
+    }
+
+    if(view_expect(&line, "-") || view_parse_long(&line, &month)) {
+        return 1;
+    }
+
+    if(view_expect(&line, "-") || view_parse_long(&line, &day)) {
+        return 1;
+    }
+
+    if(view_expect(&line, " ") || view_parse_long(&line, &hour)) {
+        return 1;
+    }
+
+    if(view_expect(&line, ":") || view_parse_long(&line, &min) || view_expect(&line, "] ")) {
+        return 1;
+    }
+
+    entry->instant.year = (unsigned int)year;
+    entry->instant.month = (unsigned int)month;
+    entry->instant.day = (unsigned int)day;
+    entry->instant.hour = (unsigned int)hour;
+    entry->instant.min = (unsigned int)min;
+
+    entry->guard_id = 0;
+    entry->shift_begin = 0;
+    entry->sleep = 0;
+    entry->wake = 0;
+
+    if(!view_expect(&line, "Guard #")) {
+        long int guard_id;
+        if(view_parse_long(&line, &guard_id)) {
+            return 1;
+        }
+
+        entry->guard_id = (unsigned int)guard_id;
+        entry->shift_begin = 1;
+    } else if(!view_expect(&line, "falls asleep")) {
+        entry->sleep = 1;
+    } else if(!view_expect(&line, "wakes up")) {
+        entry->wake = 1;
+    } else {
+        return 1;
+    }
+
+    return 0;
+}
+
+static int insert_entry_into_list_sorted(struct list_t *list, struct list_node_t *node)
+{
+    struct list_node_t *next = list->head;
+    list->len = list->len + 1;
+
+    if(next == NULL) {
+        list->head = node;
+        return list->len;
+    }
+
+    struct entry_t insert_entry = node->data;
+    struct entry_t next_entry = next->data;
+    if(entry_cmp(insert_entry, next_entry) < 0) {
+        list->head = node;
+        node->next = next;
+        return list->len;
+    }
+
+    while(next->next != NULL) {
+        next_entry = next->next->data;
+
+        if(entry_cmp(insert_entry, next_entry) < 0) {
+            node->next = next->next;
+            next->next = node;
+            return list->len;
+        }
+
+        next = next->next;
+    }
+
+    next->next = node;
+    return list->len;
+}
+
+static struct guard_info_t determine_candidate_guard(struct list_t *entry_list, int strategy)
+{
+    int guard_info_len = BUFF_LEN;
+    struct guard_info_t *guard_info = (struct guard_info_t *)malloc(sizeof(struct guard_info_t) * guard_info_len);
+    if(guard_info == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct hashmap_t guard_indices;
+    hashmap_init(&guard_indices, BUFF_LEN);
+
+    int guard_info_index = 0;
+    struct list_node_t *node = entry_list->head;
+    struct guard_info_t *guard = NULL;
+    while(node != NULL) {
+        struct entry_t entry = node->data;
+        if(entry.wake) {
+            fprintf(stderr, "Unexpected error: Out of order entry list\n");
+            exit(1);
+        }
+
+        if(entry.sleep && guard == NULL) {
+            fprintf(stderr, "Unexpected error: Out of order entry list\n");
+            exit(1);
+        }
+
+        if(entry.shift_begin) {
+            uint64_t *index = hashmap_get(&guard_indices, entry.guard_id);
+            if(index != NULL) {
+                guard = guard_info + *index;
+            } else {
+                struct guard_info_t new_guard_info;
+                new_guard_info.guard_id = entry.guard_id;
+                memset(new_guard_info.sleep_mins, 0, sizeof(int) * 60);
+
+                if(guard_info_index >= guard_info_len) {
+                    guard_info_len = guard_info_len + BUFF_LEN;
+                    guard_info = (struct guard_info_t *)realloc(guard_info, sizeof(struct guard_info_t) * guard_info_len);
+                    if(guard_info == NULL) {
+                        perror("Fatal error: Cannot allocate memory.\n");
+                        exit(EXIT_FAILURE);
+                    }
+                }
+
+                guard_info[guard_info_index] = new_guard_info;
+                hashmap_put(&guard_indices, entry.guard_id, (uint64_t)guard_info_index);
+                guard_info_index++;
+
+                guard = guard_info + guard_info_index - 1;
+            }
+        } else if(entry.sleep) {
+            struct list_node_t *sleep_node = node;
+            node = node->next;
+
+            if(node == NULL) {
+                fprintf(stderr, "Unexpected error: Unexpected end of entry list\n");
+                exit(1);
+            }
+
+            if(!node->data.wake) {
+                fprintf(stderr, "Unexpected error: Out of order entry list\n");
+                exit(1);
+            }
+
+            update_guard_info(guard, sleep_node->data, node->data);
+        }
+
+        node = node->next;
+    }
+
+    struct guard_info_t candidate_guard;
+    if(strategy == MOST_MIN_ASLEEP_STRATEGY) {
+        candidate_guard = most_frequently_asleep_guard(guard_info, guard_info_index);
+    } else {
+        candidate_guard = most_frequently_asleep_same_min_guard(guard_info, guard_info_index);
+    }
+
+    free(guard_info);
+    hashmap_release(&guard_indices);
+
+    return candidate_guard;
+}
+
+static struct guard_info_t most_frequently_asleep_guard(struct guard_info_t *guard_info, int guard_info_len)
+{
+    struct guard_info_t *guard = NULL;
+    for(int i = 0; i < guard_info_len; i++) {
+        if(guard == NULL) {
+            guard = guard_info + i;
+        } else {
+            int best_guard_mins_tot = 0;
+            int curr_guard_mins_tot = 0;
+
+            for(int j = 0; j < 60; j++) {
+                best_guard_mins_tot += guard->sleep_mins[j];
+                curr_guard_mins_tot += guard_info[i].sleep_mins[j];
+            }
+
+            if(curr_guard_mins_tot > best_guard_mins_tot) {
+                guard = guard_info + i;
+            }
+        }
+    }
+
+    if(guard == NULL) {
+        fprintf(stderr, "Unexpected error: Could not determine best guard\n");
+        exit(1);
+    }
+
+    struct guard_info_t candidate_guard;
+    candidate_guard.guard_id = guard->guard_id;
+    memcpy(candidate_guard.sleep_mins, guard->sleep_mins, 60 * sizeof(int));
+
+    unsigned int likely_min_index = 0;
+    unsigned int duplicate_min_index = 0;
+    for(unsigned int i = 1; i < 60; i++) {
+        if(candidate_guard.sleep_mins[i] > candidate_guard.sleep_mins[likely_min_index]) {
+            likely_min_index = i;
+            duplicate_min_index = 0;
+        } else if(candidate_guard.sleep_mins[i] == candidate_guard.sleep_mins[likely_min_index]) {
+            duplicate_min_index = 1;
+        }
+    }
+
+    if(duplicate_min_index) {
+        fprintf(stderr, "Unexpected error: Could not determine best guard\n");
+        exit(1);
+    }
+
+    candidate_guard.candidate_min = likely_min_index;
+
+    return candidate_guard;
+}
+
+static struct guard_info_t most_frequently_asleep_same_min_guard(struct guard_info_t *guard_info, int guard_info_len)
+{
+    struct guard_info_t **leading_sleep_freqs = (struct guard_info_t **)malloc(sizeof(struct guard_info_t *) * 60);
+    if(leading_sleep_freqs == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(int i = 0; i < 60; i++) {
+        leading_sleep_freqs[i] = NULL;
+    }
+
+    for(int guard_info_index = 0; guard_info_index < guard_info_len; guard_info_index++) {
+        struct guard_info_t *current_guard = guard_info + guard_info_index;
+
+        for(int i = 0; i < 60; i++) {
+            if(leading_sleep_freqs[i] == NULL || current_guard->sleep_mins[i] > leading_sleep_freqs[i]->sleep_mins[i]) {
+                leading_sleep_freqs[i] = current_guard;
+            }
+        }
+    }
+
+    struct guard_info_t *current_best_guard = NULL;
+    unsigned int current_best_min = 0;
+    for(unsigned int i = 0; i < 60; i++) {
+        if(current_best_guard == NULL || leading_sleep_freqs[i]->sleep_mins[i] > current_best_guard->sleep_mins[current_best_min]) {
+            current_best_guard = leading_sleep_freqs[i];
+            current_best_min = i;
+        }
+    }
+
+    if(current_best_guard == NULL) {
+        fprintf(stderr, "Unexpected error: Could not determine best guard\n");
+        exit(1);
+    }
+
+    struct guard_info_t candidate_guard;
+    candidate_guard.guard_id = current_best_guard->guard_id;
+    memcpy(candidate_guard.sleep_mins, current_best_guard->sleep_mins, 60 * sizeof(int));
+    candidate_guard.candidate_min = current_best_min;
+
+    free(leading_sleep_freqs);
+
+    return candidate_guard;
+}
+
+static struct guard_info_t *update_guard_info(struct guard_info_t *guard_info, struct entry_t asleep, struct entry_t awake)
+{
+    const int month_days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    struct instant_t current = asleep.instant;
+    while(instant_cmp(current, awake.instant) < 0) {
+        guard_info->sleep_mins[current.min] = guard_info->sleep_mins[current.min] + 1;
+
+        if(current.min < 59) {
+            current.min = current.min + 1;
+            continue;
+        }
+
+        current.min = 0;
+        if(current.hour < 23) {
+            current.hour = current.hour + 1;
+            continue;
+        }
+
+        current.hour = 0;
+        if(current.day < month_days[current.month - 1]) {
+            current.day = current.day + 1;
+            continue;
+        }
+
+        current.day = 1;
+        if(current.month < 12) {
+            current.month = current.month + 1;
+            continue;
+        }
+
+        current.month = 1;
+        current.year = current.year + 1;
+    }
+
+    return guard_info;
+}
+
+static int entry_cmp(struct entry_t entry_a, struct entry_t entry_b)
+{
+    return instant_cmp(entry_a.instant, entry_b.instant);
+}
+
+static int instant_cmp(struct instant_t instant_a, struct instant_t instant_b)
+{
+    if(instant_a.year > instant_b.year) {
+        return 1;
+    } else if(instant_a.year < instant_b.year) {
+        return -1;
+    }
+
+    if(instant_a.month > instant_b.month) {
+        return 1;
+    } else if(instant_a.month < instant_b.month) {
+        return -1;
+    }
+
+    if(instant_a.day > instant_b.day) {
+        return 1;
+    } else if(instant_a.day < instant_b.day) {
+        return -1;
+    }
+
+    if(instant_a.hour > instant_b.hour) {
+        return 1;
+    } else if(instant_a.hour < instant_b.hour) {
+        return -1;
+    }
+
+    if(instant_a.min > instant_b.min) {
+        return 1;
+    } else if(instant_a.min < instant_b.min) {
+        return -1;
+    }
+
+    return 0;
+}
+
+const struct aoc_solver_t day4_solver = {.name = "day4", .solve = solve, .version = 1};
@@ -0,0 +1,14 @@
+#ifndef AOC_DAY5_H
+#define AOC_DAY5_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day5_solver;
+
+/*
+ * A plain, slow solver for the same puzzle, which aoc_verify checks
+ * day5_solver against (see verify/verify.c).
+ */
+extern const struct aoc_solver_t day5_reference;
+
+#endif //AOC_DAY5_H
@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#include "gen.h"
+
+#define BASE_UNITS 50000
+#define REACT_PERCENT 40
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    long int units_len = BASE_UNITS * (long int)args.scale;
+    char *stack = (char *)malloc(sizeof(char) * units_len);
+    if(stack == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /*
+     * Units are emitted against a stack of those not yet reacted: popping
+     * emits the opposite polarity of the top unit, so reactions nest the way
+     * they do in real puzzle input rather than only between neighbours.
+     */
+    long int stack_len = 0;
+    for(long int i = 0; i < units_len; i++) {
+        char unit;
+        if(stack_len > 0 && rng_chance(&rng, REACT_PERCENT)) {
+            char top = stack[--stack_len];
+            unit = (char)(isupper(top) ? tolower(top) : toupper(top));
+        } else {
+            unit = (char)('a' + rng_range(&rng, 0, 25));
+            if(rng_chance(&rng, 50)) {
+                unit = (char)toupper(unit);
+            }
+
+            stack[stack_len++] = unit;
+        }
+
+        fputc(unit, args.out);
+    }
+
+    free(stack);
+    gen_close(&args);
+
+    return 0;
+}
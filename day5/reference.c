@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "input.h"
+#include "day5.h"
+
+#define UNITS 26
+
+static size_t react(const char *units, size_t units_len, char removed, char *stack);
+
+/*
+ * The plain version of the puzzle, kept to check the solver's kernels against
+ * (see verify/): units are pushed one at a time onto a stack that pops on a
+ * reaction, and for part 2 each unit type is removed from the polymer as
+ * scanned, not from the reacted one.
+ */
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct view_t line;
+    if(!input_next_line(&reader, &line)) {
+        fprintf(stderr, "Unexpected input: end of input or error occurred\n");
+        exit(1);
+    }
+
+    char *stack = (char *)malloc(sizeof(char) * (line.len > 0 ? line.len : 1));
+    if(stack == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    answer_printf(&answer->part1, "%zu", react(line.ptr, line.len, 0, stack));
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    size_t best_len = line.len;
+    for(char unit = 'a'; unit < 'a' + UNITS; unit++) {
+        size_t len = react(line.ptr, line.len, unit, stack);
+        if(len < best_len) {
+            best_len = len;
+        }
+    }
+
+    answer_printf(&answer->part2, "%zu", best_len);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    free(stack);
+    input_release(&reader);
+
+    return 0;
+}
+
+/*
+ * Units of the removed type, in either case, are skipped. Anything that is
+ * not a letter never reacts.
+ */
+static size_t react(const char *units, size_t units_len, char removed, char *stack)
+{
+    size_t stack_len = 0;
+
+    for(size_t i = 0; i < units_len; i++) {
+        char unit = units[i];
+        if(removed && (unit == removed || unit == removed - 'a' + 'A')) {
+            continue;
+        }
+
+        char top = stack_len > 0 ? stack[stack_len - 1] : 0;
+        int letters = ((unit >= 'a' && unit <= 'z') || (unit >= 'A' && unit <= 'Z'));
+        if(stack_len > 0 && letters && unit != top && (unit | 0x20) == (top | 0x20)) {
+            stack_len--;
+        } else {
+            stack[stack_len++] = unit;
+        }
+    }
+
+    return stack_len;
+}
+
+const struct aoc_solver_t day5_reference = {.name = "day5", .solve = solve};
@@ -0,0 +1,372 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "input.h"
+#include "parallel.h"
+#include "stream.h"
+#include "day5.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+#define UNITS 26
+#define STACK_LEN 4096
+
+/*
+ * Reacts units_len units onto a stack already holding stack_len fully
+ * reacted units and returns how many it holds after. The stack must have
+ * room for stack_len + units_len units, and must not overlap the units.
+ */
+typedef size_t (*react_t)(char *stack, size_t stack_len, const char *units, size_t units_len);
+
+struct polymer_t {
+    const char *units;
+    size_t units_len;
+    react_t react;
+};
+
+static react_t select_react(void);
+static size_t react_scalar(char *stack, size_t stack_len, const char *units, size_t units_len);
+#ifdef CPU_X86
+CPU_TARGET_SSE42 static size_t react_sse42(char *stack, size_t stack_len, const char *units, size_t units_len);
+CPU_TARGET_AVX2 static size_t react_avx2(char *stack, size_t stack_len, const char *units, size_t units_len);
+CPU_TARGET_AVX512 static size_t react_avx512(char *stack, size_t stack_len, const char *units, size_t units_len);
+#endif
+static int units_react(char unit_a, char unit_b);
+static size_t shortest_polymer(const char *units, size_t units_len, react_t react);
+static void shortest_without_units(void *ctx, size_t begin, size_t end, void *acc);
+static void keep_shortest(void *ctx, void *acc, const void *other);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct view_t line;
+    if(!input_next_line(&reader, &line)) {
+        fprintf(stderr, "Unexpected input: end of input or error occurred\n");
+        exit(1);
+    }
+
+    react_t react = select_react();
+
+    char *polymer = (char *)malloc(sizeof(char) * (line.len > 0 ? line.len : 1));
+    if(polymer == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    size_t polymer_len = react(polymer, 0, line.ptr, line.len);
+    answer_printf(&answer->part1, "%zu", polymer_len);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    answer_printf(&answer->part2, "%zu", shortest_polymer(polymer, polymer_len, react));
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    free(polymer);
+    input_release(&reader);
+
+    return 0;
+}
+
+/*
+ * Units are reacted on a stack as they arrive, a chunk at a time, so the
+ * stack always holds the fully reacted polymer read so far, and the input
+ * itself is never kept.
+ */
+static int solve_stream(FILE *input, struct aoc_answer_t *answer)
+{
+    struct stream_t stream;
+    stream_open(&stream, input, 0, NULL);
+
+    react_t react = select_react();
+
+    size_t stack_len = STACK_LEN;
+    char *stack = (char *)malloc(sizeof(char) * stack_len);
+    if(stack == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t units_len = 0;
+    int line_read = 0;
+    int input_read = 0;
+    const struct stream_chunk_t *chunk;
+    while((chunk = (const struct stream_chunk_t *)stream_next(&stream)) != NULL && !line_read) {
+        input_read = 1;
+
+        size_t chunk_len = 0;
+        while(chunk_len < chunk->len && chunk->data[chunk_len] != '\n' && chunk->data[chunk_len] != '\r') {
+            chunk_len++;
+        }
+        line_read = chunk_len < chunk->len;
+
+        if(units_len + chunk_len > stack_len) {
+            while(units_len + chunk_len > stack_len) {
+                stack_len *= 2;
+            }
+
+            stack = (char *)realloc(stack, sizeof(char) * stack_len);
+            if(stack == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        units_len = react(stack, units_len, chunk->data, chunk_len);
+    }
+
+    stream_close(&stream);
+
+    if(!input_read) {
+        fprintf(stderr, "Unexpected input: end of input or error occurred\n");
+        exit(1);
+    }
+
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    answer_printf(&answer->part1, "%zu", units_len);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    answer_printf(&answer->part2, "%zu", shortest_polymer(stack, units_len, react));
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    free(stack);
+
+    return 0;
+}
+
+static react_t select_react(void)
+{
+#ifdef CPU_X86
+    switch(cpu_tier()) {
+        case CPU_TIER_AVX512:
+            return react_avx512;
+        case CPU_TIER_AVX2:
+            return react_avx2;
+        case CPU_TIER_SSE42:
+            return react_sse42;
+        default:
+            break;
+    }
+#endif
+
+    return react_scalar;
+}
+
+/*
+ * Each unit either reacts with the unit on top of the stack or is pushed.
+ */
+static size_t react_scalar(char *stack, size_t stack_len, const char *units, size_t units_len)
+{
+    for(size_t i = 0; i < units_len; i++) {
+        if(stack_len > 0 && units_react(stack[stack_len - 1], units[i])) {
+            stack_len--;
+        } else {
+            stack[stack_len++] = units[i];
+        }
+    }
+
+    return stack_len;
+}
+
+#ifdef CPU_X86
+/*
+ * The vector versions compare a block of units with the block one unit
+ * further on, which marks every unit that reacts with the one after it.
+ * Every unit before the first such pair is pushed as the block is stored
+ * whole, and the pair itself is skipped; only units meeting the top of the
+ * stack, and the last block's worth, go one at a time. Nothing past the
+ * pushed units is ever written beyond what the stack has room for, because
+ * the stack grows no faster than the units are read.
+ */
+CPU_TARGET_SSE42 static size_t react_sse42(char *stack, size_t stack_len, const char *units, size_t units_len)
+{
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    const __m128i first_letter = _mm_set1_epi8('a');
+    const __m128i last_letter = _mm_set1_epi8('z' - 'a');
+
+    size_t i = 0;
+    while(i < units_len) {
+        if(stack_len > 0 && units_react(stack[stack_len - 1], units[i])) {
+            stack_len--;
+            i++;
+            continue;
+        }
+
+        if(i + 16 >= units_len) {
+            stack[stack_len++] = units[i++];
+            continue;
+        }
+
+        __m128i a = _mm_loadu_si128((const __m128i *)(units + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(units + i + 1));
+        __m128i letters = _mm_sub_epi8(_mm_or_si128(a, case_bit), first_letter);
+        __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letters, last_letter), letters);
+        __m128i pairs = _mm_and_si128(_mm_cmpeq_epi8(_mm_xor_si128(a, b), case_bit), is_letter);
+
+        _mm_storeu_si128((__m128i *)(stack + stack_len), a);
+
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(pairs);
+        if(mask == 0) {
+            stack_len += 16;
+            i += 16;
+        } else {
+            size_t pair = (size_t)__builtin_ctz(mask);
+            stack_len += pair;
+            i += pair + 2;
+        }
+    }
+
+    return stack_len;
+}
+
+CPU_TARGET_AVX2 static size_t react_avx2(char *stack, size_t stack_len, const char *units, size_t units_len)
+{
+    const __m256i case_bit = _mm256_set1_epi8(0x20);
+    const __m256i first_letter = _mm256_set1_epi8('a');
+    const __m256i last_letter = _mm256_set1_epi8('z' - 'a');
+
+    size_t i = 0;
+    while(i < units_len) {
+        if(stack_len > 0 && units_react(stack[stack_len - 1], units[i])) {
+            stack_len--;
+            i++;
+            continue;
+        }
+
+        if(i + 32 >= units_len) {
+            stack[stack_len++] = units[i++];
+            continue;
+        }
+
+        __m256i a = _mm256_loadu_si256((const __m256i *)(units + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(units + i + 1));
+        __m256i letters = _mm256_sub_epi8(_mm256_or_si256(a, case_bit), first_letter);
+        __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letters, last_letter), letters);
+        __m256i pairs = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_xor_si256(a, b), case_bit), is_letter);
+
+        _mm256_storeu_si256((__m256i *)(stack + stack_len), a);
+
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(pairs);
+        if(mask == 0) {
+            stack_len += 32;
+            i += 32;
+        } else {
+            size_t pair = (size_t)__builtin_ctz(mask);
+            stack_len += pair;
+            i += pair + 2;
+        }
+    }
+
+    return stack_len;
+}
+
+CPU_TARGET_AVX512 static size_t react_avx512(char *stack, size_t stack_len, const char *units, size_t units_len)
+{
+    const __m512i case_bit = _mm512_set1_epi8(0x20);
+    const __m512i first_letter = _mm512_set1_epi8('a');
+    const __m512i last_letter = _mm512_set1_epi8('z' - 'a');
+
+    size_t i = 0;
+    while(i < units_len) {
+        if(stack_len > 0 && units_react(stack[stack_len - 1], units[i])) {
+            stack_len--;
+            i++;
+            continue;
+        }
+
+        if(i + 64 >= units_len) {
+            stack[stack_len++] = units[i++];
+            continue;
+        }
+
+        __m512i a = _mm512_loadu_si512((const void *)(units + i));
+        __m512i b = _mm512_loadu_si512((const void *)(units + i + 1));
+        __m512i letters = _mm512_sub_epi8(_mm512_or_si512(a, case_bit), first_letter);
+        __mmask64 pairs = _mm512_cmpeq_epi8_mask(_mm512_xor_si512(a, b), case_bit) &
+                          _mm512_cmple_epu8_mask(letters, last_letter);
+
+        _mm512_storeu_si512((void *)(stack + stack_len), a);
+
+        if(pairs == 0) {
+            stack_len += 64;
+            i += 64;
+        } else {
+            size_t pair = (size_t)__builtin_ctzll(pairs);
+            stack_len += pair;
+            i += pair + 2;
+        }
+    }
+
+    return stack_len;
+}
+#endif
+
+/*
+ * Two units react when they are the same letter in opposite cases.
+ */
+static int units_react(char unit_a, char unit_b)
+{
+    return (unit_a ^ unit_b) == 0x20 && (unsigned char)((unit_a | 0x20) - 'a') <= 'z' - 'a';
+}
+
+/*
+ * Reactions do not depend on the order they happen in, so removing a unit
+ * type from the reacted polymer and reacting again gives the same length as
+ * removing it from the original one.
+ */
+static size_t shortest_polymer(const char *units, size_t units_len, react_t react)
+{
+    struct polymer_t polymer = {.units = units, .units_len = units_len, .react = react};
+
+    size_t best_len = units_len;
+    parallel_reduce(0, UNITS, 1, shortest_without_units, keep_shortest, &polymer, &best_len, sizeof(best_len));
+
+    return best_len;
+}
+
+/*
+ * Reacts the polymer once without each unit type in [begin, end), and keeps
+ * the shortest result in acc.
+ */
+static void shortest_without_units(void *ctx, size_t begin, size_t end, void *acc)
+{
+    const struct polymer_t *polymer = (const struct polymer_t *)ctx;
+    size_t *best_len = (size_t *)acc;
+
+    char *variant = (char *)parallel_scratch(sizeof(char) * (2 * polymer->units_len + 1));
+    char *stack = variant + polymer->units_len;
+
+    for(size_t unit = begin; unit < end; unit++) {
+        char upper = (char)('A' + unit);
+        char lower = (char)('a' + unit);
+
+        size_t variant_len = 0;
+        for(size_t i = 0; i < polymer->units_len; i++) {
+            if(polymer->units[i] != upper && polymer->units[i] != lower) {
+                variant[variant_len++] = polymer->units[i];
+            }
+        }
+
+        size_t curr_len = polymer->react(stack, 0, variant, variant_len);
+        if(curr_len < *best_len) {
+            *best_len = curr_len;
+        }
+    }
+}
+
+static void keep_shortest(void *ctx, void *acc, const void *other)
+{
+    (void)ctx;
+
+    if(*(const size_t *)other < *(size_t *)acc) {
+        *(size_t *)acc = *(const size_t *)other;
+    }
+}
+
+const struct aoc_solver_t day5_solver = {.name = "day5", .solve = solve, .solve_stream = solve_stream};
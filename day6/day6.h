@@ -0,0 +1,14 @@
+#ifndef AOC_DAY6_H
+#define AOC_DAY6_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day6_solver;
+
+/*
+ * A plain, slow solver for the same puzzle, which aoc_verify checks
+ * day6_solver against (see verify/verify.c).
+ */
+extern const struct aoc_solver_t day6_reference;
+
+#endif //AOC_DAY6_H
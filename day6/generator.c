@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gen.h"
+
+#define BASE_COORDS 50
+#define BASE_SPAN 320
+#define OUTLIERS 8
+#define REGION_MAX_DIST 10000
+#define MARGIN 40
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    long int coords_len = BASE_COORDS * (long int)args.scale;
+
+    /*
+     * The area grows with the number of coordinates so the density, and with
+     * it the work per coordinate, stays close to the real input.
+     */
+    long int span = BASE_SPAN;
+    while(span * span < (long int)BASE_SPAN * BASE_SPAN * (long int)args.scale) {
+        span++;
+    }
+
+    /*
+     * Part 2 looks for locations less than REGION_MAX_DIST away from all the
+     * coordinates together, which the whole square would put out of reach
+     * beyond the real input's size. So only OUTLIERS coordinates spread over
+     * it, and the rest sit in a square around its centre, sized so that on
+     * average (half a side from the centre) the sum stays at 4/5 of the
+     * limit. For the real input's size that is the whole square; by about
+     * 10 times it the centre square is full, no region can exist, and
+     * part 2 is 0.
+     */
+    long int core_len = coords_len > OUTLIERS ? coords_len - OUTLIERS : 0;
+    long int budget = REGION_MAX_DIST * 4 / 5 - (coords_len - core_len) * span / 2;
+    long int core = core_len > 0 && budget > 0 ? 2 * budget / core_len : 0;
+    while(core * core < 2 * core_len) {
+        core++;
+    }
+    if(core > span) {
+        core = span;
+    }
+
+    unsigned char *taken = (unsigned char *)calloc((size_t)(span * span + 7) / 8, sizeof(unsigned char));
+    if(taken == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(long int i = 0; i < coords_len; i++) {
+        long int side = i < core_len ? core : span;
+        long int x, y, bit;
+        do {
+            x = (span - side) / 2 + rng_range(&rng, 0, side - 1);
+            y = (span - side) / 2 + rng_range(&rng, 0, side - 1);
+            bit = y * span + x;
+        } while(taken[bit / 8] & (1 << (bit % 8)));
+
+        taken[bit / 8] |= (unsigned char)(1 << (bit % 8));
+        fprintf(args.out, "%ld, %ld\n", x + MARGIN, y + MARGIN);
+    }
+
+    free(taken);
+    gen_close(&args);
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "input.h"
+#include "day6.h"
+
+#define BUFF_LEN 32
+#define REGION_MAX_DIST 10000
+#define MAX_COORD 10000
+#define NO_POINT (-1)
+
+struct coord_t {
+    long int x;
+    long int y;
+};
+
+struct bounds_t {
+    long int lower_x;
+    long int upper_x;
+    long int lower_y;
+    long int upper_y;
+};
+
+static struct bounds_t find_bounds(const struct coord_t coords[], int coords_len);
+static int closest_point(const struct coord_t coords[], int coords_len, long int x, long int y);
+static long int distance(struct coord_t coord, long int x, long int y);
+
+/*
+ * The plain version of the puzzle, kept to check the solver's growing areas
+ * against (see verify/): every cell of the bounding box is given to its
+ * closest point by measuring the distance to all of them, and a point that
+ * owns a cell on the edge of the box owns cells past it, so its area is
+ * infinite. The region of part 2 is counted within the box, as the solver
+ * does.
+ */
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    int coords_len = BUFF_LEN;
+    int coords_index = 0;
+    struct coord_t *coords = (struct coord_t *)malloc(sizeof(struct coord_t) * coords_len);
+    if(coords == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct view_t line;
+    while(input_next_line(&reader, &line)) {
+        if(coords_index >= coords_len) {
+            coords_len = coords_len * 2;
+            coords = (struct coord_t *)realloc(coords, sizeof(struct coord_t) * coords_len);
+            if(coords == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        struct coord_t *coord = coords + coords_index;
+        if(view_parse_long(&line, &coord->x) || view_expect(&line, ", ") || view_parse_long(&line, &coord->y) ||
+           line.len != 0 || coord->x < 0 || coord->x >= MAX_COORD || coord->y < 0 || coord->y >= MAX_COORD) {
+            fprintf(stderr, "Unexpected input: %.*s\n", (int)line.len, line.ptr);
+            exit(1);
+        }
+
+        coords_index++;
+    }
+
+    input_release(&reader);
+
+    if(coords_index == 0) {
+        fprintf(stderr, "Unexpected input: no coordinates\n");
+        exit(1);
+    }
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    struct bounds_t bounds = find_bounds(coords, coords_index);
+    int *areas = (int *)calloc(coords_index, sizeof(int));
+    if(areas == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(long int y = bounds.lower_y; y <= bounds.upper_y; y++) {
+        for(long int x = bounds.lower_x; x <= bounds.upper_x; x++) {
+            int owner = closest_point(coords, coords_index, x, y);
+            if(owner == NO_POINT || areas[owner] < 0) {
+                continue;
+            }
+
+            if(x == bounds.lower_x || x == bounds.upper_x || y == bounds.lower_y || y == bounds.upper_y) {
+                areas[owner] = -1;
+            } else {
+                areas[owner]++;
+            }
+        }
+    }
+
+    int largest_area = -1;
+    for(int i = 0; i < coords_index; i++) {
+        if(areas[i] > largest_area) {
+            largest_area = areas[i];
+        }
+    }
+
+    free(areas);
+
+    if(largest_area < 0) {
+        fprintf(stderr, "Unexpected error: could not determine largest area.\n");
+        exit(1);
+    }
+
+    answer_printf(&answer->part1, "%d", largest_area);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    int region_size = 0;
+    for(long int y = bounds.lower_y; y <= bounds.upper_y; y++) {
+        for(long int x = bounds.lower_x; x <= bounds.upper_x; x++) {
+            long int total = 0;
+            for(int i = 0; i < coords_index; i++) {
+                total += distance(coords[i], x, y);
+            }
+
+            if(total < REGION_MAX_DIST) {
+                region_size++;
+            }
+        }
+    }
+
+    answer_printf(&answer->part2, "%d", region_size);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    free(coords);
+
+    return 0;
+}
+
+static struct bounds_t find_bounds(const struct coord_t coords[], int coords_len)
+{
+    struct bounds_t bounds = {coords[0].x, coords[0].x, coords[0].y, coords[0].y};
+
+    for(int i = 1; i < coords_len; i++) {
+        bounds.lower_x = coords[i].x < bounds.lower_x ? coords[i].x : bounds.lower_x;
+        bounds.upper_x = coords[i].x > bounds.upper_x ? coords[i].x : bounds.upper_x;
+        bounds.lower_y = coords[i].y < bounds.lower_y ? coords[i].y : bounds.lower_y;
+        bounds.upper_y = coords[i].y > bounds.upper_y ? coords[i].y : bounds.upper_y;
+    }
+
+    return bounds;
+}
+
+/*
+ * NO_POINT when the closest distance is shared by two or more points.
+ */
+static int closest_point(const struct coord_t coords[], int coords_len, long int x, long int y)
+{
+    int closest = NO_POINT;
+    long int closest_dist = -1;
+
+    for(int i = 0; i < coords_len; i++) {
+        long int dist = distance(coords[i], x, y);
+        if(closest_dist < 0 || dist < closest_dist) {
+            closest = i;
+            closest_dist = dist;
+        } else if(dist == closest_dist) {
+            closest = NO_POINT;
+        }
+    }
+
+    return closest;
+}
+
+static long int distance(struct coord_t coord, long int x, long int y)
+{
+    return labs(coord.x - x) + labs(coord.y - y);
+}
+
+const struct aoc_solver_t day6_reference = {.name = "day6", .solve = solve};
@@ -0,0 +1,498 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "arena.h"
+#include "hashmap.h"
+#include "input.h"
+#include "parallel.h"
+#include "scan.h"
+#include "day6.h"
+
+#define BUFF_LEN 16
+#define REGION_MAX_DIST 10000
+#define ROWS_GRAIN 4
+
+struct coord_t {
+    int x;
+    int y;
+};
+
+struct list_node_t {
+    struct coord_t data;
+    struct list_node_t *next;
+};
+
+struct voronoi_point_t {
+    struct coord_t coord;
+    struct list_node_t *boundary_coords;
+    struct list_node_t *candidate_boundary_coords;
+    int point_area_size;
+    unsigned int inf: 1;
+};
+
+/*
+ * The cells of the current boundaries and of the next ones, each mapped to
+ * the index of the point it belongs to, and the cells found to be as close to
+ * two points, which belong to neither. The contentious cells of the current
+ * round and of the next one are also listed, to spread the tie (see
+ * spread_ties()).
+ */
+struct voronoi_cells_t {
+    struct hashmap_t boundaries;
+    struct hashmap_t candidates;
+    struct hashset_t contentious;
+    struct list_node_t *ties;
+    struct list_node_t *candidate_ties;
+};
+
+struct grid_bounds_t {
+    int lower_x;
+    int upper_x;
+    int lower_y;
+    int upper_y;
+};
+
+struct region_t {
+    const struct coord_t *coords;
+    int coords_len;
+    struct grid_bounds_t bounds;
+};
+
+static int build_coord_from_input(struct view_t line, struct coord_t *coord);
+static int determine_largest_area(struct coord_t coords[], int coords_len);
+static int compute_point_areas(struct voronoi_point_t points[], int points_len, struct grid_bounds_t bounds, struct pool_t *nodes);
+static int grow_area(struct grid_bounds_t bounds, struct voronoi_point_t points[],
+        struct voronoi_point_t *focus, struct voronoi_cells_t *cells, struct pool_t *nodes);
+static int grow_cell(struct grid_bounds_t bounds, struct voronoi_point_t points[],
+        struct voronoi_point_t *focus, struct voronoi_cells_t *cells, struct coord_t new_boundary_coord,
+        struct pool_t *nodes);
+static void spread_ties(struct grid_bounds_t bounds, const struct voronoi_point_t points[], int points_len,
+        int distance, struct voronoi_cells_t *cells, struct pool_t *nodes);
+static void add_tie(struct voronoi_cells_t *cells, struct coord_t coord, struct pool_t *nodes);
+static struct list_node_t *drop_contentious_cells(struct list_node_t *head, const struct hashset_t *contentious,
+        struct pool_t *nodes);
+static struct grid_bounds_t determine_global_boundaries(struct coord_t coords[], int coords_len);
+static int determine_region_size(struct coord_t coords[], int coords_len);
+static void count_region_rows(void *ctx, size_t begin, size_t end, void *acc);
+static void add_counts(void *ctx, void *acc, const void *other);
+static int is_coord_outside_boundaries(struct coord_t coord, struct grid_bounds_t bounds);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    int coords_len = BUFF_LEN * 2;
+    int coords_index = 0;
+    struct coord_t *coords = (struct coord_t *)malloc(sizeof(struct coord_t) * coords_len);
+    if(coords == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct view_t line;
+    while(input_next_line(&reader, &line)) {
+        if(coords_index >= coords_len) {
+            coords_len = coords_len * 2;
+            coords = (struct coord_t *)realloc(coords, sizeof(struct coord_t) * coords_len);
+            if(coords == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if(build_coord_from_input(line, coords + coords_index)) {
+            fprintf(stderr, "Unexpected input: %.*s\n", (int)line.len, line.ptr);
+            exit(1);
+        }
+
+        coords_index++;
+    }
+
+    input_release(&reader);
+
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    int largest_area = determine_largest_area(coords, coords_index);
+    if(largest_area == -1) {
+        fprintf(stderr, "Unexpected error: could not determine largest area.\n");
+        exit(1);
+    }
+
+    answer_printf(&answer->part1, "%d", largest_area);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    int region_size = determine_region_size(coords, coords_index);
+    answer_printf(&answer->part2, "%d", region_size);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    free(coords);
+
+    return 0;
+}
+
+static int build_coord_from_input(struct view_t line, struct coord_t *coord)
+{
+    int32_t fields[3];
+    if(scan_int32(line.ptr, line.len, fields, 3) != 2) {
+        return 1;
+    }
+
+    coord->x = fields[0];
+    coord->y = fields[1];
+
+    return 0;
+}
+
+static int determine_largest_area(struct coord_t coords[], int coords_len)
+{
+    struct voronoi_point_t *points = (struct voronoi_point_t *)malloc(sizeof(struct voronoi_point_t) * coords_len);
+    if(points == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct pool_t nodes;
+    POOL_INIT(&nodes, struct list_node_t, 1024);
+
+    for(int i = 0; i < coords_len; i++) {
+        struct list_node_t *node = POOL_NEW(&nodes, struct list_node_t);
+        node->data = coords[i];
+        node->next = NULL;
+
+        struct voronoi_point_t point_info = {
+            .coord = coords[i],
+            .boundary_coords = node,
+            .candidate_boundary_coords = NULL,
+            .point_area_size = 1,
+            .inf = 0
+        };
+
+        points[i] = point_info;
+    }
+
+    struct grid_bounds_t bounds = determine_global_boundaries(coords, coords_len);
+    compute_point_areas(points, coords_len, bounds, &nodes);
+    pool_release(&nodes);
+
+    int largest_area = -1;
+    for(int i = 0; i < coords_len; i++) {
+        if(!points[i].inf && points[i].point_area_size > largest_area) {
+            largest_area = points[i].point_area_size;
+        }
+    }
+
+    free(points);
+
+    return largest_area;
+}
+
+static int compute_point_areas(struct voronoi_point_t points[], int points_len, struct grid_bounds_t bounds, struct pool_t *nodes)
+{
+    struct voronoi_cells_t cells;
+    hashmap_init(&cells.boundaries, (size_t)points_len * BUFF_LEN);
+    hashmap_init(&cells.candidates, (size_t)points_len * BUFF_LEN);
+    hashset_init(&cells.contentious, (size_t)points_len * BUFF_LEN);
+    cells.ties = NULL;
+    cells.candidate_ties = NULL;
+
+    for(int i = 0; i < points_len; i++) {
+        hashmap_put(&cells.boundaries, HASHMAP_KEY2(points[i].coord.x, points[i].coord.y), (uint64_t)i);
+    }
+
+    int still_growing = 1;
+    for(int distance = 1; still_growing; distance++) {
+        still_growing = 0;
+
+        spread_ties(bounds, points, points_len, distance, &cells, nodes);
+
+        for(int i = 0; i < points_len; i++) {
+            if(grow_area(bounds, points, points + i, &cells, nodes)) {
+                still_growing = 1;
+            }
+        }
+
+        for(int i = 0; i < points_len; i++) {
+            struct list_node_t *next = points[i].boundary_coords;
+            while(next != NULL) {
+                struct list_node_t *tmp = next->next;
+                pool_free(nodes, next);
+                next = tmp;
+            }
+
+            points[i].boundary_coords = drop_contentious_cells(points[i].candidate_boundary_coords,
+                                                               &cells.contentious, nodes);
+            points[i].candidate_boundary_coords = NULL;
+        }
+
+        struct hashmap_t tmp = cells.boundaries;
+        cells.boundaries = cells.candidates;
+        cells.candidates = tmp;
+        hashmap_clear(&cells.candidates);
+
+        while(cells.ties != NULL) {
+            struct list_node_t *next = cells.ties->next;
+            pool_free(nodes, cells.ties);
+            cells.ties = next;
+        }
+        cells.ties = cells.candidate_ties;
+        cells.candidate_ties = NULL;
+    }
+
+    for(int i = 0; i < points_len; i++) {
+        points[i].boundary_coords = NULL;
+    }
+
+    hashmap_release(&cells.boundaries);
+    hashmap_release(&cells.candidates);
+    hashset_release(&cells.contentious);
+
+    return 1;
+}
+
+static int grow_area(struct grid_bounds_t bounds, struct voronoi_point_t points[],
+        struct voronoi_point_t *focus, struct voronoi_cells_t *cells, struct pool_t *nodes)
+{
+    int still_growing = 0;
+
+    struct list_node_t *next = focus->boundary_coords;
+    while(next != NULL) {
+        struct coord_t boundary_coord = next->data;
+        struct coord_t focus_coord = focus->coord;
+
+        if(boundary_coord.x <= focus_coord.x) {
+            struct coord_t new_boundary_coord = {.x = boundary_coord.x - 1, .y = boundary_coord.y};
+            if(grow_cell(bounds, points, focus, cells, new_boundary_coord, nodes)) {
+                still_growing = 1;
+            }
+        }
+
+        if(boundary_coord.x >= focus_coord.x) {
+            struct coord_t new_boundary_coord = {.x = boundary_coord.x + 1, .y = boundary_coord.y};
+            if(grow_cell(bounds, points, focus, cells, new_boundary_coord, nodes)) {
+                still_growing = 1;
+            }
+        }
+
+        if(boundary_coord.x == focus_coord.x && boundary_coord.y >= focus_coord.y) {
+            struct coord_t new_boundary_coord = {.x = boundary_coord.x, .y = boundary_coord.y + 1};
+            if(grow_cell(bounds, points, focus, cells, new_boundary_coord, nodes)) {
+                still_growing = 1;
+            }
+        }
+
+        if(boundary_coord.x == focus_coord.x && boundary_coord.y <= focus_coord.y) {
+            struct coord_t new_boundary_coord = {.x = boundary_coord.x, .y = boundary_coord.y - 1};
+            if(grow_cell(bounds, points, focus, cells, new_boundary_coord, nodes)) {
+                still_growing = 1;
+            }
+        }
+
+        next = next->next;
+    }
+
+    return still_growing;
+}
+
+/*
+ * A cell already on another point's boundary is closer to that point. One
+ * that another point reached in this same round is as close to both, so it
+ * is taken back from that point and marked contentious; its node is dropped
+ * from the point's list at the end of the round.
+ */
+static int grow_cell(struct grid_bounds_t bounds, struct voronoi_point_t points[],
+        struct voronoi_point_t *focus, struct voronoi_cells_t *cells, struct coord_t new_boundary_coord,
+        struct pool_t *nodes)
+{
+    uint64_t key = HASHMAP_KEY2(new_boundary_coord.x, new_boundary_coord.y);
+    uint64_t focus_index = (uint64_t)(focus - points);
+
+    uint64_t *owner = hashmap_get(&cells->boundaries, key);
+    if(owner != NULL && *owner != focus_index) {
+        return 0;
+    }
+
+    if(hashset_contains(&cells->contentious, key)) {
+        return 0;
+    }
+
+    owner = hashmap_get(&cells->candidates, key);
+    if(owner != NULL && *owner != focus_index) {
+        struct voronoi_point_t *parent = points + *owner;
+        parent->point_area_size = parent->point_area_size - 1;
+
+        hashmap_remove(&cells->candidates, key);
+        add_tie(cells, new_boundary_coord, nodes);
+
+        return 0;
+    }
+
+    if(is_coord_outside_boundaries(new_boundary_coord, bounds)) {
+        focus->inf = 1;
+        return 0;
+    }
+
+    struct list_node_t *new_boundary_node = POOL_NEW(nodes, struct list_node_t);
+
+    new_boundary_node->data = new_boundary_coord;
+    new_boundary_node->next = focus->candidate_boundary_coords;
+    focus->candidate_boundary_coords = new_boundary_node;
+    focus->point_area_size = focus->point_area_size + 1;
+
+    hashmap_put(&cells->candidates, key, focus_index);
+
+    return 1;
+}
+
+/*
+ * A point's area only stops where another point's area meets it, so a tie
+ * between two points that then stop growing would leave the cells behind it
+ * to a third point that is no closer. Those cells are as close to the tied
+ * points, which is settled for each neighbour of the last round's ties from
+ * its distance to every point, before any area grows into it this round.
+ */
+static void spread_ties(struct grid_bounds_t bounds, const struct voronoi_point_t points[], int points_len,
+        int distance, struct voronoi_cells_t *cells, struct pool_t *nodes)
+{
+    static const int dx[] = {-1, 1, 0, 0};
+    static const int dy[] = {0, 0, -1, 1};
+
+    for(const struct list_node_t *tie = cells->ties; tie != NULL; tie = tie->next) {
+        for(int d = 0; d < 4; d++) {
+            struct coord_t neighbour = {.x = tie->data.x + dx[d], .y = tie->data.y + dy[d]};
+            if(is_coord_outside_boundaries(neighbour, bounds) ||
+               hashset_contains(&cells->contentious, HASHMAP_KEY2(neighbour.x, neighbour.y))) {
+                continue;
+            }
+
+            int closest = 0;
+            for(int i = 0; i < points_len; i++) {
+                int dist = abs(neighbour.x - points[i].coord.x) + abs(neighbour.y - points[i].coord.y);
+                if(dist < distance) {
+                    closest = 0;
+                    break;
+                }
+
+                closest += dist == distance;
+            }
+
+            if(closest >= 2) {
+                add_tie(cells, neighbour, nodes);
+            }
+        }
+    }
+}
+
+static void add_tie(struct voronoi_cells_t *cells, struct coord_t coord, struct pool_t *nodes)
+{
+    hashset_add(&cells->contentious, HASHMAP_KEY2(coord.x, coord.y));
+
+    struct list_node_t *node = POOL_NEW(nodes, struct list_node_t);
+    node->data = coord;
+    node->next = cells->candidate_ties;
+    cells->candidate_ties = node;
+}
+
+static struct list_node_t *drop_contentious_cells(struct list_node_t *head, const struct hashset_t *contentious,
+        struct pool_t *nodes)
+{
+    struct list_node_t **link = &head;
+    while(*link != NULL) {
+        struct list_node_t *node = *link;
+        if(hashset_contains(contentious, HASHMAP_KEY2(node->data.x, node->data.y))) {
+            *link = node->next;
+            pool_free(nodes, node);
+        } else {
+            link = &node->next;
+        }
+    }
+
+    return head;
+}
+
+static int determine_region_size(struct coord_t coords[], int coords_len)
+{
+    struct region_t region = {
+        .coords = coords,
+        .coords_len = coords_len,
+        .bounds = determine_global_boundaries(coords, coords_len)
+    };
+
+    int region_size = 0;
+    size_t rows = (size_t)(region.bounds.upper_y - region.bounds.lower_y + 1);
+    parallel_reduce(0, rows, ROWS_GRAIN, count_region_rows, add_counts, &region, &region_size, sizeof(region_size));
+
+    return region_size;
+}
+
+/*
+ * Counts the cells of rows [begin, end) of the bounding box whose total
+ * distance to every coordinate is below the limit.
+ */
+static void count_region_rows(void *ctx, size_t begin, size_t end, void *acc)
+{
+    const struct region_t *region = (const struct region_t *)ctx;
+    int *region_size = (int *)acc;
+
+    for(size_t row = begin; row < end; row++) {
+        int y = region->bounds.lower_y + (int)row;
+
+        for(int x = region->bounds.lower_x; x <= region->bounds.upper_x; x++) {
+            int dist_to_other_points = 0;
+
+            for(int i = 0; i < region->coords_len; i++) {
+                dist_to_other_points += abs(x - region->coords[i].x) + abs(y - region->coords[i].y);
+            }
+
+            if(dist_to_other_points < REGION_MAX_DIST) {
+                (*region_size)++;
+            }
+        }
+    }
+}
+
+static void add_counts(void *ctx, void *acc, const void *other)
+{
+    (void)ctx;
+
+    *(int *)acc += *(const int *)other;
+}
+
+static struct grid_bounds_t determine_global_boundaries(struct coord_t coords[], int coords_len)
+{
+    struct grid_bounds_t bounds = {
+        .lower_x = coords[0].x,
+        .upper_x = coords[0].x,
+        .lower_y = coords[0].y,
+        .upper_y = coords[0].y
+    };
+
+    for(int i = 0; i < coords_len; i++) {
+        if(coords[i].x < bounds.lower_x) {
+            bounds.lower_x = coords[i].x;
+        }
+
+        if(coords[i].x > bounds.upper_x) {
+            bounds.upper_x =coords[i].x;
+        }
+
+        if(coords[i].y < bounds.lower_y) {
+            bounds.lower_y = coords[i].y;
+        }
+
+        if(coords[i].y > bounds.upper_y) {
+            bounds.upper_y = coords[i].y;
+        }
+    }
+
+    return bounds;
+}
+
+static int is_coord_outside_boundaries(struct coord_t coord, struct grid_bounds_t bounds)
+{
+    return coord.x < bounds.lower_x || coord.x > bounds.upper_x || coord.y < bounds.lower_y || coord.y > bounds.upper_y;
+}
+
+const struct aoc_solver_t day6_solver = {.name = "day6", .solve = solve, .version = 1};
@@ -0,0 +1,8 @@
+#ifndef AOC_DAY7_H
+#define AOC_DAY7_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day7_solver;
+
+#endif //AOC_DAY7_H
@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gen.h"
+
+#define BASE_EDGES 100
+#define BASE_STEPS 26
+
+static const char step_ids[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!#$%&()*+-/:;<=>?@[]^_{|}~";
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    /*
+     * Steps are single characters, so the graph can only grow up to the
+     * printable characters; past that, more edges mean duplicate edges.
+     */
+    int steps_len = (int)sizeof(step_ids) - 1;
+    if((unsigned long int)steps_len > BASE_STEPS * args.scale) {
+        steps_len = BASE_STEPS * (int)args.scale;
+    }
+
+    long int edges_len = BASE_EDGES * (long int)args.scale;
+    long int unique_edges = (long int)steps_len * (steps_len - 1) / 2;
+
+    char order[sizeof(step_ids)];
+    memcpy(order, step_ids, steps_len);
+    rng_shuffle(&rng, order, steps_len, sizeof(char));
+
+    unsigned char *present = (unsigned char *)calloc((size_t)steps_len * steps_len, sizeof(unsigned char));
+    long int *edges = (long int *)malloc(sizeof(long int) * edges_len);
+    if(present == NULL || edges == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /*
+     * Edges always point forward in a random topological order, so the graph
+     * is acyclic. Every step first gets a dependency on some earlier step so
+     * that all of them appear in the input.
+     */
+    long int edges_index = 0;
+    for(int to = 1; to < steps_len && edges_index < edges_len; to++) {
+        int from = (int)rng_range(&rng, 0, to - 1);
+        present[from * steps_len + to] = 1;
+        edges[edges_index++] = from * steps_len + to;
+    }
+
+    while(edges_index < edges_len) {
+        int from = (int)rng_range(&rng, 0, steps_len - 2);
+        int to = (int)rng_range(&rng, from + 1, steps_len - 1);
+
+        if(present[from * steps_len + to] && edges_index < unique_edges) {
+            continue;
+        }
+
+        present[from * steps_len + to] = 1;
+        edges[edges_index++] = from * steps_len + to;
+    }
+
+    rng_shuffle(&rng, edges, edges_len, sizeof(long int));
+
+    for(long int i = 0; i < edges_len; i++) {
+        fprintf(args.out, "Step %c must be finished before step %c can begin.\n", order[edges[i] / steps_len], order[edges[i] % steps_len]);
+    }
+
+    free(edges);
+    free(present);
+    gen_close(&args);
+
+    return 0;
+}
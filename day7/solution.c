@@ -0,0 +1,379 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "hashmap.h"
+#include "input.h"
+#include "day7.h"
+
+#define BUFF_LEN 64
+#define WORKERS 5
+#define BASE_SEC 60
+
+struct simple_dep_t {
+    char id;
+    char depends;
+};
+
+struct dep_graph_node_t {
+    char id;
+    unsigned int complete: 1;
+    struct dep_list_node_t *dependencies;
+};
+
+struct dep_list_node_t {
+    struct dep_graph_node_t *dependency;
+    struct dep_list_node_t *next;
+};
+
+struct worker_t {
+    struct dep_graph_node_t *job;
+    int timer;
+    int completion_time;
+};
+
+static int build_dependency_node(struct view_t line, struct simple_dep_t *node);
+static int build_dependency_graph(struct simple_dep_t *steps, int steps_len, struct dep_graph_node_t **nodes_addr[], struct arena_t *arena);
+static void reset_dependency_graph_nodes(struct dep_graph_node_t *nodes[], int nodes_len);
+static void release_dependency_graph_resources(struct dep_graph_node_t *nodes[], struct arena_t *arena);
+static int populate_buffer_with_order(struct dep_graph_node_t *nodes[], int nodes_len, char *buffer, int buffer_len);
+static struct dep_graph_node_t *find_next_node_with_satisfied_deps(struct dep_graph_node_t *nodes[], int nodes_len);
+static int determine_completion_length(struct dep_graph_node_t *nodes[], int nodes_len);
+static struct dep_graph_node_t *find_next_free_node_with_satisfied_deps(struct dep_graph_node_t *nodes[], int nodes_len, struct worker_t workers[], int workers_len);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    int steps_len = BUFF_LEN;
+    struct simple_dep_t *steps = (struct simple_dep_t *)malloc(sizeof(struct simple_dep_t) * steps_len);
+    if(steps == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int steps_index = 0;
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct view_t line;
+    while(input_next_line(&reader, &line)) {
+        if(steps_index >= steps_len) {
+            steps_len = steps_len * 2;
+            steps = (struct simple_dep_t *)realloc(steps, sizeof(struct simple_dep_t) * steps_len);
+            if(steps == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if(build_dependency_node(line, &steps[steps_index])) {
+            fprintf(stderr, "Unexpected input: %.*s\n", (int)line.len, line.ptr);
+            exit(1);
+        }
+        steps_index++;
+    }
+
+    input_release(&reader);
+
+    steps_len = steps_index;
+
+    struct arena_t arena;
+    arena_init(&arena, 0);
+
+    struct dep_graph_node_t **nodes = NULL;
+    int nodes_len = build_dependency_graph(steps, steps_len, &nodes, &arena);
+    free(steps);
+
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    char *order = (char *)malloc(sizeof(char) * steps_len);
+    if(order == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int steps_count = populate_buffer_with_order(nodes, nodes_len, order, steps_len);
+    if(steps_count == 0) {
+        fprintf(stderr, "Unexpected error occurred: cannot resolve dependencies.\n");
+        exit(1);
+    }
+
+    answer_printf(&answer->part1, "%.*s", steps_count, order);
+    answer_lap(answer, AOC_PHASE_PART1);
+    free(order);
+
+    reset_dependency_graph_nodes(nodes, nodes_len);
+    int seconds_to_complete = determine_completion_length(nodes, nodes_len);
+    answer_printf(&answer->part2, "%d", seconds_to_complete);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    release_dependency_graph_resources(nodes, &arena);
+
+    return 0;
+}
+
+static int build_dependency_node(struct view_t line, struct simple_dep_t *node)
+{
+    if(view_expect(&line, "Step ") || line.len < 1) {
+        return 1;
+    }
+
+    node->depends = line.ptr[0];
+    line.ptr++;
+    line.len--;
+
+    if(view_expect(&line, " must be finished before step ") || line.len < 1) {
+        return 1;
+    }
+
+    node->id = line.ptr[0];
+    line.ptr++;
+    line.len--;
+
+    return view_expect(&line, " can begin.");
+}
+
+static int build_dependency_graph(struct simple_dep_t *steps, int steps_len, struct dep_graph_node_t **nodes_addr[], struct arena_t *arena)
+{
+    int nodes_len = BUFF_LEN;
+    int node_index = 0;
+
+    struct dep_graph_node_t **nodes = (struct dep_graph_node_t **)malloc(sizeof(struct dep_graph_node_t *) * nodes_len);
+    if(nodes == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct hashmap_t nodes_by_id;
+    hashmap_init(&nodes_by_id, BUFF_LEN);
+
+    for(int i = 0; i < steps_len; i++) {
+        uint64_t *found = hashmap_get(&nodes_by_id, (uint64_t)(unsigned char)steps[i].id);
+        struct dep_graph_node_t *node = found != NULL ? (struct dep_graph_node_t *)(uintptr_t)*found : NULL;
+
+        if(node == NULL) {
+            if(node_index >= nodes_len) {
+                nodes_len += BUFF_LEN;
+                nodes = (struct dep_graph_node_t **)realloc(nodes, sizeof(struct dep_graph_node_t *) * nodes_len);
+                if(nodes == NULL) {
+                    perror("Fatal error: Cannot allocate memory.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+
+
+            struct dep_graph_node_t *new_node = ARENA_NEW(arena, struct dep_graph_node_t);
+
+            new_node->id = steps[i].id;
+            new_node->dependencies = NULL;
+            new_node->complete = 0;
+
+            nodes[node_index] = new_node;
+            node = new_node;
+            node_index++;
+
+            hashmap_put(&nodes_by_id, (uint64_t)(unsigned char)new_node->id, (uint64_t)(uintptr_t)new_node);
+        }
+
+        found = hashmap_get(&nodes_by_id, (uint64_t)(unsigned char)steps[i].depends);
+        struct dep_graph_node_t *dep = found != NULL ? (struct dep_graph_node_t *)(uintptr_t)*found : NULL;
+
+        if(dep == NULL) {
+            if(node_index >= nodes_len) {
+                nodes_len += BUFF_LEN;
+                nodes = (struct dep_graph_node_t **)realloc(nodes, sizeof(struct dep_graph_node_t *) * nodes_len);
+                if(nodes == NULL) {
+                    perror("Fatal error: Cannot allocate memory.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+
+            struct dep_graph_node_t *new_node = ARENA_NEW(arena, struct dep_graph_node_t);
+
+            new_node->id = steps[i].depends;
+            new_node->dependencies = NULL;
+            new_node->complete = 0;
+
+            nodes[node_index] = new_node;
+            dep = new_node;
+            node_index++;
+
+            hashmap_put(&nodes_by_id, (uint64_t)(unsigned char)new_node->id, (uint64_t)(uintptr_t)new_node);
+        }
+
+        struct dep_list_node_t *new_list_node = ARENA_NEW(arena, struct dep_list_node_t);
+
+        new_list_node->next = node->dependencies;
+        new_list_node->dependency = dep;
+        node->dependencies = new_list_node;
+    }
+
+    hashmap_release(&nodes_by_id);
+
+    nodes_len = node_index;
+    nodes = (struct dep_graph_node_t **)realloc(nodes, sizeof(struct dep_graph_node_t *) * nodes_len);
+    if(nodes == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    *nodes_addr = nodes;
+    return nodes_len;
+}
+
+static void reset_dependency_graph_nodes(struct dep_graph_node_t *nodes[], int nodes_len)
+{
+    for(int i = 0; i < nodes_len; i++) {
+        nodes[i]->complete = 0;
+    }
+}
+
+static void release_dependency_graph_resources(struct dep_graph_node_t *nodes[], struct arena_t *arena)
+{
+    free(nodes);
+    arena_release(arena);
+}
+
+static int populate_buffer_with_order(struct dep_graph_node_t *nodes[], int nodes_len, char *buffer, int buffer_len)
+{
+    int buff_index = 0;
+
+    memset(buffer, 0, buffer_len);
+
+    struct dep_graph_node_t *node = NULL;
+    while((node = find_next_node_with_satisfied_deps(nodes, nodes_len)) != NULL) {
+        if(buff_index >= buffer_len) {
+            return 0;
+        }
+
+        buffer[buff_index] = node->id;
+        node->complete = 1;
+        buff_index++;
+    }
+
+    return buff_index;
+}
+
+static struct dep_graph_node_t *find_next_node_with_satisfied_deps(struct dep_graph_node_t *nodes[], int nodes_len)
+{
+    struct dep_graph_node_t *best = NULL;
+    for(int i = 0; i < nodes_len; i++) {
+        struct dep_graph_node_t *current = nodes[i];
+
+        if(current->complete) {
+            continue;
+        }
+
+        int all_satisfied = 1;
+        struct dep_list_node_t *dep = current->dependencies;
+        while(dep != NULL) {
+            if(!dep->dependency->complete) {
+                all_satisfied = 0;
+                break;
+            }
+
+            dep = dep->next;
+        }
+
+        if(all_satisfied && (best == NULL || current->id < best->id)) {
+            best = current;
+        }
+    }
+
+    return best;
+}
+
+static int determine_completion_length(struct dep_graph_node_t *nodes[], int nodes_len)
+{
+    struct worker_t workers[WORKERS];
+    for(int i = 0; i < WORKERS; i++) {
+        workers[i].completion_time = 0;
+        workers[i].timer = 0;
+        workers[i].job = NULL;
+    }
+
+    int time_count = 0;
+    int steps_complete = 0;
+    while(!steps_complete) {
+        for(int i = 0; i < WORKERS; i++) {
+            if(workers[i].job != NULL) {
+                if(workers[i].timer == workers[i].completion_time) {
+                    workers[i].job->complete = 1;
+                    workers[i].completion_time = 0;
+                    workers[i].timer = 0;
+                    workers[i].job = NULL;
+                } else {
+                    workers[i].timer++;
+                }
+            }
+        }
+
+        for(int i = 0; i < WORKERS; i++) {
+            if(workers[i].job == NULL) {
+                struct dep_graph_node_t *new_job = find_next_free_node_with_satisfied_deps(nodes, nodes_len, workers, WORKERS);
+                if(new_job != NULL) {
+                    workers[i].job = new_job;
+                    workers[i].timer = 1;
+                    workers[i].completion_time = BASE_SEC + (new_job->id) - 65 + 1;
+                }
+            }
+        }
+
+        int workers_working = 0;
+        for(int i = 0; i < WORKERS; i++) {
+            if(workers[i].job != NULL) {
+                workers_working = 1;
+                break;
+            }
+        }
+
+        if(!workers_working && find_next_node_with_satisfied_deps(nodes, nodes_len) == NULL) {
+            steps_complete = 1;
+        } else {
+            time_count++;
+        }
+    }
+
+    return time_count;
+}
+
+static struct dep_graph_node_t *find_next_free_node_with_satisfied_deps(struct dep_graph_node_t *nodes[], int nodes_len, struct worker_t workers[], int workers_len)
+{
+    struct dep_graph_node_t *best = NULL;
+    for(int i = 0; i < nodes_len; i++) {
+        struct dep_graph_node_t *current = nodes[i];
+
+        if(current->complete) {
+            continue;
+        }
+
+        int all_satisfied = 1;
+        struct dep_list_node_t *dep = current->dependencies;
+        while(dep != NULL) {
+            if(!dep->dependency->complete) {
+                all_satisfied = 0;
+                break;
+            }
+
+            dep = dep->next;
+        }
+
+        if(all_satisfied && (best == NULL || current->id < best->id)) {
+            int worked_on = 0;
+            for(int j = 0; j < workers_len; j++) {
+                if(current == workers[j].job) {
+                    worked_on = 1;
+                    break;
+                }
+            }
+
+            if(!worked_on) {
+                best = current;
+            }
+        }
+    }
+
+    return best;
+}
+
+const struct aoc_solver_t day7_solver = {.name = "day7", .solve = solve};
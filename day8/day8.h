@@ -0,0 +1,8 @@
+#ifndef AOC_DAY8_H
+#define AOC_DAY8_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day8_solver;
+
+#endif //AOC_DAY8_H
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gen.h"
+
+#define BASE_NODES 2000
+#define MAX_METADATA 11
+#define MAX_METADATA_VALUE 9
+
+struct frame_t {
+    long int node;
+    long int next_child;
+};
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    long int nodes_len = BASE_NODES * (long int)args.scale;
+
+    /*
+     * A random recursive tree: each node hangs off a uniformly chosen earlier
+     * node, which keeps the depth logarithmic. Children are then stored
+     * contiguously per parent so the tree can be written out in pre-order.
+     */
+    long int *parents = (long int *)malloc(sizeof(long int) * nodes_len);
+    long int *first_child = (long int *)calloc(nodes_len + 1, sizeof(long int));
+    long int *children = (long int *)malloc(sizeof(long int) * nodes_len);
+    struct frame_t *stack = (struct frame_t *)malloc(sizeof(struct frame_t) * nodes_len);
+    if(parents == NULL || first_child == NULL || children == NULL || stack == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    parents[0] = -1;
+    for(long int i = 1; i < nodes_len; i++) {
+        parents[i] = rng_range(&rng, 0, i - 1);
+        first_child[parents[i] + 1]++;
+    }
+
+    for(long int i = 0; i < nodes_len; i++) {
+        first_child[i + 1] += first_child[i];
+    }
+
+    for(long int i = 1; i < nodes_len; i++) {
+        children[first_child[parents[i]]++] = i;
+    }
+
+    for(long int i = nodes_len; i > 0; i--) {
+        first_child[i] = first_child[i - 1];
+    }
+    first_child[0] = 0;
+
+    /*
+     * The metadata count is written in a node's header but its entries only
+     * once all of its children are done, so the count is kept until then.
+     */
+    long int *metadata = (long int *)malloc(sizeof(long int) * nodes_len);
+    if(metadata == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    long int stack_len = 0;
+    metadata[0] = rng_range(&rng, 1, MAX_METADATA);
+    stack[stack_len++] = (struct frame_t){.node = 0, .next_child = first_child[0]};
+    fprintf(args.out, "%ld %ld", first_child[1] - first_child[0], metadata[0]);
+
+    while(stack_len > 0) {
+        struct frame_t *frame = stack + stack_len - 1;
+
+        if(frame->next_child < first_child[frame->node + 1]) {
+            long int child = children[frame->next_child++];
+            metadata[child] = rng_range(&rng, 1, MAX_METADATA);
+            fprintf(args.out, " %ld %ld", first_child[child + 1] - first_child[child], metadata[child]);
+            stack[stack_len++] = (struct frame_t){.node = child, .next_child = first_child[child]};
+            continue;
+        }
+
+        for(long int i = 0; i < metadata[frame->node]; i++) {
+            fprintf(args.out, " %ld", rng_range(&rng, 1, MAX_METADATA_VALUE));
+        }
+
+        stack_len--;
+    }
+
+    fprintf(args.out, "\n");
+
+    free(metadata);
+    free(stack);
+    free(children);
+    free(first_child);
+    free(parents);
+    gen_close(&args);
+
+    return 0;
+}
@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "input.h"
+#include "scan.h"
+#include "day8.h"
+
+struct tree_node_header_t {
+    int child_nodes;
+    int metadata_entries;
+    int node_value;
+    unsigned int counted: 1;
+};
+
+struct tree_node_metadata_entry_t {
+    int data;
+    struct tree_node_metadata_entry_t *next;
+};
+
+struct tree_node_child_t {
+    struct tree_node_t *child;
+    struct tree_node_child_t *next;
+};
+
+struct numbers_t {
+    int32_t *values;
+    size_t len;
+    size_t pos;
+};
+
+struct tree_node_t {
+    struct tree_node_header_t header;
+    struct tree_node_t *parent;
+    struct tree_node_child_t *children;
+    struct tree_node_metadata_entry_t *entries;
+};
+
+static struct tree_node_t *build_tree_from_input(struct numbers_t *numbers, struct arena_t *arena);
+static struct tree_node_header_t build_header(struct numbers_t *numbers);
+static struct tree_node_metadata_entry_t *build_metadata_list(struct numbers_t *numbers, int count, struct arena_t *arena);
+static int read_number(struct numbers_t *numbers, int *value);
+static int compute_metadata_sum_from_tree(struct tree_node_t *root);
+static int metadata_sum(struct tree_node_metadata_entry_t *metadata_list);
+static int verify_child_nodes_count_match(struct tree_node_t *node);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct arena_t arena;
+    arena_init(&arena, 0);
+
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct view_t rest;
+    input_remaining(&reader, &rest);
+
+    struct numbers_t numbers = {.values = NULL, .len = 0, .pos = 0};
+    numbers.values = (int32_t *)malloc(sizeof(int32_t) * (SCAN_MAX_INTEGERS(rest.len) + 1));
+    if(numbers.values == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    numbers.len = scan_int32(rest.ptr, rest.len, numbers.values, SCAN_MAX_INTEGERS(rest.len));
+    input_release(&reader);
+
+    struct tree_node_t *root = build_tree_from_input(&numbers, &arena);
+    free(numbers.values);
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    int metadata_sum = compute_metadata_sum_from_tree(root);
+    answer_printf(&answer->part1, "%d", metadata_sum);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    answer_printf(&answer->part2, "%d", root->header.node_value);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    arena_release(&arena);
+
+    return 0;
+}
+
+static struct tree_node_t *build_tree_from_input(struct numbers_t *numbers, struct arena_t *arena)
+{
+    struct tree_node_t *parent = NULL;
+    do {
+        if(parent == NULL || !verify_child_nodes_count_match(parent)) {
+            struct tree_node_t *node = ARENA_NEW(arena, struct tree_node_t);
+
+            node->header = build_header(numbers);
+            node->parent = parent;
+            node->children = NULL;
+            node->entries = NULL;
+
+            if(parent != NULL) {
+                struct tree_node_child_t *new_child_node = ARENA_NEW(arena, struct tree_node_child_t);
+
+                new_child_node->next = parent->children;
+                new_child_node->child = node;
+
+                parent->children = new_child_node;
+            }
+
+            parent = node;
+        } else {
+            parent->entries = build_metadata_list(numbers, parent->header.metadata_entries, arena);
+
+            if(parent->header.child_nodes == 0) {
+                parent->header.node_value = metadata_sum(parent->entries);
+            } else {
+                struct tree_node_metadata_entry_t *current_entry = parent->entries;
+
+                while(current_entry != NULL) {
+                    struct tree_node_child_t *current_child = parent->children;
+                    int index = parent->header.child_nodes;
+
+                    while(current_child != NULL) {
+                        if(current_entry->data == index) {
+                            parent->header.node_value += current_child->child->header.node_value;
+                            break;
+                        }
+
+                        current_child = current_child->next;
+                        index--;
+                    }
+
+                    current_entry = current_entry->next;
+                }
+            }
+
+            if(parent->parent == NULL) {
+                break;
+            } else {
+                parent = parent->parent;
+            }
+        }
+    } while(1);
+
+    return parent;
+}
+
+static struct tree_node_header_t build_header(struct numbers_t *numbers)
+{
+    struct tree_node_header_t header = {.child_nodes = 0, .metadata_entries = 0};
+
+    if(read_number(numbers, &header.child_nodes)) {
+        fprintf(stderr, "Unexpected input: cannot read number of child nodes.\n");
+        exit(1);
+    }
+
+    if(read_number(numbers, &header.metadata_entries)) {
+        fprintf(stderr, "Unexpected input: cannot read number of metadata entries.\n");
+        exit(1);
+    }
+
+    header.counted = 0;
+    header.node_value = 0;
+
+    return header;
+}
+
+static struct tree_node_metadata_entry_t *build_metadata_list(struct numbers_t *numbers, int count, struct arena_t *arena)
+{
+    struct tree_node_metadata_entry_t *current = NULL;
+
+    for(int i = 0; i < count; i++) {
+        struct tree_node_metadata_entry_t *list_node = ARENA_NEW(arena, struct tree_node_metadata_entry_t);
+
+        list_node->next = current;
+
+        if(read_number(numbers, &list_node->data)) {
+            fprintf(stderr, "Unexpected input: cannot read metadata entry.\n");
+            exit(1);
+        }
+
+        current = list_node;
+    }
+
+    return current;
+}
+
+static int read_number(struct numbers_t *numbers, int *value)
+{
+    if(numbers->pos >= numbers->len) {
+        return 1;
+    }
+
+    *value = numbers->values[numbers->pos++];
+
+    return 0;
+}
+
+static int compute_metadata_sum_from_tree(struct tree_node_t *root)
+{
+    int total = 0;
+
+    struct tree_node_t *current = root;
+    while(current != NULL) {
+        struct tree_node_child_t *child = current->children;
+        while(child != NULL) {
+            if(!child->child->header.counted) {
+                break;
+            }
+            child = child->next;
+        }
+
+        if(child != NULL) {
+            current = child->child;
+        } else {
+            total += metadata_sum(current->entries);
+            current->header.counted = 1;
+            current = current->parent;
+        }
+    }
+
+    return total;
+}
+
+static int metadata_sum(struct tree_node_metadata_entry_t *metadata_list)
+{
+    int total = 0;
+
+    struct tree_node_metadata_entry_t *current = metadata_list;
+    while(current != NULL) {
+        total += current->data;
+        current = current->next;
+    }
+
+    return total;
+}
+
+static int verify_child_nodes_count_match(struct tree_node_t *node)
+{
+    int count = 0;
+
+    struct tree_node_child_t *current = node->children;
+    while(current != NULL) {
+        count++;
+        current = current->next;
+    }
+
+    return count == node->header.child_nodes;
+}
+
+const struct aoc_solver_t day8_solver = {.name = "day8", .solve = solve};
@@ -0,0 +1,8 @@
+#ifndef AOC_DAY9_H
+#define AOC_DAY9_H
+
+#include "solver.h"
+
+extern const struct aoc_solver_t day9_solver;
+
+#endif //AOC_DAY9_H
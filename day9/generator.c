@@ -0,0 +1,30 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "gen.h"
+
+#define BASE_MARBLES 72000
+#define PART2_FACTOR 100
+
+int main(int argc, char *argv[])
+{
+    struct gen_args_t args = gen_parse_args(argc, argv);
+    struct rng_t rng;
+    rng_seed(&rng, args.seed);
+
+    /*
+     * The solver plays the second game with a hundred times as many marbles
+     * in an int, which bounds how far the first game can be scaled.
+     */
+    unsigned long int scale = gen_clamp_scale("day9", args.scale, INT_MAX / PART2_FACTOR / BASE_MARBLES);
+
+    long int players = rng_range(&rng, 400, 470);
+    long int marbles = rng_range(&rng, BASE_MARBLES - 2000, BASE_MARBLES) * (long int)scale;
+
+    fprintf(args.out, "%ld players; last marble is worth %ld points\n", players, marbles);
+
+    gen_close(&args);
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "input.h"
+#include "day9.h"
+
+/*
+ * 2 MiB of marbles a block, so that with AOC_HUGEPAGES set every block of the
+ * ring is backed by huge pages (see hugemem.h) and a walk around it does not
+ * miss the TLB at every step.
+ */
+#define MARBLES_PER_BLOCK (64 * 1024)
+
+struct game_t {
+    int players_count;
+    int marbles_count;
+    struct player_t *players;
+    struct marble_t *current_marble;
+    struct pool_t *marbles;
+};
+
+struct player_t {
+    long long int score;
+};
+
+struct marble_t {
+    int value;
+    struct marble_t *next;
+    struct marble_t *previous;
+};
+
+static int parse_game_details(struct view_t line, struct game_t *game);
+static long long int play(struct game_t game);
+static void release_marble_resources(struct pool_t *marbles);
+static void release_player_resources(struct player_t *players);
+static struct marble_t *create_marble(struct pool_t *marbles, struct marble_t *after_this, int value);
+static struct marble_t *remove_marble(struct pool_t *marbles, struct marble_t *after_this);
+
+static int solve(FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    struct view_t line;
+    struct game_t game;
+    if(!input_next_line(&reader, &line) || parse_game_details(line, &game)) {
+        fprintf(stderr, "Unexpected input.\n");
+        exit(1);
+    }
+
+    input_release(&reader);
+
+    struct pool_t marbles;
+    POOL_INIT(&marbles, struct marble_t, MARBLES_PER_BLOCK);
+
+    game.marbles = &marbles;
+    answer_lap(answer, AOC_PHASE_PARSE);
+
+    long long int winning_score = play(game);
+    answer_printf(&answer->part1, "%lld", winning_score);
+    answer_lap(answer, AOC_PHASE_PART1);
+
+    game.marbles_count = game.marbles_count * 100;
+    winning_score = play(game);
+    answer_printf(&answer->part2, "%lld", winning_score);
+    answer_lap(answer, AOC_PHASE_PART2);
+
+    pool_release(&marbles);
+
+    return 0;
+}
+
+static int parse_game_details(struct view_t line, struct game_t *game)
+{
+    long int players_count, marbles_count;
+
+    if(view_parse_long(&line, &players_count) || view_expect(&line, " players; last marble is worth ")) {
+        return 1;
+    }
+
+    if(view_parse_long(&line, &marbles_count) || view_expect(&line, " points")) {
+        return 1;
+    }
+
+    *game = (struct game_t){.marbles_count = (int)marbles_count, .players = NULL, .players_count = (int)players_count, .current_marble = NULL, .marbles = NULL};
+
+    return 0;
+}
+
+static long long int play(struct game_t game)
+{
+    struct player_t *players = (struct player_t *)malloc(sizeof(struct player_t) * game.players_count);
+    if(players == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(int i = 0; i < game.players_count; i++) {
+        players[i].score = 0;
+    }
+
+    game.players = players;
+
+    struct marble_t *new_marble = POOL_NEW(game.marbles, struct marble_t);
+    new_marble->value = 0;
+    new_marble->next = new_marble;
+    new_marble->previous = new_marble;
+
+    game.current_marble = new_marble;
+
+    int marble_index = 1;
+    int player_index = 0;
+    while(marble_index < game.marbles_count) {
+        if(marble_index % 23 == 0) {
+            game.players[player_index].score += marble_index;
+
+            for(int i = 0; i < 7; i++) {
+                game.current_marble = game.current_marble->previous;
+            }
+
+            game.players[player_index].score += game.current_marble->value;
+            game.current_marble = remove_marble(game.marbles, game.current_marble);
+        } else {
+            game.current_marble = create_marble(game.marbles, game.current_marble->next, marble_index);
+        }
+
+        marble_index++;
+        player_index = (player_index + 1) % game.players_count;
+    }
+
+    long long int highest_score = 0;
+    for(int i = 0; i < game.players_count; i++) {
+        if(game.players[i].score > highest_score) {
+            highest_score = game.players[i].score;
+        }
+    }
+
+    release_marble_resources(game.marbles);
+    release_player_resources(game.players);
+
+    return highest_score;
+}
+
+static void release_marble_resources(struct pool_t *marbles)
+{
+    pool_reset(marbles);
+}
+
+static void release_player_resources(struct player_t *players)
+{
+    free(players);
+}
+
+static struct marble_t *create_marble(struct pool_t *marbles, struct marble_t *after_this, int value)
+{
+    struct marble_t *new_marble = POOL_NEW(marbles, struct marble_t);
+
+    after_this->next->previous = new_marble;
+    new_marble->next = after_this->next;
+    new_marble->previous = after_this;
+    after_this->next = new_marble;
+    new_marble->value = value;
+
+    return new_marble;
+}
+
+static struct marble_t *remove_marble(struct pool_t *marbles, struct marble_t *this)
+{
+    struct marble_t *tmp = this->next;
+
+    this->previous->next = this->next;
+    this->next->previous = this->previous;
+
+    pool_free(marbles, this);
+
+    return tmp;
+}
+
+const struct aoc_solver_t day9_solver = {.name = "day9", .solve = solve};
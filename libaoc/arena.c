@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arena.h"
+#include "hugemem.h"
+#include "trace.h"
+
+struct arena_block_t {
+    struct arena_block_t *next;
+    size_t size;
+    size_t used;
+};
+
+#define ALIGN_UP(n, align) (((n) + ((align) - 1)) & ~((size_t)(align) - 1))
+#define BLOCK_HEADER_LEN ALIGN_UP(sizeof(struct arena_block_t), ARENA_ALIGN)
+
+static __thread struct arena_block_t *block_cache = NULL;
+static __thread int block_cache_enabled = 0;
+
+static struct arena_block_t *arena_new_block(size_t size);
+static void arena_free_block(struct arena_block_t *block);
+static void arena_release_block(struct arena_block_t *block);
+
+void arena_init(struct arena_t *arena, size_t block_size)
+{
+    arena->head = NULL;
+    arena->current = NULL;
+    arena->block_size = block_size ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+}
+
+void *arena_alloc(struct arena_t *arena, size_t size)
+{
+    size = ALIGN_UP(size ? size : 1, ARENA_ALIGN);
+
+    struct arena_block_t *block = arena->current;
+    while(block != NULL && (block->size - block->used) < size && block->next != NULL) {
+        block = block->next;
+        block->used = 0;
+    }
+
+    if(block == NULL || (block->size - block->used) < size) {
+        struct arena_block_t *new_block = arena_new_block(size > arena->block_size ? size : arena->block_size);
+
+        if(block == NULL) {
+            arena->head = new_block;
+        } else {
+            block->next = new_block;
+        }
+
+        block = new_block;
+    }
+
+    arena->current = block;
+
+    void *ptr = (char *)block + BLOCK_HEADER_LEN + block->used;
+    block->used += size;
+
+    return ptr;
+}
+
+void arena_reset(struct arena_t *arena)
+{
+    arena->current = arena->head;
+    if(arena->head != NULL) {
+        arena->head->used = 0;
+    }
+}
+
+void arena_release(struct arena_t *arena)
+{
+    struct arena_block_t *block = arena->head;
+    while(block != NULL) {
+        struct arena_block_t *tmp = block->next;
+        arena_free_block(block);
+        block = tmp;
+    }
+
+    arena->head = NULL;
+    arena->current = NULL;
+}
+
+void arena_cache_enable(void)
+{
+    block_cache_enabled = 1;
+}
+
+void arena_cache_release(void)
+{
+    block_cache_enabled = 0;
+
+    while(block_cache != NULL) {
+        struct arena_block_t *tmp = block_cache->next;
+        arena_release_block(block_cache);
+        block_cache = tmp;
+    }
+}
+
+void pool_init(struct pool_t *pool, size_t item_size, size_t items_per_block)
+{
+    if(item_size < sizeof(void *)) {
+        item_size = sizeof(void *);
+    }
+
+    pool->item_size = ALIGN_UP(item_size, ARENA_ALIGN);
+    pool->free_list = NULL;
+
+    arena_init(&pool->arena, items_per_block ? pool->item_size * items_per_block : 0);
+}
+
+void *pool_alloc(struct pool_t *pool)
+{
+    TRACE_COUNT(pool_items, 1);
+
+    if(pool->free_list != NULL) {
+        void *item = pool->free_list;
+        pool->free_list = *(void **)item;
+        return item;
+    }
+
+    return arena_alloc(&pool->arena, pool->item_size);
+}
+
+void pool_free(struct pool_t *pool, void *item)
+{
+    *(void **)item = pool->free_list;
+    pool->free_list = item;
+}
+
+void pool_reset(struct pool_t *pool)
+{
+    pool->free_list = NULL;
+    arena_reset(&pool->arena);
+}
+
+void pool_release(struct pool_t *pool)
+{
+    pool->free_list = NULL;
+    arena_release(&pool->arena);
+}
+
+static struct arena_block_t *arena_new_block(size_t size)
+{
+    struct arena_block_t **cached = &block_cache;
+    while(*cached != NULL) {
+        if((*cached)->size >= size) {
+            struct arena_block_t *block = *cached;
+            *cached = block->next;
+
+            block->next = NULL;
+            block->used = 0;
+
+            return block;
+        }
+
+        cached = &(*cached)->next;
+    }
+
+    /*
+     * A block large enough to be mapped in huge pages (see hugemem.h) gets
+     * the rest of its last page too.
+     */
+    size_t len = hugemem_usable_size(BLOCK_HEADER_LEN + size);
+    struct arena_block_t *block = (struct arena_block_t *)hugemem_alloc(len);
+
+    block->next = NULL;
+    block->size = len - BLOCK_HEADER_LEN;
+    block->used = 0;
+
+    TRACE_COUNT(arena_block_bytes, block->size);
+
+    return block;
+}
+
+static void arena_free_block(struct arena_block_t *block)
+{
+    if(!block_cache_enabled) {
+        arena_release_block(block);
+        return;
+    }
+
+    block->next = block_cache;
+    block_cache = block;
+}
+
+static void arena_release_block(struct arena_block_t *block)
+{
+    hugemem_free(block, BLOCK_HEADER_LEN + block->size);
+}
@@ -0,0 +1,58 @@
+#ifndef AOC_ARENA_H
+#define AOC_ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGN 16
+
+/*
+ * A bump allocator. Memory is carved sequentially out of large blocks and is
+ * never freed individually; arena_reset() rewinds the arena so that its blocks
+ * can be reused, and arena_release() returns every block to the system.
+ *
+ * Allocation never fails: like the rest of the project, running out of memory
+ * is fatal.
+ */
+struct arena_t {
+    struct arena_block_t *head;
+    struct arena_block_t *current;
+    size_t block_size;
+};
+
+/*
+ * A fixed-size object pool backed by an arena. Freed items are kept on a free
+ * list and handed out again by the next pool_alloc().
+ */
+struct pool_t {
+    struct arena_t arena;
+    size_t item_size;
+    void *free_list;
+};
+
+void arena_init(struct arena_t *arena, size_t block_size);
+void *arena_alloc(struct arena_t *arena, size_t size);
+void arena_reset(struct arena_t *arena);
+void arena_release(struct arena_t *arena);
+
+/*
+ * While a thread has its block cache enabled, blocks released by any arena or
+ * pool on that thread are kept and handed to the next arena that needs a block
+ * at least as large, instead of going back to the system. A worker that solves
+ * many inputs in turn enables it once and keeps reusing the same memory;
+ * arena_cache_release() frees the cached blocks and disables it again.
+ */
+void arena_cache_enable(void);
+void arena_cache_release(void);
+
+void pool_init(struct pool_t *pool, size_t item_size, size_t items_per_block);
+void *pool_alloc(struct pool_t *pool);
+void pool_free(struct pool_t *pool, void *item);
+void pool_reset(struct pool_t *pool);
+void pool_release(struct pool_t *pool);
+
+#define ARENA_NEW(arena, type) ((type *)arena_alloc((arena), sizeof(type)))
+#define POOL_INIT(pool, type, items_per_block) pool_init((pool), sizeof(type), (items_per_block))
+#define POOL_NEW(pool, type) ((type *)pool_alloc(pool))
+
+#endif //AOC_ARENA_H
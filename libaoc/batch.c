@@ -0,0 +1,237 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "arena.h"
+#include "batch.h"
+#include "threadpool.h"
+#include "warm.h"
+
+#define DEFAULT_PATHS_LEN 64
+
+struct batch_job_t {
+    char *path;
+    char *part1;
+    char *part2;
+    int failed;
+    int done;
+};
+
+struct batch_t {
+    const struct aoc_solver_t *solver;
+    const struct cache_t *cache;
+    struct batch_job_t *jobs;
+    size_t jobs_len;
+    size_t next_job;
+    size_t next_print;
+    int failures;
+    pthread_mutex_t lock;
+};
+
+static void batch_add_path(struct batch_t *batch, size_t *jobs_cap, const char *path);
+static void batch_add_dir(struct batch_t *batch, size_t *jobs_cap, const char *dir);
+static void batch_worker(void *arg);
+static void batch_solve(const struct batch_t *batch, struct batch_job_t *job);
+static void batch_flush(struct batch_t *batch);
+static int compare_names(const void *a, const void *b);
+
+int batch_run(const struct aoc_solver_t *solver, const struct cache_t *cache, size_t workers, int paths_len, char *paths[])
+{
+    struct batch_t batch = {.solver = solver, .cache = cache, .jobs = NULL, .jobs_len = 0, .next_job = 0, .next_print = 0, .failures = 0};
+    size_t jobs_cap = 0;
+    for(int i = 0; i < paths_len; i++) {
+        struct stat st;
+        if(stat(paths[i], &st) == 0 && S_ISDIR(st.st_mode)) {
+            batch_add_dir(&batch, &jobs_cap, paths[i]);
+        } else {
+            batch_add_path(&batch, &jobs_cap, paths[i]);
+        }
+    }
+
+    if(workers > batch.jobs_len) {
+        workers = batch.jobs_len;
+    }
+
+    pthread_mutex_init(&batch.lock, NULL);
+
+    /*
+     * One long-running task per worker rather than one per input, so that a
+     * worker's cached arena blocks and warm state (see warm.h) live exactly as
+     * long as the worker does.
+     */
+    if(workers > 0) {
+        struct threadpool_t pool;
+        threadpool_init(&pool, workers);
+
+        for(size_t i = 0; i < workers; i++) {
+            threadpool_submit(&pool, batch_worker, &batch);
+        }
+
+        threadpool_release(&pool);
+    }
+
+    pthread_mutex_destroy(&batch.lock);
+
+    for(size_t i = 0; i < batch.jobs_len; i++) {
+        free(batch.jobs[i].path);
+    }
+    free(batch.jobs);
+
+    return batch.failures ? EXIT_FAILURE : 0;
+}
+
+static void batch_add_path(struct batch_t *batch, size_t *jobs_cap, const char *path)
+{
+    if(batch->jobs_len >= *jobs_cap) {
+        *jobs_cap = *jobs_cap ? *jobs_cap * 2 : DEFAULT_PATHS_LEN;
+        batch->jobs = (struct batch_job_t *)realloc(batch->jobs, sizeof(struct batch_job_t) * *jobs_cap);
+        if(batch->jobs == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    struct batch_job_t *job = &batch->jobs[batch->jobs_len++];
+    job->path = strdup(path);
+    if(job->path == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    job->part1 = NULL;
+    job->part2 = NULL;
+    job->failed = 0;
+    job->done = 0;
+}
+
+/*
+ * Adds every regular file in dir, skipping hidden ones, in name order.
+ */
+static void batch_add_dir(struct batch_t *batch, size_t *jobs_cap, const char *dir)
+{
+    DIR *stream = opendir(dir);
+    if(stream == NULL) {
+        fprintf(stderr, "Unexpected error: cannot open directory %s.\n", dir);
+        exit(EXIT_FAILURE);
+    }
+
+    size_t first = batch->jobs_len;
+    size_t dir_len = strlen(dir);
+
+    struct dirent *entry;
+    while((entry = readdir(stream)) != NULL) {
+        if(entry->d_name[0] == '.') {
+            continue;
+        }
+
+        size_t path_len = dir_len + strlen(entry->d_name) + 2;
+        char *path = (char *)malloc(sizeof(char) * path_len);
+        if(path == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        snprintf(path, path_len, "%s/%s", dir, entry->d_name);
+
+        struct stat st;
+        if(stat(path, &st) == 0 && S_ISREG(st.st_mode)) {
+            batch_add_path(batch, jobs_cap, path);
+        }
+
+        free(path);
+    }
+
+    closedir(stream);
+
+    qsort(batch->jobs + first, batch->jobs_len - first, sizeof(struct batch_job_t), compare_names);
+}
+
+static void batch_worker(void *arg)
+{
+    struct batch_t *batch = (struct batch_t *)arg;
+
+    arena_cache_enable();
+    warm_enable();
+
+    while(1) {
+        size_t index = __atomic_fetch_add(&batch->next_job, 1, __ATOMIC_RELAXED);
+        if(index >= batch->jobs_len) {
+            break;
+        }
+
+        batch_solve(batch, &batch->jobs[index]);
+
+        pthread_mutex_lock(&batch->lock);
+        batch->jobs[index].done = 1;
+        batch_flush(batch);
+        pthread_mutex_unlock(&batch->lock);
+    }
+
+    warm_release();
+    arena_cache_release();
+}
+
+static void batch_solve(const struct batch_t *batch, struct batch_job_t *job)
+{
+    FILE *input = fopen(job->path, "rb");
+    if(input == NULL) {
+        job->failed = 1;
+        return;
+    }
+
+    struct aoc_answer_t answer;
+    answer_init(&answer);
+
+    if(batch->cache != NULL) {
+        job->failed = cache_solve(batch->cache, batch->solver, input, &answer);
+    } else {
+        job->failed = batch->solver->solve(input, &answer);
+    }
+    job->part1 = answer.part1;
+    job->part2 = answer.part2;
+
+    fclose(input);
+}
+
+/*
+ * Prints every finished input that no unfinished one precedes. Called with
+ * the batch lock held.
+ */
+static void batch_flush(struct batch_t *batch)
+{
+    while(batch->next_print < batch->jobs_len && batch->jobs[batch->next_print].done) {
+        struct batch_job_t *job = &batch->jobs[batch->next_print];
+
+        fputs(job->path, stdout);
+        if(job->failed) {
+            fputs("\terror\n", stdout);
+            batch->failures++;
+        } else {
+            fputc('\t', stdout);
+            answer_print_part(stdout, job->part1);
+            fputc('\t', stdout);
+            answer_print_part(stdout, job->part2);
+            fputc('\n', stdout);
+        }
+
+        free(job->part1);
+        free(job->part2);
+        job->part1 = NULL;
+        job->part2 = NULL;
+
+        batch->next_print++;
+    }
+
+    fflush(stdout);
+}
+
+static int compare_names(const void *a, const void *b)
+{
+    const struct batch_job_t *lhs = (const struct batch_job_t *)a;
+    const struct batch_job_t *rhs = (const struct batch_job_t *)b;
+
+    return strcmp(lhs->path, rhs->path);
+}
@@ -0,0 +1,28 @@
+#ifndef AOC_BATCH_H
+#define AOC_BATCH_H
+
+#include <stddef.h>
+
+#include "cache.h"
+#include "solver.h"
+
+/*
+ * Solves many inputs with one solver in a single process, on up to the given
+ * number of worker threads. Every path is an input file, or a directory whose
+ * regular files are all inputs (in name order).
+ *
+ * Each worker keeps its arena blocks between inputs (see arena_cache_enable()),
+ * and one line per input is written to stdout, in argument order:
+ *
+ *   <path>\t<part1>\t<part2>
+ *
+ * with newlines in an answer written as "\n" and a missing answer as "-". An
+ * input that cannot be read or solved gets "<path>\terror" instead, and makes
+ * the exit status non-zero. Solvers still exit on malformed input, which ends
+ * the whole batch.
+ *
+ * Given a cache, inputs solved before are answered from it (see cache.h).
+ */
+int batch_run(const struct aoc_solver_t *solver, const struct cache_t *cache, size_t workers, int paths_len, char *paths[]);
+
+#endif //AOC_BATCH_H
@@ -0,0 +1,382 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#include <sys/stat.h>
+
+#include "cache.h"
+#include "input.h"
+
+#define CACHE_HASH_SEED 0x9e3779b97f4a7c15ULL
+#define CACHE_HASH_MUL 0xff51afd7ed558ccdULL
+#define DEFAULT_ENTRIES_LEN 64
+
+struct cache_entry_t {
+    char *name;
+    uint64_t size;
+    struct timespec mtime;
+};
+
+static char *cache_path(const struct cache_t *cache, const struct aoc_solver_t *solver, const char *data, size_t len);
+static uint64_t cache_hash(const char *data, size_t len);
+static int cache_load(const char *path, struct aoc_answer_t *answer);
+static void cache_store(const struct cache_t *cache, const char *path, const struct aoc_answer_t *answer);
+static void cache_evict(const struct cache_t *cache);
+static int is_entry_name(const char *name);
+static char *parse_part(char *line);
+static int compare_entries(const void *a, const void *b);
+
+void cache_open(struct cache_t *cache, const char *dir, uint64_t max_bytes)
+{
+    if(mkdir(dir, 0777) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Unexpected error: cannot create cache directory %s.\n", dir);
+        exit(EXIT_FAILURE);
+    }
+
+    cache->dir = strdup(dir);
+    if(cache->dir == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    cache->max_bytes = max_bytes;
+}
+
+void cache_release(struct cache_t *cache)
+{
+    free(cache->dir);
+    cache->dir = NULL;
+}
+
+/*
+ * The input is read once to hash it. On a miss a mapped file is handed to the
+ * solver from where it was, and anything else from the bytes already read.
+ */
+int cache_solve(const struct cache_t *cache, const struct aoc_solver_t *solver, FILE *input, struct aoc_answer_t *answer)
+{
+    struct input_t reader;
+    input_open(&reader, input);
+
+    const char *data = reader.data + reader.pos;
+    size_t len = reader.len - reader.pos;
+
+    char *path = cache_path(cache, solver, data, len);
+    if(!cache_load(path, answer)) {
+        utime(path, NULL);
+        free(path);
+        input_release(&reader);
+        return 0;
+    }
+
+    FILE *stream = reader.mapped ? input : fmemopen((void *)data, len, "r");
+    if(stream == NULL) {
+        perror("Fatal error: Cannot read input.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    answer_init(answer);
+    int ret = solver->solve(stream, answer);
+    if(!ret) {
+        cache_store(cache, path, answer);
+    }
+
+    if(stream != input) {
+        fclose(stream);
+    }
+
+    free(path);
+    input_release(&reader);
+
+    return ret;
+}
+
+static char *cache_path(const struct cache_t *cache, const struct aoc_solver_t *solver, const char *data, size_t len)
+{
+    uint64_t hash = cache_hash(data, len);
+
+    int path_len = snprintf(NULL, 0, "%s/%s-v%d-%016llx-%zu", cache->dir, solver->name, solver->version,
+                            (unsigned long long)hash, len);
+    char *path = (char *)malloc(sizeof(char) * (path_len + 1));
+    if(path == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    snprintf(path, path_len + 1, "%s/%s-v%d-%016llx-%zu", cache->dir, solver->name, solver->version,
+             (unsigned long long)hash, len);
+
+    return path;
+}
+
+/*
+ * Mixes the input eight bytes at a time with a multiply and a shift, then
+ * finishes with the murmur3 avalanche so every input bit reaches every bit of
+ * the hash.
+ */
+static uint64_t cache_hash(const char *data, size_t len)
+{
+    uint64_t hash = CACHE_HASH_SEED ^ (uint64_t)len;
+
+    size_t i = 0;
+    for(; i + 8 <= len; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+
+        hash = (hash ^ word) * CACHE_HASH_MUL;
+        hash ^= hash >> 32;
+    }
+
+    if(i < len) {
+        uint64_t word = 0;
+        memcpy(&word, data + i, len - i);
+
+        hash = (hash ^ word) * CACHE_HASH_MUL;
+        hash ^= hash >> 32;
+    }
+
+    hash ^= hash >> 33;
+    hash *= CACHE_HASH_MUL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+/*
+ * An entry holds the two parts, one line each, as answer_print_part() writes
+ * them. Returns 0 and fills in the answer on a hit.
+ */
+static int cache_load(const char *path, struct aoc_answer_t *answer)
+{
+    FILE *entry = fopen(path, "rb");
+    if(entry == NULL) {
+        return 1;
+    }
+
+    struct input_t reader;
+    input_open(&reader, entry);
+    fclose(entry);
+
+    struct view_t lines[2];
+    int ok = input_next_line(&reader, &lines[0]) && input_next_line(&reader, &lines[1]);
+
+    char *parts[2] = {NULL, NULL};
+    for(int i = 0; ok && i < 2; i++) {
+        char *line = strndup(lines[i].ptr, lines[i].len);
+        if(line == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        parts[i] = parse_part(line);
+    }
+
+    input_release(&reader);
+
+    if(!ok) {
+        return 1;
+    }
+
+    answer_init(answer);
+    answer->part1 = parts[0];
+    answer->part2 = parts[1];
+
+    return 0;
+}
+
+/*
+ * Undoes answer_print_part() in place, freeing the line and returning NULL
+ * for a missing part.
+ */
+static char *parse_part(char *line)
+{
+    if(strcmp(line, "-") == 0) {
+        free(line);
+        return NULL;
+    }
+
+    char *out = line;
+    for(const char *c = line; *c; c++) {
+        if(*c == '\\' && c[1] != 0) {
+            c++;
+            *out++ = *c == 'n' ? '\n' : *c == 't' ? '\t' : *c;
+        } else {
+            *out++ = *c;
+        }
+    }
+    *out = 0;
+
+    return line;
+}
+
+static void cache_store(const struct cache_t *cache, const char *path, const struct aoc_answer_t *answer)
+{
+    size_t tmp_len = strlen(cache->dir) + sizeof("/.entry-XXXXXX");
+    char *tmp = (char *)malloc(sizeof(char) * tmp_len);
+    if(tmp == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    snprintf(tmp, tmp_len, "%s/.entry-XXXXXX", cache->dir);
+
+    int fd = mkstemp(tmp);
+    FILE *entry = fd >= 0 ? fdopen(fd, "wb") : NULL;
+    if(entry == NULL) {
+        if(fd >= 0) {
+            close(fd);
+            unlink(tmp);
+        }
+
+        free(tmp);
+        return;
+    }
+
+    answer_print_part(entry, answer->part1);
+    fputc('\n', entry);
+    answer_print_part(entry, answer->part2);
+    fputc('\n', entry);
+
+    int failed = ferror(entry);
+    if(fclose(entry) != 0 || failed || rename(tmp, path) != 0) {
+        unlink(tmp);
+    }
+
+    free(tmp);
+
+    cache_evict(cache);
+}
+
+/*
+ * Removes the least recently used entries until the rest fit in max_bytes.
+ * Only files named like an entry are counted or removed, so the directory can
+ * hold other files; entries still being written are hidden files, and are
+ * left alone too. An entry that another process removed first is simply
+ * skipped.
+ */
+static void cache_evict(const struct cache_t *cache)
+{
+    DIR *stream = opendir(cache->dir);
+    if(stream == NULL) {
+        return;
+    }
+
+    size_t dir_len = strlen(cache->dir);
+    struct cache_entry_t *entries = NULL;
+    size_t entries_len = 0;
+    size_t entries_cap = 0;
+    uint64_t total = 0;
+
+    struct dirent *dirent;
+    while((dirent = readdir(stream)) != NULL) {
+        if(!is_entry_name(dirent->d_name)) {
+            continue;
+        }
+
+        size_t path_len = dir_len + strlen(dirent->d_name) + 2;
+        char *path = (char *)malloc(sizeof(char) * path_len);
+        if(path == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        snprintf(path, path_len, "%s/%s", cache->dir, dirent->d_name);
+
+        struct stat st;
+        if(stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+            free(path);
+            continue;
+        }
+
+        if(entries_len >= entries_cap) {
+            entries_cap = entries_cap ? entries_cap * 2 : DEFAULT_ENTRIES_LEN;
+            entries = (struct cache_entry_t *)realloc(entries, sizeof(struct cache_entry_t) * entries_cap);
+            if(entries == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        entries[entries_len].name = path;
+        entries[entries_len].size = (uint64_t)st.st_size;
+        entries[entries_len].mtime = st.st_mtim;
+        entries_len++;
+
+        total += (uint64_t)st.st_size;
+    }
+
+    closedir(stream);
+
+    if(total > cache->max_bytes) {
+        qsort(entries, entries_len, sizeof(struct cache_entry_t), compare_entries);
+
+        for(size_t i = 0; i < entries_len && total > cache->max_bytes; i++) {
+            if(unlink(entries[i].name) == 0 || errno == ENOENT) {
+                total -= entries[i].size;
+            }
+        }
+    }
+
+    for(size_t i = 0; i < entries_len; i++) {
+        free(entries[i].name);
+    }
+    free(entries);
+}
+
+/*
+ * Matches what cache_path() writes, <name>-v<version>-<hash>-<input length>,
+ * read from the end since a solver name could contain dashes itself.
+ */
+static int is_entry_name(const char *name)
+{
+    const char *len = name + strlen(name);
+    const char *end = len;
+    while(len > name && len[-1] >= '0' && len[-1] <= '9') {
+        len--;
+    }
+    if(len == end || len - name < 1 || len[-1] != '-') {
+        return 0;
+    }
+
+    const char *hash_end = len - 1;
+    if(hash_end - name < 16 + 1) {
+        return 0;
+    }
+    const char *hash = hash_end - 16;
+    for(const char *c = hash; c < hash_end; c++) {
+        if(!((*c >= '0' && *c <= '9') || (*c >= 'a' && *c <= 'f'))) {
+            return 0;
+        }
+    }
+    if(hash[-1] != '-') {
+        return 0;
+    }
+
+    const char *version_end = hash - 1;
+    const char *version = version_end;
+    while(version > name && version[-1] >= '0' && version[-1] <= '9') {
+        version--;
+    }
+
+    return version < version_end && version - name >= 3 && version[-1] == 'v' && version[-2] == '-' && name[0] != '.';
+}
+
+static int compare_entries(const void *a, const void *b)
+{
+    const struct cache_entry_t *lhs = (const struct cache_entry_t *)a;
+    const struct cache_entry_t *rhs = (const struct cache_entry_t *)b;
+
+    if(lhs->mtime.tv_sec != rhs->mtime.tv_sec) {
+        return lhs->mtime.tv_sec < rhs->mtime.tv_sec ? -1 : 1;
+    }
+
+    if(lhs->mtime.tv_nsec != rhs->mtime.tv_nsec) {
+        return lhs->mtime.tv_nsec < rhs->mtime.tv_nsec ? -1 : 1;
+    }
+
+    return strcmp(lhs->name, rhs->name);
+}
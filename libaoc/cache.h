@@ -0,0 +1,43 @@
+#ifndef AOC_CACHE_H
+#define AOC_CACHE_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "solver.h"
+
+#define CACHE_DEFAULT_MAX_BYTES (64 * 1024 * 1024)
+
+/*
+ * An on-disk cache of answers, one small file per solved input. An entry is
+ * named after the solver, its version and a hash of the input bytes, so the
+ * same input is only solved once per solver version no matter where it comes
+ * from:
+ *
+ *   <dir>/<name>-v<version>-<hash>-<input length>
+ *
+ * Entries are written to a temporary file and renamed into place, so readers
+ * (other threads or other processes sharing the directory) never see a partial
+ * one. Once the entries add up to more than max_bytes, the least recently used
+ * ones are removed; a hit counts as a use. Files not named like an entry are
+ * neither counted nor removed.
+ *
+ * The cache is best effort: an entry that cannot be read is a miss, and one
+ * that cannot be written is skipped.
+ */
+struct cache_t {
+    char *dir;
+    uint64_t max_bytes;
+};
+
+void cache_open(struct cache_t *cache, const char *dir, uint64_t max_bytes);
+void cache_release(struct cache_t *cache);
+
+/*
+ * Solves the puzzle on input like solver->solve(), returning the cached
+ * answers instead when this input has been solved before. Answers are only
+ * cached when the solve succeeds; phase times are left at zero on a hit.
+ */
+int cache_solve(const struct cache_t *cache, const struct aoc_solver_t *solver, FILE *input, struct aoc_answer_t *answer);
+
+#endif //AOC_CACHE_H
@@ -0,0 +1,38 @@
+#!/bin/sh
+# usage: cache_test.sh <aocd1> <aocd2> <build dir>
+set -u
+
+day1=$1
+day2=$2
+build=$3
+
+dir=$(mktemp -d)
+cache=$dir/cache
+trap 'rm -rf "$dir"' EXIT
+failures=0
+
+fail() {
+    echo "FAIL: $*"
+    failures=$((failures + 1))
+}
+
+entries() {
+    ls "$cache" | grep -c -e '-v[0-9]*-[0-9a-f]\{16\}-[0-9]*$'
+}
+
+# Files the cache did not write, one of them only close to an entry's name.
+mkdir "$cache"
+head -c 2097152 /dev/zero > "$cache/notes.bin"
+echo keep > "$cache/day1-v0-notahash-12"
+
+"$day1" --cache "$cache" --cache-max 1M < "$build/day1/input.in" > /dev/null || fail "day1 failed"
+[ "$(entries)" -eq 1 ] || fail "day1 not cached"
+
+# Every entry is over one byte, so storing day2's evicts both.
+"$day2" --cache "$cache" --cache-max 1 < "$build/day2/input.in" > /dev/null || fail "day2 failed"
+[ "$(entries)" -eq 0 ] || fail "entries left after eviction: $(ls "$cache")"
+
+[ "$(wc -c < "$cache/notes.bin")" -eq 2097152 ] || fail "foreign file evicted"
+[ -f "$cache/day1-v0-notahash-12" ] || fail "look-alike file evicted"
+
+[ $failures -eq 0 ]
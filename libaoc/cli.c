@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <getopt.h>
+
+#include "batch.h"
+#include "cache.h"
+#include "cli.h"
+#include "parallel.h"
+#include "threadpool.h"
+
+#define OPT_CACHE_MAX 256
+#define OPT_JSON 257
+#define OPT_TSV 258
+
+enum output_t {
+    OUTPUT_TEXT,
+    OUTPUT_JSON,
+    OUTPUT_TSV
+};
+
+static uint64_t parse_size(const char *arg);
+static void usage(const char *prog);
+
+int solver_main(const struct aoc_solver_t *solver, solver_print_t print, int argc, char *argv[])
+{
+    size_t jobs = threadpool_default_threads();
+    size_t threads = 1;
+    int show_memory = 0;
+    int streaming = 0;
+    enum output_t output = OUTPUT_TEXT;
+    const char *cache_dir = getenv("AOC_CACHE");
+    uint64_t cache_max = CACHE_DEFAULT_MAX_BYTES;
+
+    static const struct option options[] = {
+        {"cache", required_argument, NULL, 'c'},
+        {"cache-max", required_argument, NULL, OPT_CACHE_MAX},
+        {"jobs", required_argument, NULL, 'j'},
+        {"json", no_argument, NULL, OPT_JSON},
+        {"memory", no_argument, NULL, 'm'},
+        {"stream", no_argument, NULL, 's'},
+        {"threads", required_argument, NULL, 't'},
+        {"tsv", no_argument, NULL, OPT_TSV},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int opt;
+    while((opt = getopt_long(argc, argv, "c:j:mst:h", options, NULL)) != -1) {
+        switch(opt) {
+            case 'c':
+                cache_dir = optarg;
+                break;
+            case OPT_CACHE_MAX:
+                cache_max = parse_size(optarg);
+                break;
+            case 'j':
+                jobs = (size_t)cli_parse_count(optarg, 1, "jobs");
+                break;
+            case OPT_JSON:
+                output = OUTPUT_JSON;
+                break;
+            case 'm':
+                show_memory = 1;
+                break;
+            case 's':
+                streaming = 1;
+                break;
+            case 't':
+                threads = (size_t)cli_parse_count(optarg, 0, "threads");
+                break;
+            case OPT_TSV:
+                output = OUTPUT_TSV;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if(streaming && solver->solve_stream == NULL) {
+        fprintf(stderr, "Unexpected argument: %s cannot solve a stream.\n", solver->name);
+        exit(EXIT_FAILURE);
+    }
+
+    struct cache_t cache;
+    int use_cache = !streaming && cache_dir != NULL && *cache_dir;
+    if(use_cache) {
+        cache_open(&cache, cache_dir, cache_max);
+    }
+
+    parallel_init(threads);
+
+    if(optind < argc) {
+        if(show_memory) {
+            fprintf(stderr, "Unexpected argument: -m only applies to a puzzle on stdin.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        if(streaming) {
+            fprintf(stderr, "Unexpected argument: --stream only applies to a puzzle on stdin.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        if(output != OUTPUT_TEXT) {
+            fprintf(stderr, "Unexpected argument: --json and --tsv only apply to a puzzle on stdin.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        int ret = batch_run(solver, use_cache ? &cache : NULL, jobs, argc - optind, argv + optind);
+        parallel_release();
+        if(use_cache) {
+            cache_release(&cache);
+        }
+
+        return ret;
+    }
+
+    if(show_memory && memstat_start()) {
+        fprintf(stderr, "Unexpected argument: built without AOC_MEMSTAT.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* A record carries the peak heap use whenever the build can count it. */
+    int with_memory = show_memory || (output != OUTPUT_TEXT && !memstat_start());
+
+    struct aoc_answer_t answer;
+    answer_init(&answer);
+
+    int failed;
+    if(streaming) {
+        failed = solver->solve_stream(stdin, &answer);
+    } else if(use_cache) {
+        failed = cache_solve(&cache, solver, stdin, &answer);
+    } else {
+        failed = solver->solve(stdin, &answer);
+    }
+
+    if(failed) {
+        fprintf(stderr, "Unexpected error: unable to solve puzzle.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    switch(output) {
+        case OUTPUT_JSON:
+            answer_print_json(stdout, solver->name, &answer, with_memory);
+            break;
+        case OUTPUT_TSV:
+            answer_print_tsv(stdout, solver->name, &answer, with_memory);
+            break;
+        default:
+            print(stdout, &answer);
+            break;
+    }
+
+    if(show_memory) {
+        answer_print_memstat(stderr, &answer);
+    }
+
+    answer_release(&answer);
+    parallel_release();
+    if(use_cache) {
+        cache_release(&cache);
+    }
+
+    return 0;
+}
+
+long int cli_parse_count(const char *arg, long int min, const char *what)
+{
+    char *end;
+    errno = 0;
+    long int value = strtol(arg, &end, 10);
+
+    if(end == arg || *end != 0 || errno == ERANGE) {
+        fprintf(stderr, "Unexpected argument: invalid number of %s %s.\n", what, arg);
+        exit(EXIT_FAILURE);
+    }
+
+    if(value < min) {
+        fprintf(stderr, "Unexpected argument: number of %s must be at least %ld.\n", what, min);
+        exit(EXIT_FAILURE);
+    }
+
+    return value;
+}
+
+/*
+ * A size in bytes, with an optional K, M or G suffix for binary multiples.
+ */
+static uint64_t parse_size(const char *arg)
+{
+    char *end;
+    long long int value = strtoll(arg, &end, 10);
+
+    int shift = 0;
+    switch(*end) {
+        case 'K':
+        case 'k':
+            shift = 10;
+            end++;
+            break;
+        case 'M':
+        case 'm':
+            shift = 20;
+            end++;
+            break;
+        case 'G':
+        case 'g':
+            shift = 30;
+            end++;
+            break;
+    }
+
+    if(end == arg || *end != 0 || value < 0) {
+        fprintf(stderr, "Unexpected argument: invalid size %s.\n", arg);
+        exit(EXIT_FAILURE);
+    }
+
+    return (uint64_t)value << shift;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-m] [--json|--tsv] [--stream] [--threads N] [--cache DIR] < input\n"
+                    "       %s [-j jobs] [--threads N] [--cache DIR] <input|dir>...\n"
+                    "\n"
+                    "Solves the puzzle on stdin, or every given input (and every file in a given\n"
+                    "directory) in one process with up to <jobs> workers, printing one line per\n"
+                    "input: <path>\\t<part1>\\t<part2>. With -m, the heap use of each phase of\n"
+                    "the stdin solve is written to stderr. --threads N lets a solver split its\n"
+                    "own work across N threads (0 for one per core).\n"
+                    "\n"
+                    "--json and --tsv print the stdin solve as one record instead: the solver,\n"
+                    "both parts, the parse, part1 and part2 times in nanoseconds, the peak heap\n"
+                    "bytes (when built with AOC_MEMSTAT) and the peak resident set size.\n"
+                    "\n"
+                    "--cache DIR (or AOC_CACHE=DIR) answers inputs solved before from DIR,\n"
+                    "keeping at most --cache-max bytes of answers (64M by default).\n"
+                    "\n"
+                    "--stream solves the puzzle on stdin as it arrives, for the solvers that can,\n"
+                    "parsing on a second thread; the cache is not used.\n", prog, prog);
+}
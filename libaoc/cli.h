@@ -0,0 +1,35 @@
+#ifndef AOC_CLI_H
+#define AOC_CLI_H
+
+#include <stdio.h>
+
+#include "solver.h"
+
+/*
+ * The command line every aocd# shares, and aoc day# with it:
+ *
+ *   aocd# [-m] [--json|--tsv] [--stream] [--threads N] [--cache DIR] < input
+ *   aocd# [-j jobs] [--threads N] [--cache DIR] <input|dir>...
+ *
+ * With no paths the puzzle on stdin is solved and handed to print(); with
+ * paths it runs in batch mode (see batch.h) on up to <jobs> workers. -m writes
+ * the heap use of each phase to stderr (see memstat.h), and --threads starts a
+ * pool of N threads, 0 for one per core, for the solvers that split their work
+ * with parallel_for() (see parallel.h). --cache, or the AOC_CACHE environment
+ * variable, answers inputs solved before from a cache directory, and
+ * --cache-max bounds its size (see cache.h). --stream solves stdin with the
+ * solver's solve_stream(), as the input arrives. --json and --tsv print the
+ * answer as one record for tools to read instead of print()'s sentences (see
+ * answer_print_json()).
+ */
+typedef void (*solver_print_t)(FILE *stream, const struct aoc_answer_t *answer);
+
+int solver_main(const struct aoc_solver_t *solver, solver_print_t print, int argc, char *argv[]);
+
+/*
+ * The count of <what> an option argument gives, which must be a whole decimal
+ * number no less than min. Anything else is reported and exits.
+ */
+long int cli_parse_count(const char *arg, long int min, const char *what);
+
+#endif //AOC_CLI_H
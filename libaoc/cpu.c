@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "cpu.h"
+
+#ifdef CPU_X86
+#include <cpuid.h>
+
+#define XCR0_SSE_AVX 0x06
+#define XCR0_AVX512 0xe6
+#endif
+
+static const char *const tier_names[CPU_TIERS] = {"scalar", "sse4.2", "avx2", "avx512"};
+
+static pthread_once_t tier_once = PTHREAD_ONCE_INIT;
+static enum cpu_tier_t tier = CPU_TIER_SCALAR;
+
+static void init_tier(void);
+static enum cpu_tier_t detect_tier(void);
+
+enum cpu_tier_t cpu_tier(void)
+{
+    pthread_once(&tier_once, init_tier);
+
+    return tier;
+}
+
+const char *cpu_tier_name(enum cpu_tier_t tier)
+{
+    return tier_names[tier];
+}
+
+static void init_tier(void)
+{
+    tier = detect_tier();
+
+    const char *forced = getenv("AOC_CPU_TIER");
+    if(forced == NULL || *forced == 0) {
+        return;
+    }
+
+    for(int i = 0; i < CPU_TIERS; i++) {
+        if(strcmp(forced, tier_names[i]) != 0) {
+            continue;
+        }
+
+        if((enum cpu_tier_t)i > tier) {
+            fprintf(stderr, "Fatal error: AOC_CPU_TIER=%s but this CPU does not support it (%s at most).\n",
+                    forced, tier_names[tier]);
+            exit(EXIT_FAILURE);
+        }
+
+        tier = (enum cpu_tier_t)i;
+        return;
+    }
+
+    fprintf(stderr, "Unexpected value for AOC_CPU_TIER: %s (expected scalar, sse4.2, avx2 or avx512).\n", forced);
+    exit(1);
+}
+
+static enum cpu_tier_t detect_tier(void)
+{
+#ifdef CPU_X86
+    unsigned int eax, ebx, ecx, edx;
+    if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_2)) {
+        return CPU_TIER_SCALAR;
+    }
+
+    if(!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX)) {
+        return CPU_TIER_SSE42;
+    }
+
+    uint32_t xcr0_lo, xcr0_hi;
+    __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    if((xcr0_lo & XCR0_SSE_AVX) != XCR0_SSE_AVX) {
+        return CPU_TIER_SSE42;
+    }
+
+    if(!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || !(ebx & bit_AVX2)) {
+        return CPU_TIER_SSE42;
+    }
+
+    if((xcr0_lo & XCR0_AVX512) != XCR0_AVX512 || !(ebx & bit_AVX512F) || !(ebx & bit_AVX512BW)) {
+        return CPU_TIER_AVX2;
+    }
+
+    return CPU_TIER_AVX512;
+#else
+    return CPU_TIER_SCALAR;
+#endif
+}
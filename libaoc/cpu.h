@@ -0,0 +1,35 @@
+#ifndef AOC_CPU_H
+#define AOC_CPU_H
+
+/*
+ * Runtime CPU dispatch, so one build runs everywhere and still uses the
+ * widest vectors the machine has. Hot kernels come in one version per tier,
+ * each compiled for its instruction set with the CPU_TARGET_* attributes
+ * while the rest of the build keeps targeting the baseline, and a solver
+ * binds a function pointer to the version for cpu_tier() before its hot
+ * loop.
+ *
+ * The tier is detected once, with cpuid, and AVX tiers also need the OS to
+ * save the wider registers (xgetbv). Setting AOC_CPU_TIER to scalar, sse4.2,
+ * avx2 or avx512 forces a lower tier, to benchmark the versions against
+ * each other or check they agree; asking for a tier the CPU lacks is fatal.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_X86
+#define CPU_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define CPU_TARGET_AVX2 __attribute__((target("avx2")))
+#define CPU_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#endif
+
+enum cpu_tier_t {
+    CPU_TIER_SCALAR,
+    CPU_TIER_SSE42,
+    CPU_TIER_AVX2,
+    CPU_TIER_AVX512,
+    CPU_TIERS
+};
+
+enum cpu_tier_t cpu_tier(void);
+const char *cpu_tier_name(enum cpu_tier_t tier);
+
+#endif //AOC_CPU_H
@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cycle.h"
+#include "hashmap.h"
+
+#define CYCLE_HASH_MUL 0xff51afd7ed558ccdULL
+#define BUFF_LEN 1024
+
+static int advance_hashed(const struct cycle_sim_t *sim, void *state, uint64_t steps, struct cycle_t *cycle);
+static int advance_brent(const struct cycle_sim_t *sim, void *state, uint64_t steps, struct cycle_t *cycle);
+static int repeats_after_lap(const struct cycle_sim_t *sim, void *state, uint64_t len, int64_t *shift);
+static void skip_laps(const struct cycle_sim_t *sim, void *state, uint64_t step, uint64_t steps, struct cycle_t *cycle);
+static int64_t state_offset(const struct cycle_sim_t *sim, const void *state);
+
+int cycle_advance(const struct cycle_sim_t *sim, void *state, enum cycle_mode_t mode, uint64_t steps, struct cycle_t *cycle)
+{
+    cycle->start = 0;
+    cycle->len = 0;
+    cycle->shift = 0;
+    cycle->laps = 0;
+
+    if(mode == CYCLE_BRENT) {
+        return advance_brent(sim, state, steps, cycle);
+    }
+
+    return advance_hashed(sim, state, steps, cycle);
+}
+
+uint64_t cycle_hash_word(uint64_t hash, uint64_t word)
+{
+    hash = (hash ^ word) * CYCLE_HASH_MUL;
+    return hash ^ (hash >> 32);
+}
+
+uint64_t cycle_hash_bytes(uint64_t hash, const void *data, size_t len)
+{
+    const char *bytes = (const char *)data;
+
+    size_t i = 0;
+    for(; i + 8 <= len; i += 8) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = cycle_hash_word(hash, word);
+    }
+
+    if(i < len) {
+        uint64_t word = 0;
+        memcpy(&word, bytes + i, len - i);
+        hash = cycle_hash_word(hash, word);
+    }
+
+    return hash;
+}
+
+/*
+ * A hash seen before only makes a candidate cycle, which is confirmed by
+ * simulating one more lap of it and comparing the states in full, which also
+ * measures the lap's shift. Should two different states share the hash, the
+ * later one takes it over, so that its own repeat can still be found, and the
+ * search goes on from the end of the lap.
+ */
+static int advance_hashed(const struct cycle_sim_t *sim, void *state, uint64_t steps, struct cycle_t *cycle)
+{
+    struct hashmap_t seen;
+    hashmap_init(&seen, BUFF_LEN);
+
+    int ret = 0;
+    uint64_t step = 0;
+    while(1) {
+        uint64_t hash = sim->hash(sim->ctx, state);
+        uint64_t *first = hashmap_get(&seen, hash);
+        if(first != NULL) {
+            uint64_t len = step - *first;
+            if(steps - step < len) {
+                for(; step < steps; step++) {
+                    sim->step(sim->ctx, state);
+                }
+                break;
+            }
+
+            uint64_t start = *first;
+            int64_t shift;
+            int repeats = repeats_after_lap(sim, state, len, &shift);
+
+            if(repeats) {
+                cycle->start = start;
+                cycle->len = len;
+                cycle->shift = shift;
+                skip_laps(sim, state, step + len, steps, cycle);
+                break;
+            }
+
+            hashmap_put(&seen, hash, step);
+            step += len;
+
+            if(sim->search_limit != 0 && step >= sim->search_limit) {
+                ret = 1;
+                break;
+            }
+
+            continue;
+        }
+
+        if(step == steps) {
+            break;
+        }
+
+        if(sim->search_limit != 0 && step >= sim->search_limit) {
+            ret = 1;
+            break;
+        }
+
+        hashmap_put(&seen, hash, step);
+
+        sim->step(sim->ctx, state);
+        step++;
+    }
+
+    hashmap_release(&seen);
+
+    return ret;
+}
+
+/*
+ * Advances state by len steps, and tells whether it came back to where it
+ * started, along with how far it drifted meanwhile.
+ */
+static int repeats_after_lap(const struct cycle_sim_t *sim, void *state, uint64_t len, int64_t *shift)
+{
+    void *saved = sim->clone(sim->ctx, state);
+
+    for(uint64_t i = 0; i < len; i++) {
+        sim->step(sim->ctx, state);
+    }
+
+    int repeats = sim->equal(sim->ctx, saved, state);
+    *shift = state_offset(sim, state) - state_offset(sim, saved);
+
+    sim->release(sim->ctx, saved);
+
+    return repeats;
+}
+
+/*
+ * The first pass only finds the length of the cycle: the saved state is
+ * somewhere on it by the time the two meet. The cycle then starts at the
+ * first step whose state matches the one len steps after it.
+ */
+static int advance_brent(const struct cycle_sim_t *sim, void *state, uint64_t steps, struct cycle_t *cycle)
+{
+    if(steps == 0) {
+        return 0;
+    }
+
+    void *initial = sim->clone(sim->ctx, state);
+    void *saved = sim->clone(sim->ctx, state);
+
+    uint64_t power = 1;
+    uint64_t len = 1;
+    uint64_t step = 1;
+    sim->step(sim->ctx, state);
+
+    while(!sim->equal(sim->ctx, saved, state)) {
+        if(step == steps || (sim->search_limit != 0 && step >= sim->search_limit)) {
+            sim->release(sim->ctx, initial);
+            sim->release(sim->ctx, saved);
+            return step != steps;
+        }
+
+        if(power == len) {
+            sim->copy(sim->ctx, saved, state);
+            power *= 2;
+            len = 0;
+        }
+
+        sim->step(sim->ctx, state);
+        step++;
+        len++;
+    }
+
+    cycle->len = len;
+    cycle->shift = state_offset(sim, state) - state_offset(sim, saved);
+
+    sim->copy(sim->ctx, saved, initial);
+    for(uint64_t i = 0; i < len; i++) {
+        sim->step(sim->ctx, saved);
+    }
+
+    while(!sim->equal(sim->ctx, initial, saved)) {
+        sim->step(sim->ctx, initial);
+        sim->step(sim->ctx, saved);
+        cycle->start++;
+    }
+
+    sim->release(sim->ctx, initial);
+    sim->release(sim->ctx, saved);
+
+    skip_laps(sim, state, step, steps, cycle);
+
+    return 0;
+}
+
+/*
+ * state is at step, somewhere on the cycle, so only the steps left over
+ * after the whole laps up to steps need simulating.
+ */
+static void skip_laps(const struct cycle_sim_t *sim, void *state, uint64_t step, uint64_t steps, struct cycle_t *cycle)
+{
+    cycle->laps = (steps - step) / cycle->len;
+
+    for(uint64_t left = (steps - step) % cycle->len; left > 0; left--) {
+        sim->step(sim->ctx, state);
+    }
+}
+
+static int64_t state_offset(const struct cycle_sim_t *sim, const void *state)
+{
+    return sim->offset != NULL ? sim->offset(sim->ctx, state) : 0;
+}
@@ -0,0 +1,82 @@
+#ifndef AOC_CYCLE_H
+#define AOC_CYCLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CYCLE_HASH_SEED 0x9e3779b97f4a7c15ULL
+
+/*
+ * How cycle_advance() recognises a state it has seen before.
+ *
+ * CYCLE_HASHED records the hash of every state and the step it was first
+ * seen at. A repeated hash is confirmed by simulating one more lap and
+ * comparing the state with a copy of itself from the start of the lap, so two
+ * states that share a hash cannot fake a cycle. It steps at most one lap past
+ * the end of the first.
+ *
+ * CYCLE_BRENT keeps two states and compares them in full, with Brent's
+ * algorithm: the saved state moves to the current one at every power of two
+ * steps, until the current one meets it. Memory does not grow with the number
+ * of steps, but finding where the cycle starts costs another pass from the
+ * start state.
+ */
+enum cycle_mode_t {
+    CYCLE_HASHED,
+    CYCLE_BRENT
+};
+
+/*
+ * A deterministic simulation, seen as its state and the step that advances it
+ * in place. CYCLE_HASHED needs hash(), equal(), and clone() and release() to
+ * keep a copy of the state over a lap; CYCLE_BRENT needs equal(), and clone(),
+ * copy() and release() to keep its own copies of the state.
+ *
+ * For a state that moves as it repeats (a pattern drifting along a line),
+ * hash() and equal() look at the state relative to its offset(), and the
+ * distance it drifts over each lap is reported as the cycle's shift. step()
+ * must then behave the same wherever the state is.
+ *
+ * search_limit is how many steps a cycle may take to show up before
+ * cycle_advance() gives up, or 0 for no limit.
+ */
+struct cycle_sim_t {
+    void *ctx;
+    void (*step)(void *ctx, void *state);
+    uint64_t (*hash)(void *ctx, const void *state);
+    int (*equal)(void *ctx, const void *a, const void *b);
+    void *(*clone)(void *ctx, const void *state);
+    void (*copy)(void *ctx, void *dst, const void *src);
+    void (*release)(void *ctx, void *state);
+    int64_t (*offset)(void *ctx, const void *state);
+    uint64_t search_limit;
+};
+
+/*
+ * The states from step start on repeat every len steps, each lap moving them
+ * by shift. laps is how many whole laps cycle_advance() skipped; len is 0
+ * when the last step came before a cycle was confirmed.
+ */
+struct cycle_t {
+    uint64_t start;
+    uint64_t len;
+    int64_t shift;
+    uint64_t laps;
+};
+
+/*
+ * Advances state by steps steps, simulating only until its cycle is found
+ * and then as many steps as are left over after skipping every whole lap.
+ * The state ends up where it would be after steps steps, less laps * shift.
+ * Returns 1, with state part way, when no cycle showed up within the search
+ * limit.
+ */
+int cycle_advance(const struct cycle_sim_t *sim, void *state, enum cycle_mode_t mode, uint64_t steps, struct cycle_t *cycle);
+
+/*
+ * Folds len bytes into hash, for hash() callbacks. Start from CYCLE_HASH_SEED.
+ */
+uint64_t cycle_hash_bytes(uint64_t hash, const void *data, size_t len);
+uint64_t cycle_hash_word(uint64_t hash, uint64_t word);
+
+#endif //AOC_CYCLE_H
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gen.h"
+
+#define SWAP_LEN 64
+
+void rng_seed(struct rng_t *rng, uint64_t seed)
+{
+    rng->state = seed;
+}
+
+uint64_t rng_next(struct rng_t *rng)
+{
+    uint64_t z = (rng->state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+    return z ^ (z >> 31);
+}
+
+long int rng_range(struct rng_t *rng, long int lower, long int upper)
+{
+    if(upper <= lower) {
+        return lower;
+    }
+
+    uint64_t span = (uint64_t)(upper - lower) + 1;
+
+    return lower + (long int)(rng_next(rng) % span);
+}
+
+int rng_chance(struct rng_t *rng, int percent)
+{
+    return (int)(rng_next(rng) % 100) < percent;
+}
+
+void rng_shuffle(struct rng_t *rng, void *base, size_t nmemb, size_t size)
+{
+    unsigned char *items = (unsigned char *)base;
+    unsigned char tmp[SWAP_LEN];
+
+    if(size > SWAP_LEN) {
+        fprintf(stderr, "Unexpected error: cannot shuffle items larger than %d bytes.\n", SWAP_LEN);
+        exit(EXIT_FAILURE);
+    }
+
+    for(size_t i = nmemb; i > 1; i--) {
+        size_t j = (size_t)(rng_next(rng) % i);
+
+        memcpy(tmp, items + (i - 1) * size, size);
+        memcpy(items + (i - 1) * size, items + j * size, size);
+        memcpy(items + j * size, tmp, size);
+    }
+}
+
+struct gen_args_t gen_parse_args(int argc, char *argv[])
+{
+    struct gen_args_t args = {.seed = 0, .scale = 1, .out = stdout};
+
+    if(argc < 3 || argc > 4) {
+        fprintf(stderr, "usage: %s <seed> <scale> [output]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    char *eos = NULL;
+    args.seed = (uint64_t)strtoull(argv[1], &eos, 10);
+    if(*eos != 0) {
+        fprintf(stderr, "Unexpected argument: invalid seed %s.\n", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+
+    args.scale = strtoul(argv[2], &eos, 10);
+    if(*eos != 0 || args.scale == 0) {
+        fprintf(stderr, "Unexpected argument: invalid scale %s.\n", argv[2]);
+        exit(EXIT_FAILURE);
+    }
+
+    if(argc == 4) {
+        args.out = fopen(argv[3], "w");
+        if(args.out == NULL) {
+            perror("Fatal error: Cannot open output file.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return args;
+}
+
+void gen_close(struct gen_args_t *args)
+{
+    if(fflush(args->out) != 0 || (args->out != stdout && fclose(args->out) != 0)) {
+        perror("Fatal error: Cannot write output.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+unsigned long int gen_clamp_scale(const char *name, unsigned long int scale, unsigned long int max_scale)
+{
+    if(scale <= max_scale) {
+        return scale;
+    }
+
+    fprintf(stderr, "%s: scale %lu exceeds what the solver can represent, using %lu.\n", name, scale, max_scale);
+
+    return max_scale;
+}
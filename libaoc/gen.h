@@ -0,0 +1,39 @@
+#ifndef AOC_GEN_H
+#define AOC_GEN_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * A small deterministic PRNG (splitmix64) for the input generators. The same
+ * seed produces the same input on every platform, so a scaled input can be
+ * regenerated instead of checked in.
+ */
+struct rng_t {
+    uint64_t state;
+};
+
+void rng_seed(struct rng_t *rng, uint64_t seed);
+uint64_t rng_next(struct rng_t *rng);
+long int rng_range(struct rng_t *rng, long int lower, long int upper);
+int rng_chance(struct rng_t *rng, int percent);
+void rng_shuffle(struct rng_t *rng, void *base, size_t nmemb, size_t size);
+
+/*
+ * Every generator is invoked as `aocd#_gen <seed> <scale> [output]`. The
+ * scale is relative to the checked-in input.in: 1 produces an input of about
+ * the same size, 10 one ten times larger, and so on. Output goes to stdout
+ * unless a path is given.
+ */
+struct gen_args_t {
+    uint64_t seed;
+    unsigned long int scale;
+    FILE *out;
+};
+
+struct gen_args_t gen_parse_args(int argc, char *argv[]);
+void gen_close(struct gen_args_t *args);
+unsigned long int gen_clamp_scale(const char *name, unsigned long int scale, unsigned long int max_scale);
+
+#endif //AOC_GEN_H
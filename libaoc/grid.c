@@ -0,0 +1,53 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "grid.h"
+#include "hugemem.h"
+
+static size_t round_up(size_t value, size_t multiple);
+
+/*
+ * The left border is widened to a whole number of GRID_ALIGN blocks so that
+ * x = 0 is aligned, and the row stride is rounded up to keep it that way on
+ * every row. A large grid is backed as hugemem.h decides.
+ */
+void grid_init(struct grid_t *grid, int width, int height, int border, size_t cell_size)
+{
+    size_t left = round_up((size_t)border * cell_size, GRID_ALIGN);
+
+    grid->cell_size = cell_size;
+    grid->stride = round_up(left + (size_t)(width + border) * cell_size, GRID_ALIGN);
+    grid->size = grid->stride * (size_t)(height + 2 * border);
+    grid->width = width;
+    grid->height = height;
+    grid->border = border;
+
+    grid->cells = (char *)hugemem_calloc(grid->size);
+    grid->origin = grid->cells + grid->stride * (size_t)border + left;
+}
+
+void grid_release(struct grid_t *grid)
+{
+    hugemem_free(grid->cells, grid->size);
+
+    grid->cells = NULL;
+    grid->origin = NULL;
+}
+
+void grid_copy(struct grid_t *dst, const struct grid_t *src)
+{
+    memcpy(dst->cells, src->cells, src->size);
+}
+
+void grid_swap(struct grid_t *a, struct grid_t *b)
+{
+    struct grid_t tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+static size_t round_up(size_t value, size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
@@ -0,0 +1,47 @@
+#ifndef AOC_GRID_H
+#define AOC_GRID_H
+
+#include <stddef.h>
+
+#define GRID_ALIGN 64
+
+/*
+ * A width x height grid of fixed-size cells in a single allocation, addressed
+ * as grid.origin + y * grid.stride + x * cell_size. The grid is surrounded by
+ * a border of the given number of cells on every side, so that the neighbours
+ * of an edge cell can be read without bounds checks: with a border of 1,
+ * (-1, -1) and (width, height) are valid cells.
+ *
+ * Every cell, border included, starts out zeroed, and only changes when it is
+ * written. Each row starts (at x = 0) on a GRID_ALIGN byte boundary, so rows
+ * can be processed with aligned vector loads.
+ */
+struct grid_t {
+    char *cells;
+    char *origin;
+    size_t cell_size;
+    size_t stride;
+    size_t size;
+    int width;
+    int height;
+    int border;
+};
+
+#define GRID_ROW(grid, type, y) ((type *)((grid)->origin + (ptrdiff_t)(y) * (ptrdiff_t)(grid)->stride))
+#define GRID_AT(grid, type, x, y) (GRID_ROW(grid, type, y)[x])
+
+void grid_init(struct grid_t *grid, int width, int height, int border, size_t cell_size);
+void grid_release(struct grid_t *grid);
+
+/*
+ * Copies every cell, border included, between grids of the same shape.
+ */
+void grid_copy(struct grid_t *dst, const struct grid_t *src);
+
+/*
+ * Exchanges two grids of the same shape, for double-buffered updates that
+ * read one generation and write the next.
+ */
+void grid_swap(struct grid_t *a, struct grid_t *b);
+
+#endif //AOC_GRID_H
@@ -0,0 +1,261 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hashmap.h"
+
+#define HASHMAP_MIN_LEN 16
+#define HASHMAP_MAX_DIST UINT8_MAX
+#define HASHMAP_MUL 0x9e3779b97f4a7c15ULL
+
+static void table_alloc(struct hashmap_t *map, size_t len);
+static void table_resize(struct hashmap_t *map, size_t len);
+static int table_insert(struct hashmap_t *map, struct hashmap_entry_t *entry);
+static size_t table_home(const struct hashmap_t *map, uint64_t key);
+static size_t table_find(const struct hashmap_t *map, uint64_t key);
+
+/*
+ * Tables are kept at most three quarters full.
+ */
+void hashmap_init(struct hashmap_t *map, size_t expected)
+{
+    size_t len = HASHMAP_MIN_LEN;
+    while(len - len / 4 < expected) {
+        len *= 2;
+    }
+
+    table_alloc(map, len);
+    map->len = 0;
+}
+
+void hashmap_release(struct hashmap_t *map)
+{
+    free(map->entries);
+    free(map->dists);
+
+    map->entries = NULL;
+    map->dists = NULL;
+    map->len = 0;
+}
+
+void hashmap_clear(struct hashmap_t *map)
+{
+    memset(map->dists, 0, sizeof(uint8_t) * (map->mask + 1));
+    map->len = 0;
+}
+
+int hashmap_put(struct hashmap_t *map, uint64_t key, uint64_t value)
+{
+    uint64_t *found = hashmap_get(map, key);
+    if(found != NULL) {
+        *found = value;
+        return 0;
+    }
+
+    if(map->len >= map->grow_at) {
+        table_resize(map, (map->mask + 1) * 2);
+    }
+
+    struct hashmap_entry_t entry = {.key = key, .value = value};
+    while(table_insert(map, &entry)) {
+        table_resize(map, (map->mask + 1) * 2);
+    }
+
+    map->len++;
+
+    return 1;
+}
+
+uint64_t *hashmap_get(const struct hashmap_t *map, uint64_t key)
+{
+    size_t i = table_find(map, key);
+    if(i > map->mask) {
+        return NULL;
+    }
+
+    return &map->entries[i].value;
+}
+
+/*
+ * Every entry after the removed one that is not in its home slot moves back
+ * one slot, which leaves the table as if the removed entry had never been
+ * inserted.
+ */
+int hashmap_remove(struct hashmap_t *map, uint64_t key)
+{
+    size_t i = table_find(map, key);
+    if(i > map->mask) {
+        return 0;
+    }
+
+    size_t next = (i + 1) & map->mask;
+    while(map->dists[next] > 1) {
+        map->entries[i] = map->entries[next];
+        map->dists[i] = (uint8_t)(map->dists[next] - 1);
+
+        i = next;
+        next = (next + 1) & map->mask;
+    }
+
+    map->dists[i] = 0;
+    map->len--;
+
+    return 1;
+}
+
+void hashset_init(struct hashset_t *set, size_t expected)
+{
+    hashmap_init(&set->map, expected);
+}
+
+void hashset_release(struct hashset_t *set)
+{
+    hashmap_release(&set->map);
+}
+
+void hashset_clear(struct hashset_t *set)
+{
+    hashmap_clear(&set->map);
+}
+
+int hashset_add(struct hashset_t *set, uint64_t key)
+{
+    return hashmap_put(&set->map, key, 0);
+}
+
+int hashset_contains(const struct hashset_t *set, uint64_t key)
+{
+    return table_find(&set->map, key) <= set->map.mask;
+}
+
+int hashset_remove(struct hashset_t *set, uint64_t key)
+{
+    return hashmap_remove(&set->map, key);
+}
+
+/*
+ * Names longer than a key are not supported; the unused high bytes are zero,
+ * so "ab" and "ab\0" are the same key.
+ */
+uint64_t hashmap_key_bytes(const char *bytes, size_t len)
+{
+    uint64_t key = 0;
+    for(size_t i = 0; i < len && i < sizeof(key); i++) {
+        key |= (uint64_t)(unsigned char)bytes[i] << (8 * i);
+    }
+
+    return key;
+}
+
+static void table_alloc(struct hashmap_t *map, size_t len)
+{
+    map->entries = (struct hashmap_entry_t *)malloc(sizeof(struct hashmap_entry_t) * len);
+    map->dists = (uint8_t *)calloc(len, sizeof(uint8_t));
+    if(map->entries == NULL || map->dists == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    unsigned int bits = 0;
+    while(((size_t)1 << bits) < len) {
+        bits++;
+    }
+
+    map->mask = len - 1;
+    map->shift = 64 - bits;
+    map->grow_at = len - len / 4;
+}
+
+static void table_resize(struct hashmap_t *map, size_t len)
+{
+    struct hashmap_entry_t *entries = map->entries;
+    uint8_t *dists = map->dists;
+    size_t old_len = map->mask + 1;
+
+    table_alloc(map, len);
+
+    for(size_t i = 0; i < old_len; i++) {
+        struct hashmap_entry_t entry = entries[i];
+        if(dists[i] != 0 && table_insert(map, &entry)) {
+            free(map->entries);
+            free(map->dists);
+
+            map->entries = entries;
+            map->dists = dists;
+            map->mask = old_len - 1;
+            table_resize(map, len * 2);
+            return;
+        }
+    }
+
+    free(entries);
+    free(dists);
+}
+
+/*
+ * Returns 1 if some entry would end up too far from its home slot, in which
+ * case that entry (not necessarily the one passed in) is left in *entry to be
+ * inserted again once the table has grown.
+ */
+static int table_insert(struct hashmap_t *map, struct hashmap_entry_t *entry)
+{
+    size_t i = table_home(map, entry->key);
+    unsigned int dist = 1;
+
+    while(1) {
+        if(map->dists[i] == 0) {
+            map->entries[i] = *entry;
+            map->dists[i] = (uint8_t)dist;
+            return 0;
+        }
+
+        if(map->dists[i] < dist) {
+            struct hashmap_entry_t tmp = map->entries[i];
+            unsigned int tmp_dist = map->dists[i];
+
+            map->entries[i] = *entry;
+            map->dists[i] = (uint8_t)dist;
+
+            *entry = tmp;
+            dist = tmp_dist;
+        }
+
+        if(dist == HASHMAP_MAX_DIST) {
+            return 1;
+        }
+
+        i = (i + 1) & map->mask;
+        dist++;
+    }
+}
+
+/*
+ * Fibonacci hashing: the top bits of the key times 2^64 / phi. The key is
+ * folded first so that both halves of a packed pair reach those bits.
+ */
+static size_t table_home(const struct hashmap_t *map, uint64_t key)
+{
+    key ^= key >> 32;
+
+    return (size_t)((key * HASHMAP_MUL) >> map->shift);
+}
+
+/*
+ * Returns the slot holding key, or a value past the end of the table.
+ */
+static size_t table_find(const struct hashmap_t *map, uint64_t key)
+{
+    size_t i = table_home(map, key);
+    unsigned int dist = 1;
+
+    while(map->dists[i] >= dist) {
+        if(map->entries[i].key == key) {
+            return i;
+        }
+
+        i = (i + 1) & map->mask;
+        dist++;
+    }
+
+    return map->mask + 1;
+}
@@ -0,0 +1,69 @@
+#ifndef AOC_HASHMAP_H
+#define AOC_HASHMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Open-addressing hash tables with robin-hood probing, for 64-bit integer
+ * keys. A small struct is packed into a key first: HASHMAP_KEY2() packs two
+ * 32-bit values (a coordinate, say), and hashmap_key_bytes() up to 8 bytes of
+ * a name.
+ *
+ * Entries live in one flat array next to a byte per slot holding how far the
+ * entry is from its home slot. On insert, an entry that is further from home
+ * than the one in its way takes that slot, so probe sequences stay short and
+ * a lookup stops as soon as it meets an entry closer to home than it would
+ * be. Removal shifts the entries that follow back by one instead of leaving
+ * tombstones.
+ *
+ * expected is a hint for how many entries the table will hold, so that it
+ * can be sized once; it grows by doubling either way. Running out of memory
+ * is fatal.
+ */
+#define HASHMAP_KEY2(a, b) (((uint64_t)(uint32_t)(a) << 32) | (uint64_t)(uint32_t)(b))
+
+struct hashmap_entry_t {
+    uint64_t key;
+    uint64_t value;
+};
+
+struct hashmap_t {
+    struct hashmap_entry_t *entries;
+    uint8_t *dists;
+    size_t mask;
+    unsigned int shift;
+    size_t len;
+    size_t grow_at;
+};
+
+/*
+ * A set is a map whose values are ignored.
+ */
+struct hashset_t {
+    struct hashmap_t map;
+};
+
+void hashmap_init(struct hashmap_t *map, size_t expected);
+void hashmap_release(struct hashmap_t *map);
+void hashmap_clear(struct hashmap_t *map);
+
+/*
+ * hashmap_put() adds or replaces the value for key, returning 1 if the key is
+ * new. hashmap_get() returns a pointer to the value for key, or NULL; it is
+ * only valid until the next put or remove, which may move entries.
+ */
+int hashmap_put(struct hashmap_t *map, uint64_t key, uint64_t value);
+uint64_t *hashmap_get(const struct hashmap_t *map, uint64_t key);
+int hashmap_remove(struct hashmap_t *map, uint64_t key);
+
+void hashset_init(struct hashset_t *set, size_t expected);
+void hashset_release(struct hashset_t *set);
+void hashset_clear(struct hashset_t *set);
+int hashset_add(struct hashset_t *set, uint64_t key);
+int hashset_contains(const struct hashset_t *set, uint64_t key);
+int hashset_remove(struct hashset_t *set, uint64_t key);
+
+uint64_t hashmap_key_bytes(const char *bytes, size_t len);
+
+#endif //AOC_HASHMAP_H
@@ -0,0 +1,338 @@
+/*
+ * For mremap().
+ */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include "hugemem.h"
+#include "memstat.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+/*
+ * From <numaif.h>, which comes with libnuma rather than the C library.
+ */
+#define NUMA_MPOL_BIND 2
+#endif
+
+static const char *const mode_names[HUGEMEM_MODES] = {"off", "thp", "hugetlb"};
+
+static pthread_once_t mode_once = PTHREAD_ONCE_INIT;
+static enum hugemem_mode_t mode = HUGEMEM_OFF;
+static int numa_local = 0;
+
+/*
+ * Set by the first failure of each kind, which is reported once.
+ */
+static int hugetlb_failed = 0;
+static int madvise_failed = 0;
+static int mbind_failed = 0;
+
+static void init_mode(void);
+static int is_mapped(size_t size);
+static size_t round_up(size_t value, size_t multiple);
+static void *map_huge(size_t len);
+static void *remap_huge(void *ptr, size_t old_len, size_t new_len);
+static void unmap_huge(void *ptr, size_t len);
+
+enum hugemem_mode_t hugemem_mode(void)
+{
+    pthread_once(&mode_once, init_mode);
+
+    return mode;
+}
+
+const char *hugemem_mode_name(enum hugemem_mode_t mode)
+{
+    return mode_names[mode];
+}
+
+int hugemem_numa_local(void)
+{
+    pthread_once(&mode_once, init_mode);
+
+    return numa_local;
+}
+
+void *hugemem_alloc(size_t size)
+{
+    if(is_mapped(size)) {
+        return map_huge(hugemem_usable_size(size));
+    }
+
+    void *ptr;
+    if(posix_memalign(&ptr, HUGEMEM_ALIGN, size > 0 ? size : 1) != 0) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return ptr;
+}
+
+/*
+ * A fresh mapping is already zeroed, and only its pages that are written get
+ * faulted in.
+ */
+void *hugemem_calloc(size_t size)
+{
+    void *ptr = hugemem_alloc(size);
+    if(!is_mapped(size)) {
+        memset(ptr, 0, size);
+    }
+
+    return ptr;
+}
+
+/*
+ * A mapping grows in place or moves without copying (mremap), and so does a
+ * large heap block (glibc's realloc() remaps those too), so a buffer that
+ * doubles as it fills is never resident twice.
+ */
+void *hugemem_realloc(void *ptr, size_t old_size, size_t new_size)
+{
+    if(ptr != NULL && is_mapped(old_size) && is_mapped(new_size)) {
+        return remap_huge(ptr, hugemem_usable_size(old_size), hugemem_usable_size(new_size));
+    }
+
+    if(ptr != NULL && !is_mapped(old_size) && !is_mapped(new_size)) {
+        uint8_t *new_ptr = (uint8_t *)realloc(ptr, new_size > 0 ? new_size : 1);
+        if(new_ptr == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        if(new_size > old_size) {
+            memset(new_ptr + old_size, 0, new_size - old_size);
+        }
+
+        return new_ptr;
+    }
+
+    void *new_ptr = hugemem_calloc(new_size);
+    if(ptr != NULL) {
+        memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+        hugemem_free(ptr, old_size);
+    }
+
+    return new_ptr;
+}
+
+void hugemem_free(void *ptr, size_t size)
+{
+    if(ptr == NULL) {
+        return;
+    }
+
+    if(is_mapped(size)) {
+        unmap_huge(ptr, hugemem_usable_size(size));
+    } else {
+        free(ptr);
+    }
+}
+
+size_t hugemem_usable_size(size_t size)
+{
+#ifdef __linux__
+    if(is_mapped(size)) {
+        return round_up(size, HUGE_PAGE_SIZE);
+    }
+#endif
+
+    return size;
+}
+
+static void init_mode(void)
+{
+    const char *forced = getenv("AOC_HUGEPAGES");
+    if(forced != NULL && *forced != 0) {
+        int found = 0;
+        for(int i = 0; i < HUGEMEM_MODES && !found; i++) {
+            if(strcmp(forced, mode_names[i]) == 0) {
+                mode = (enum hugemem_mode_t)i;
+                found = 1;
+            }
+        }
+
+        if(!found) {
+            fprintf(stderr, "Unexpected value for AOC_HUGEPAGES: %s (expected off, thp or hugetlb).\n", forced);
+            exit(1);
+        }
+    }
+
+    const char *numa = getenv("AOC_NUMA");
+    if(numa != NULL && *numa != 0) {
+        if(strcmp(numa, "local") == 0) {
+            numa_local = 1;
+        } else if(strcmp(numa, "off") != 0) {
+            fprintf(stderr, "Unexpected value for AOC_NUMA: %s (expected off or local).\n", numa);
+            exit(1);
+        }
+    }
+
+#ifndef __linux__
+    if(mode != HUGEMEM_OFF || numa_local) {
+        fprintf(stderr, "Note: huge pages and NUMA binding are only supported on Linux, using the heap.\n");
+        mode = HUGEMEM_OFF;
+        numa_local = 0;
+    }
+#endif
+}
+
+static int is_mapped(size_t size)
+{
+    return size >= HUGEMEM_MIN_SIZE && hugemem_mode() != HUGEMEM_OFF;
+}
+
+static size_t round_up(size_t value, size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+#ifdef __linux__
+
+/*
+ * Transparent huge pages only back whole, aligned 2 MiB ranges of a mapping,
+ * so a mapping one huge page longer is trimmed to the aligned part.
+ */
+static char *map_aligned(size_t len)
+{
+    size_t span = len + HUGE_PAGE_SIZE;
+    char *base = (char *)mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(base == MAP_FAILED) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    char *start = (char *)round_up((size_t)(uintptr_t)base, HUGE_PAGE_SIZE);
+    if(start > base) {
+        munmap(base, (size_t)(start - base));
+    }
+    if(start + len < base + span) {
+        munmap(start + len, (size_t)(base + span - (start + len)));
+    }
+
+    return start;
+}
+
+/*
+ * Asks for transparent huge pages (a no-op on reserved ones), and binds the
+ * range to the local node when AOC_NUMA says so.
+ */
+static void advise(void *ptr, size_t len)
+{
+    if(madvise(ptr, len, MADV_HUGEPAGE) != 0 && !__atomic_exchange_n(&madvise_failed, 1, __ATOMIC_RELAXED)) {
+        fprintf(stderr, "Note: transparent huge pages unavailable (%s), using small pages.\n", strerror(errno));
+    }
+
+    if(!numa_local) {
+        return;
+    }
+
+    unsigned int cpu, node;
+    unsigned long int nodes = 0;
+    int error = 0;
+    if(syscall(SYS_getcpu, &cpu, &node, NULL) != 0) {
+        error = errno;
+    } else if(node >= sizeof(nodes) * 8) {
+        error = ERANGE;
+    } else {
+        nodes = 1UL << node;
+        if(syscall(SYS_mbind, ptr, len, NUMA_MPOL_BIND, &nodes, sizeof(nodes) * 8 + 1, 0) != 0) {
+            error = errno;
+        }
+    }
+
+    if(error != 0 && !__atomic_exchange_n(&mbind_failed, 1, __ATOMIC_RELAXED)) {
+        fprintf(stderr, "Note: cannot bind to the local NUMA node (%s), leaving placement to the kernel.\n",
+                strerror(error));
+    }
+}
+
+static void *map_huge(size_t len)
+{
+    void *ptr = MAP_FAILED;
+
+    if(mode == HUGEMEM_HUGETLB && !__atomic_load_n(&hugetlb_failed, __ATOMIC_RELAXED)) {
+        ptr = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if(ptr == MAP_FAILED && !__atomic_exchange_n(&hugetlb_failed, 1, __ATOMIC_RELAXED)) {
+            fprintf(stderr, "Note: cannot map reserved huge pages (%s), using transparent huge pages instead.\n",
+                    strerror(errno));
+        }
+    }
+
+    if(ptr == MAP_FAILED) {
+        ptr = map_aligned(len);
+    }
+
+    advise(ptr, len);
+    memstat_mapped(len);
+
+    return ptr;
+}
+
+/*
+ * The pages are moved to a new aligned range, so the grown part can be huge
+ * pages too. A kernel that cannot move the mapping (reserved huge pages,
+ * before Linux 5.16) gets it copied instead.
+ */
+static void *remap_huge(void *ptr, size_t old_len, size_t new_len)
+{
+    if(new_len == old_len) {
+        return ptr;
+    }
+
+    char *target = map_aligned(new_len);
+    void *moved = mremap(ptr, old_len, new_len, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+    if(moved == MAP_FAILED) {
+        memcpy(target, ptr, old_len < new_len ? old_len : new_len);
+        munmap(ptr, old_len);
+    }
+
+    advise(target, new_len);
+    memstat_unmapped(old_len);
+    memstat_mapped(new_len);
+
+    return target;
+}
+
+static void unmap_huge(void *ptr, size_t len)
+{
+    munmap(ptr, len);
+    memstat_unmapped(len);
+}
+
+#else
+
+static void *map_huge(size_t len)
+{
+    (void)len;
+
+    return NULL;
+}
+
+static void *remap_huge(void *ptr, size_t old_len, size_t new_len)
+{
+    (void)old_len;
+    (void)new_len;
+
+    return ptr;
+}
+
+static void unmap_huge(void *ptr, size_t len)
+{
+    (void)ptr;
+    (void)len;
+}
+
+#endif //__linux__
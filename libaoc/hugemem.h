@@ -0,0 +1,59 @@
+#ifndef AOC_HUGEMEM_H
+#define AOC_HUGEMEM_H
+
+#include <stddef.h>
+
+#define HUGEMEM_MIN_SIZE (2 * 1024 * 1024)
+#define HUGEMEM_ALIGN 64
+
+/*
+ * Backing for large solver buffers (grids, arena blocks, day14's scores),
+ * whose random accesses miss the TLB on every other load when they sit on
+ * 4 KiB pages. AOC_HUGEPAGES picks how a buffer of at least HUGEMEM_MIN_SIZE
+ * bytes is mapped:
+ *
+ *  - off (the default): from the heap, like any other buffer.
+ *  - thp: an anonymous mapping aligned to 2 MiB and marked MADV_HUGEPAGE, so
+ *    the kernel backs it with transparent huge pages even when they are only
+ *    enabled on request (/sys/kernel/mm/transparent_hugepage/enabled set to
+ *    madvise).
+ *  - hugetlb: reserved huge pages (MAP_HUGETLB), which never fall back to
+ *    small pages once mapped; when none are reserved (vm.nr_hugepages is 0)
+ *    it says so once and uses thp instead.
+ *
+ * Setting AOC_NUMA to local also binds each mapping to the NUMA node of the
+ * CPU that allocated it (mbind with MPOL_BIND), for machines where a solver
+ * would otherwise get memory from a remote node. Smaller buffers always come
+ * from the heap. Memory is aligned to HUGEMEM_ALIGN bytes, and mappings are
+ * counted by memstat like heap blocks.
+ */
+enum hugemem_mode_t {
+    HUGEMEM_OFF,
+    HUGEMEM_THP,
+    HUGEMEM_HUGETLB,
+    HUGEMEM_MODES
+};
+
+enum hugemem_mode_t hugemem_mode(void);
+const char *hugemem_mode_name(enum hugemem_mode_t mode);
+int hugemem_numa_local(void);
+
+/*
+ * hugemem_alloc() leaves the memory as it comes, hugemem_calloc() zeroes it.
+ * Running out of memory is fatal. A buffer is freed with the size it was
+ * allocated with, and hugemem_realloc() keeps the first old_size bytes and
+ * zeroes the rest. A small buffer that realloc() moves only keeps malloc()'s
+ * own alignment.
+ */
+void *hugemem_alloc(size_t size);
+void *hugemem_calloc(size_t size);
+void *hugemem_realloc(void *ptr, size_t old_size, size_t new_size);
+void hugemem_free(void *ptr, size_t size);
+
+/*
+ * How much of a buffer of the given size can be used: a mapping is a whole
+ * number of huge pages, and an arena asking for one block can have it all.
+ */
+size_t hugemem_usable_size(size_t size);
+
+#endif //AOC_HUGEMEM_H
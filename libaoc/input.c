@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "input.h"
+#include "trace.h"
+
+static int input_map(struct input_t *input, FILE *stream);
+static void input_slurp(struct input_t *input, FILE *stream);
+static int is_blank(char c);
+
+void input_open(struct input_t *input, FILE *stream)
+{
+    input->data = NULL;
+    input->len = 0;
+    input->pos = 0;
+    input->mapped = 0;
+
+    TRACE_BEGIN(input_open);
+    if(!input_map(input, stream)) {
+        input_slurp(input, stream);
+    }
+    TRACE_END(input_open);
+    TRACE_COUNT(input_bytes, input->len);
+}
+
+void input_release(struct input_t *input)
+{
+    if(input->mapped) {
+        munmap((void *)input->data, input->len);
+    } else {
+        free((void *)input->data);
+    }
+
+    input->data = NULL;
+    input->len = 0;
+    input->pos = 0;
+    input->mapped = 0;
+}
+
+/*
+ * Returns the next line without its line terminator, or 0 once the input is
+ * exhausted. A last line without a trailing newline is still returned.
+ */
+int input_next_line(struct input_t *input, struct view_t *line)
+{
+    if(input->pos >= input->len) {
+        return 0;
+    }
+
+    const char *start = input->data + input->pos;
+    size_t remaining = input->len - input->pos;
+
+    const char *lf = memchr(start, '\n', remaining);
+    size_t len = lf != NULL ? (size_t)(lf - start) : remaining;
+
+    input->pos += lf != NULL ? len + 1 : len;
+
+    if(len > 0 && start[len - 1] == '\r') {
+        len--;
+    }
+
+    line->ptr = start;
+    line->len = len;
+
+    return 1;
+}
+
+/*
+ * Returns the next run of characters delimited by whitespace, or 0 once the
+ * input is exhausted.
+ */
+int input_next_token(struct input_t *input, struct view_t *token)
+{
+    while(input->pos < input->len && (is_blank(input->data[input->pos]) || input->data[input->pos] == '\n' || input->data[input->pos] == '\r')) {
+        input->pos++;
+    }
+
+    if(input->pos >= input->len) {
+        return 0;
+    }
+
+    size_t start = input->pos;
+    while(input->pos < input->len && !is_blank(input->data[input->pos]) && input->data[input->pos] != '\n' && input->data[input->pos] != '\r') {
+        input->pos++;
+    }
+
+    token->ptr = input->data + start;
+    token->len = input->pos - start;
+
+    return 1;
+}
+
+/*
+ * Hands out everything not yet consumed as a single view, for parsers that
+ * scan the whole input at once.
+ */
+void input_remaining(struct input_t *input, struct view_t *rest)
+{
+    rest->ptr = input->data + input->pos;
+    rest->len = input->len - input->pos;
+
+    input->pos = input->len;
+}
+
+int view_expect(struct view_t *view, const char *literal)
+{
+    size_t len = strlen(literal);
+    if(view->len < len || memcmp(view->ptr, literal, len) != 0) {
+        return 1;
+    }
+
+    view->ptr += len;
+    view->len -= len;
+
+    return 0;
+}
+
+int view_skip_past(struct view_t *view, char c)
+{
+    const char *found = memchr(view->ptr, c, view->len);
+    if(found == NULL) {
+        return 1;
+    }
+
+    view->len -= (size_t)(found - view->ptr) + 1;
+    view->ptr = found + 1;
+
+    return 0;
+}
+
+/*
+ * Parses a decimal integer with an optional sign, skipping leading blanks the
+ * way strtol() does.
+ */
+int view_parse_long(struct view_t *view, long int *value)
+{
+    size_t i = 0;
+    while(i < view->len && is_blank(view->ptr[i])) {
+        i++;
+    }
+
+    int negative = 0;
+    if(i < view->len && (view->ptr[i] == '-' || view->ptr[i] == '+')) {
+        negative = view->ptr[i] == '-';
+        i++;
+    }
+
+    size_t digits_start = i;
+    unsigned long int magnitude = 0;
+    while(i < view->len && view->ptr[i] >= '0' && view->ptr[i] <= '9') {
+        magnitude = magnitude * 10 + (unsigned long int)(view->ptr[i] - '0');
+        i++;
+    }
+
+    if(i == digits_start) {
+        return 1;
+    }
+
+    *value = negative ? -(long int)magnitude : (long int)magnitude;
+    view->ptr += i;
+    view->len -= i;
+
+    return 0;
+}
+
+static int input_map(struct input_t *input, FILE *stream)
+{
+    int fd = fileno(stream);
+    if(fd < 0) {
+        return 0;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+        return 0;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(data == MAP_FAILED) {
+        return 0;
+    }
+
+    madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    /*
+     * Anything already consumed through the stream is skipped, so the input
+     * picks up exactly where the stream left off.
+     */
+    long int offset = ftell(stream);
+
+    input->data = (const char *)data;
+    input->len = (size_t)st.st_size;
+    input->pos = offset > 0 && (size_t)offset <= input->len ? (size_t)offset : 0;
+    input->mapped = 1;
+
+    return 1;
+}
+
+static void input_slurp(struct input_t *input, FILE *stream)
+{
+    size_t buff_len = INPUT_DEFAULT_BUFF_LEN;
+    size_t buff_index = 0;
+    char *buffer = (char *)malloc(sizeof(char) * buff_len);
+    if(buffer == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t read;
+    while((read = fread(buffer + buff_index, 1, buff_len - buff_index, stream)) > 0) {
+        buff_index += read;
+        if(buff_index == buff_len) {
+            buff_len *= 2;
+            buffer = (char *)realloc(buffer, sizeof(char) * buff_len);
+            if(buffer == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    if(ferror(stream)) {
+        perror("Fatal error: Cannot read input.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    input->data = buffer;
+    input->len = buff_index;
+    input->pos = 0;
+    input->mapped = 0;
+}
+
+static int is_blank(char c)
+{
+    return c == ' ' || c == '\t';
+}
@@ -0,0 +1,48 @@
+#ifndef AOC_INPUT_H
+#define AOC_INPUT_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define INPUT_DEFAULT_BUFF_LEN (64 * 1024)
+
+/*
+ * The whole puzzle input, held in memory. A stream backed by a regular file
+ * is mapped; anything else (a pipe, a terminal, a memory stream) is read into
+ * a single buffer that doubles in size as it fills.
+ *
+ * Lines and tokens are handed out in order as views into that memory, so
+ * nothing is copied and there is no limit on the length of a line. Failing to
+ * read the input is fatal.
+ */
+struct input_t {
+    const char *data;
+    size_t len;
+    size_t pos;
+    int mapped;
+};
+
+/*
+ * A (ptr, len) slice of the input. Views are not NUL-terminated, and are only
+ * valid until the input they came from is released.
+ */
+struct view_t {
+    const char *ptr;
+    size_t len;
+};
+
+void input_open(struct input_t *input, FILE *stream);
+void input_release(struct input_t *input);
+int input_next_line(struct input_t *input, struct view_t *line);
+int input_next_token(struct input_t *input, struct view_t *token);
+void input_remaining(struct input_t *input, struct view_t *rest);
+
+/*
+ * Parsing helpers that consume a view from the front. Each returns 0 on
+ * success, or 1 and leaves the view untouched if its input does not match.
+ */
+int view_expect(struct view_t *view, const char *literal);
+int view_skip_past(struct view_t *view, char c);
+int view_parse_long(struct view_t *view, long int *value);
+
+#endif //AOC_INPUT_H
@@ -0,0 +1,214 @@
+#include <errno.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <malloc.h>
+
+#include "memstat.h"
+
+/*
+ * The C library's own entry points, which the wrappers below forward to.
+ * glibc exports these precisely so that malloc can be interposed this way.
+ */
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void *ptr);
+
+struct memstat_thread_t {
+    uint64_t allocs;
+    uint64_t bytes;
+    int64_t live_bytes;
+    int64_t peak_bytes;
+};
+
+static int memstat_enabled = 0;
+
+/*
+ * initial-exec so that touching it never allocates, which would recurse.
+ */
+static __thread struct memstat_thread_t memstat_thread __attribute__((tls_model("initial-exec")));
+
+static void count_size(size_t size);
+
+static inline int memstat_counting(void)
+{
+    return __atomic_load_n(&memstat_enabled, __ATOMIC_RELAXED);
+}
+
+static void count_alloc(void *ptr)
+{
+    count_size(malloc_usable_size(ptr));
+}
+
+static void count_size(size_t size)
+{
+    memstat_thread.allocs++;
+    memstat_thread.bytes += size;
+    memstat_thread.live_bytes += (int64_t)size;
+    if(memstat_thread.live_bytes > memstat_thread.peak_bytes) {
+        memstat_thread.peak_bytes = memstat_thread.live_bytes;
+    }
+}
+
+static void count_free(void *ptr)
+{
+    memstat_thread.live_bytes -= (int64_t)malloc_usable_size(ptr);
+}
+
+int memstat_start(void)
+{
+    __atomic_store_n(&memstat_enabled, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+void memstat_stop(void)
+{
+    __atomic_store_n(&memstat_enabled, 0, __ATOMIC_RELAXED);
+}
+
+void memstat_reset(void)
+{
+    memstat_thread.allocs = 0;
+    memstat_thread.bytes = 0;
+    memstat_thread.live_bytes = 0;
+    memstat_thread.peak_bytes = 0;
+}
+
+/*
+ * Adds everything since the previous lap to stat. The peak of the next lap
+ * starts from what is live now, so a phase is charged for memory it inherits.
+ */
+void memstat_lap(struct memstat_t *stat)
+{
+    stat->allocs += memstat_thread.allocs;
+    stat->bytes += memstat_thread.bytes;
+    if(memstat_thread.peak_bytes > 0 && (uint64_t)memstat_thread.peak_bytes > stat->peak_bytes) {
+        stat->peak_bytes = (uint64_t)memstat_thread.peak_bytes;
+    }
+
+    memstat_thread.allocs = 0;
+    memstat_thread.bytes = 0;
+    memstat_thread.peak_bytes = memstat_thread.live_bytes;
+}
+
+void memstat_mapped(size_t size)
+{
+    if(memstat_counting()) {
+        count_size(size);
+    }
+}
+
+void memstat_unmapped(size_t size)
+{
+    if(memstat_counting()) {
+        memstat_thread.live_bytes -= (int64_t)size;
+    }
+}
+
+void *malloc(size_t size)
+{
+    void *ptr = __libc_malloc(size);
+    if(ptr != NULL && memstat_counting()) {
+        count_alloc(ptr);
+    }
+
+    return ptr;
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    void *ptr = __libc_calloc(nmemb, size);
+    if(ptr != NULL && memstat_counting()) {
+        count_alloc(ptr);
+    }
+
+    return ptr;
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    if(!memstat_counting()) {
+        return __libc_realloc(ptr, size);
+    }
+
+    size_t old_size = ptr != NULL ? malloc_usable_size(ptr) : 0;
+
+    void *new_ptr = __libc_realloc(ptr, size);
+    if(new_ptr != NULL || size == 0) {
+        memstat_thread.live_bytes -= (int64_t)old_size;
+    }
+    if(new_ptr != NULL) {
+        count_alloc(new_ptr);
+    }
+
+    return new_ptr;
+}
+
+void free(void *ptr)
+{
+    if(ptr != NULL && memstat_counting()) {
+        count_free(ptr);
+    }
+
+    __libc_free(ptr);
+}
+
+void *memalign(size_t alignment, size_t size)
+{
+    void *ptr = __libc_memalign(alignment, size);
+    if(ptr != NULL && memstat_counting()) {
+        count_alloc(ptr);
+    }
+
+    return ptr;
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    return memalign(alignment, size);
+}
+
+/*
+ * glibc's own versions of these call its internal allocator directly, so
+ * their blocks would go uncounted and then be subtracted when freed.
+ */
+void *reallocarray(void *ptr, size_t nmemb, size_t size)
+{
+    size_t total;
+    if(__builtin_mul_overflow(nmemb, size, &total)) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    return realloc(ptr, total);
+}
+
+void *valloc(size_t size)
+{
+    return memalign((size_t)sysconf(_SC_PAGESIZE), size);
+}
+
+void *pvalloc(size_t size)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+    return memalign(page, (size + page - 1) / page * page);
+}
+
+int posix_memalign(void **memptr, size_t alignment, size_t size)
+{
+    if(alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+
+    void *ptr = memalign(alignment, size);
+    if(ptr == NULL) {
+        return ENOMEM;
+    }
+
+    *memptr = ptr;
+    return 0;
+}
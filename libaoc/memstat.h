@@ -0,0 +1,70 @@
+#ifndef AOC_MEMSTAT_H
+#define AOC_MEMSTAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Heap accounting. When the project is configured with -DAOC_MEMSTAT=ON (off
+ * by default) libaoc replaces malloc, calloc, realloc, reallocarray, free and
+ * the aligned and page allocators with thin wrappers around the C library's,
+ * which count once memstat_start() has been called and cost one branch until
+ * then. Sanitizers and valgrind interpose malloc too, so configuring refuses
+ * to combine it with -fsanitize.
+ *
+ * Counts are kept per thread, so solvers running side by side do not mix.
+ * Bytes are the usable size of each block as the allocator reports it, a
+ * little above what was asked for. Live bytes are relative to the last
+ * memstat_reset(), which answer_init() calls before every solve.
+ *
+ * Memory mapped outside the heap (see hugemem.h) is counted through
+ * memstat_mapped() and memstat_unmapped(), by the length of the mapping.
+ */
+struct memstat_t {
+    uint64_t allocs;
+    uint64_t bytes;
+    uint64_t peak_bytes;
+};
+
+#ifdef AOC_MEMSTAT
+
+int memstat_start(void);
+void memstat_stop(void);
+void memstat_reset(void);
+void memstat_lap(struct memstat_t *stat);
+void memstat_mapped(size_t size);
+void memstat_unmapped(size_t size);
+
+#else
+
+static inline int memstat_start(void)
+{
+    return 1;
+}
+
+static inline void memstat_stop(void)
+{
+}
+
+static inline void memstat_reset(void)
+{
+}
+
+static inline void memstat_lap(struct memstat_t *stat)
+{
+    (void)stat;
+}
+
+static inline void memstat_mapped(size_t size)
+{
+    (void)size;
+}
+
+static inline void memstat_unmapped(size_t size)
+{
+    (void)size;
+}
+
+#endif //AOC_MEMSTAT
+
+#endif //AOC_MEMSTAT_H
@@ -0,0 +1,418 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "parallel.h"
+#include "threadpool.h"
+
+/*
+ * Each split halves a range, so a deque never holds more ranges than there are
+ * bits in size_t.
+ */
+#define DEQUE_LEN 128
+#define CACHE_LINE 64
+#define NO_WORKER SIZE_MAX
+
+struct parallel_range_t {
+    size_t begin;
+    size_t end;
+};
+
+/*
+ * The owner pushes and pops at the bottom, thieves take from the top. Indices
+ * only ever grow and are taken modulo DEQUE_LEN.
+ */
+struct parallel_worker_t {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    struct parallel_range_t ranges[DEQUE_LEN];
+    size_t top;
+    size_t bottom;
+    unsigned int seed;
+} __attribute__((aligned(CACHE_LINE)));
+
+struct parallel_job_t {
+    parallel_body_t body;
+    parallel_reduce_body_t reduce_body;
+    void *ctx;
+    size_t grain;
+    size_t total;
+    size_t done;
+    char *accs;
+    size_t acc_stride;
+};
+
+/*
+ * Worker 0 is whichever thread calls parallel_for(); the pool only starts
+ * threads for the others. One loop runs at a time, guarded by busy.
+ */
+struct parallel_pool_t {
+    struct parallel_worker_t *workers;
+    size_t workers_len;
+    pthread_mutex_t busy;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t finished;
+    uint64_t generation;
+    size_t workers_finished;
+    int stopping;
+    struct parallel_job_t job;
+};
+
+static struct parallel_pool_t parallel_pool;
+static size_t parallel_threads_len = 1;
+
+static __thread size_t current_worker = NO_WORKER;
+static __thread void *scratch = NULL;
+static __thread size_t scratch_len = 0;
+
+static void *alloc_lines(size_t size);
+static void *parallel_worker(void *arg);
+static void run(size_t begin, size_t end, size_t grain, parallel_body_t body, parallel_reduce_body_t reduce_body,
+        void *ctx, char *accs, size_t acc_stride);
+static void run_job(struct parallel_job_t *job, size_t worker);
+static void push_range(struct parallel_worker_t *worker, struct parallel_range_t range);
+static int pop_range(struct parallel_worker_t *worker, struct parallel_range_t *range);
+static int steal_range(size_t thief, struct parallel_range_t *range);
+
+/*
+ * threads of 0 means one per online core. A single thread starts nothing.
+ */
+void parallel_init(size_t threads)
+{
+    if(threads == 0) {
+        threads = threadpool_default_threads();
+    }
+
+    parallel_release();
+    parallel_threads_len = threads;
+    if(threads < 2) {
+        return;
+    }
+
+    struct parallel_pool_t *pool = &parallel_pool;
+
+    pool->workers_len = threads;
+    pool->workers = (struct parallel_worker_t *)alloc_lines(sizeof(struct parallel_worker_t) * threads);
+
+    pool->generation = 0;
+    pool->workers_finished = 0;
+    pool->stopping = 0;
+
+    pthread_mutex_init(&pool->busy, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->finished, NULL);
+
+    for(size_t i = 0; i < threads; i++) {
+        struct parallel_worker_t *worker = &pool->workers[i];
+
+        pthread_mutex_init(&worker->lock, NULL);
+        worker->top = 0;
+        worker->bottom = 0;
+        worker->seed = (unsigned int)i * 2654435761u + 1;
+    }
+
+    for(size_t i = 1; i < threads; i++) {
+        if(pthread_create(&pool->workers[i].thread, NULL, parallel_worker, (void *)i) != 0) {
+            fprintf(stderr, "Fatal error: Cannot create thread.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+size_t parallel_threads(void)
+{
+    return parallel_threads_len;
+}
+
+void parallel_for(size_t begin, size_t end, size_t grain, parallel_body_t body, void *ctx)
+{
+    run(begin, end, grain, body, NULL, ctx, NULL, 0);
+}
+
+void parallel_reduce(size_t begin, size_t end, size_t grain, parallel_reduce_body_t body, parallel_combine_t combine,
+        void *ctx, void *result, size_t result_size)
+{
+    if(parallel_threads_len < 2 || current_worker != NO_WORKER) {
+        if(begin < end) {
+            body(ctx, begin, end, result);
+        }
+        return;
+    }
+
+    size_t acc_stride = (result_size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    char *accs = (char *)alloc_lines(acc_stride * parallel_pool.workers_len);
+
+    for(size_t i = 0; i < parallel_pool.workers_len; i++) {
+        memcpy(accs + i * acc_stride, result, result_size);
+    }
+
+    run(begin, end, grain, NULL, body, ctx, accs, acc_stride);
+
+    for(size_t i = 0; i < parallel_pool.workers_len; i++) {
+        combine(ctx, result, accs + i * acc_stride);
+    }
+
+    free(accs);
+}
+
+/*
+ * The buffer is kept between calls on the same thread and only grows, so a
+ * body can ask for it on every range without allocating each time.
+ */
+void *parallel_scratch(size_t size)
+{
+    if(size > scratch_len) {
+        free(scratch);
+
+        scratch = malloc(size);
+        if(scratch == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        scratch_len = size;
+    }
+
+    return scratch;
+}
+
+/*
+ * Stops the pool, if any, and frees the calling thread's scratch memory.
+ */
+void parallel_release(void)
+{
+    free(scratch);
+    scratch = NULL;
+    scratch_len = 0;
+
+    if(parallel_threads_len < 2) {
+        return;
+    }
+
+    struct parallel_pool_t *pool = &parallel_pool;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for(size_t i = 1; i < pool->workers_len; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    for(size_t i = 0; i < pool->workers_len; i++) {
+        pthread_mutex_destroy(&pool->workers[i].lock);
+    }
+
+    pthread_mutex_destroy(&pool->busy);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    pthread_cond_destroy(&pool->finished);
+
+    free(pool->workers);
+    pool->workers = NULL;
+    pool->workers_len = 0;
+
+    parallel_threads_len = 1;
+}
+
+/*
+ * Cache line aligned, so that workers never write to the same line.
+ */
+static void *alloc_lines(size_t size)
+{
+    void *ptr;
+    if(posix_memalign(&ptr, CACHE_LINE, size) != 0) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return ptr;
+}
+
+static void *parallel_worker(void *arg)
+{
+    struct parallel_pool_t *pool = &parallel_pool;
+    size_t worker = (size_t)arg;
+    uint64_t seen = 0;
+
+    current_worker = worker;
+
+    pthread_mutex_lock(&pool->lock);
+    while(1) {
+        while(pool->generation == seen && !pool->stopping) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+
+        if(pool->stopping) {
+            break;
+        }
+
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        run_job(&pool->job, worker);
+
+        pthread_mutex_lock(&pool->lock);
+        if(++pool->workers_finished == pool->workers_len - 1) {
+            pthread_cond_signal(&pool->finished);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    free(scratch);
+
+    return NULL;
+}
+
+static void run(size_t begin, size_t end, size_t grain, parallel_body_t body, parallel_reduce_body_t reduce_body,
+        void *ctx, char *accs, size_t acc_stride)
+{
+    struct parallel_pool_t *pool = &parallel_pool;
+
+    if(begin >= end) {
+        return;
+    }
+
+    if(grain == 0) {
+        grain = 1;
+    }
+
+    if(parallel_threads_len < 2 || current_worker != NO_WORKER || pthread_mutex_trylock(&pool->busy) != 0) {
+        if(body != NULL) {
+            body(ctx, begin, end);
+        } else {
+            reduce_body(ctx, begin, end, accs);
+        }
+        return;
+    }
+
+    struct parallel_job_t *job = &pool->job;
+    job->body = body;
+    job->reduce_body = reduce_body;
+    job->ctx = ctx;
+    job->grain = grain;
+    job->total = end - begin;
+    job->done = 0;
+    job->accs = accs;
+    job->acc_stride = acc_stride;
+
+    struct parallel_range_t range = {.begin = begin, .end = end};
+    push_range(&pool->workers[0], range);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->workers_finished = 0;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    current_worker = 0;
+    run_job(job, 0);
+    current_worker = NO_WORKER;
+
+    /*
+     * Every worker has to be done with this job before the next one can
+     * overwrite it, even those that woke up too late to find anything left.
+     */
+    pthread_mutex_lock(&pool->lock);
+    while(pool->workers_finished < pool->workers_len - 1) {
+        pthread_cond_wait(&pool->finished, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_mutex_unlock(&pool->busy);
+}
+
+static void run_job(struct parallel_job_t *job, size_t worker)
+{
+    struct parallel_worker_t *self = &parallel_pool.workers[worker];
+
+    while(__atomic_load_n(&job->done, __ATOMIC_ACQUIRE) < job->total) {
+        struct parallel_range_t range;
+        if(!pop_range(self, &range) && !steal_range(worker, &range)) {
+            sched_yield();
+            continue;
+        }
+
+        while(range.end - range.begin > job->grain) {
+            size_t mid = range.begin + (range.end - range.begin) / 2;
+            struct parallel_range_t upper = {.begin = mid, .end = range.end};
+
+            push_range(self, upper);
+            range.end = mid;
+        }
+
+        if(job->body != NULL) {
+            job->body(job->ctx, range.begin, range.end);
+        } else {
+            job->reduce_body(job->ctx, range.begin, range.end, job->accs + worker * job->acc_stride);
+        }
+
+        __atomic_add_fetch(&job->done, range.end - range.begin, __ATOMIC_ACQ_REL);
+    }
+}
+
+static void push_range(struct parallel_worker_t *worker, struct parallel_range_t range)
+{
+    pthread_mutex_lock(&worker->lock);
+    worker->ranges[worker->bottom % DEQUE_LEN] = range;
+    worker->bottom++;
+    pthread_mutex_unlock(&worker->lock);
+}
+
+static int pop_range(struct parallel_worker_t *worker, struct parallel_range_t *range)
+{
+    int found = 0;
+
+    pthread_mutex_lock(&worker->lock);
+    if(worker->bottom > worker->top) {
+        worker->bottom--;
+        *range = worker->ranges[worker->bottom % DEQUE_LEN];
+        found = 1;
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    return found;
+}
+
+/*
+ * Tries every other worker once, starting from a random one so that thieves
+ * spread out instead of all raiding worker 0.
+ */
+static int steal_range(size_t thief, struct parallel_range_t *range)
+{
+    struct parallel_pool_t *pool = &parallel_pool;
+    struct parallel_worker_t *self = &pool->workers[thief];
+
+    self->seed = self->seed * 1103515245u + 12345u;
+    size_t start = (size_t)(self->seed >> 16) % pool->workers_len;
+
+    for(size_t i = 0; i < pool->workers_len; i++) {
+        size_t victim_index = (start + i) % pool->workers_len;
+        if(victim_index == thief) {
+            continue;
+        }
+
+        struct parallel_worker_t *victim = &pool->workers[victim_index];
+        int found = 0;
+
+        pthread_mutex_lock(&victim->lock);
+        if(victim->bottom > victim->top) {
+            *range = victim->ranges[victim->top % DEQUE_LEN];
+            victim->top++;
+            found = 1;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if(found) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+#ifndef AOC_PARALLEL_H
+#define AOC_PARALLEL_H
+
+#include <stddef.h>
+
+/*
+ * Data parallelism for solvers. parallel_init() starts a process-wide pool
+ * (the --threads flag of every aocd# does this), and parallel_for() and
+ * parallel_reduce() then split a range of indices across it. Without a pool,
+ * or when called from inside another parallel body or while another thread's
+ * loop holds the pool, they run the whole range on the calling thread, so a
+ * solver is correct whether or not the user opted in.
+ *
+ * Ranges are split in halves down to at most grain indices. Every worker keeps
+ * its halves on a deque of its own, runs the most recent ones first, and once
+ * it runs out steals the oldest (and largest) range from another worker, which
+ * keeps uneven iterations balanced without any tuning.
+ *
+ * parallel_reduce() gives every worker its own copy of *result as the
+ * accumulator its bodies add to, then folds them into *result with combine().
+ * Which indices end up in which accumulator varies from run to run, so
+ * combine() must be associative and commutative for the answer not to. As
+ * every worker starts from *result, it is folded in once per worker as well:
+ * it must hold combine()'s identity (0 for a sum), or a value combine() can
+ * take any number of times, as a minimum or maximum can.
+ *
+ * parallel_scratch() is per-thread scratch memory, for bodies that need a
+ * buffer per worker rather than per iteration.
+ */
+typedef void (*parallel_body_t)(void *ctx, size_t begin, size_t end);
+typedef void (*parallel_reduce_body_t)(void *ctx, size_t begin, size_t end, void *acc);
+typedef void (*parallel_combine_t)(void *ctx, void *acc, const void *other);
+
+void parallel_init(size_t threads);
+size_t parallel_threads(void);
+void parallel_for(size_t begin, size_t end, size_t grain, parallel_body_t body, void *ctx);
+void parallel_reduce(size_t begin, size_t end, size_t grain, parallel_reduce_body_t body, parallel_combine_t combine,
+        void *ctx, void *result, size_t result_size);
+void *parallel_scratch(size_t size);
+void parallel_release(void);
+
+#endif //AOC_PARALLEL_H
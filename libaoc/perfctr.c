@@ -0,0 +1,240 @@
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include "perfctr.h"
+
+const char *const perfctr_event_names[PERFCTR_EVENTS] = {"cycles",     "instructions",  "l1d_misses",
+                                                         "llc_misses", "branch_misses", "dtlb_misses"};
+
+#ifdef __linux__
+
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#define ERROR_LEN 128
+
+struct perfctr_event_info_t {
+    uint32_t type;
+    uint64_t config;
+};
+
+static const struct perfctr_event_info_t events[PERFCTR_EVENTS] = {
+    [PERFCTR_CYCLES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    [PERFCTR_INSTRUCTIONS] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    [PERFCTR_L1D_MISSES] = {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    [PERFCTR_LLC_MISSES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    [PERFCTR_BRANCH_MISSES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    [PERFCTR_DTLB_MISSES] = {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)}
+};
+
+/*
+ * slot is the event's position among the group's values, or -1 when the
+ * event could not be opened. The first event, cycles, leads the group.
+ * stale is set while last holds no counts, after a read failed.
+ */
+struct perfctr_thread_t {
+    int active;
+    int fds[PERFCTR_EVENTS];
+    int slot[PERFCTR_EVENTS];
+    int members;
+    int stale;
+    uint64_t last[PERFCTR_EVENTS];
+};
+
+static __thread struct perfctr_thread_t perfctr_thread;
+static char perfctr_error_buff[ERROR_LEN] = "not started";
+
+static int open_event(enum perfctr_event_t event, int group_fd);
+static int read_group(uint64_t values[PERFCTR_EVENTS]);
+static void explain(int err);
+
+int perfctr_start(void)
+{
+    struct perfctr_thread_t *thread = &perfctr_thread;
+    if(thread->active) {
+        return 0;
+    }
+
+    thread->fds[PERFCTR_CYCLES] = open_event(PERFCTR_CYCLES, -1);
+    if(thread->fds[PERFCTR_CYCLES] < 0) {
+        explain(errno);
+        return 1;
+    }
+
+    thread->slot[PERFCTR_CYCLES] = 0;
+    thread->members = 1;
+
+    for(int event = PERFCTR_CYCLES + 1; event < PERFCTR_EVENTS; event++) {
+        thread->fds[event] = open_event((enum perfctr_event_t)event, thread->fds[PERFCTR_CYCLES]);
+        thread->slot[event] = thread->fds[event] < 0 ? -1 : thread->members++;
+    }
+
+    ioctl(thread->fds[PERFCTR_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(thread->fds[PERFCTR_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+    thread->active = 1;
+    perfctr_reset();
+
+    return 0;
+}
+
+void perfctr_stop(void)
+{
+    struct perfctr_thread_t *thread = &perfctr_thread;
+    if(!thread->active) {
+        return;
+    }
+
+    for(int event = PERFCTR_EVENTS - 1; event >= 0; event--) {
+        if(thread->fds[event] >= 0) {
+            close(thread->fds[event]);
+        }
+    }
+
+    thread->active = 0;
+}
+
+const char *perfctr_error(void)
+{
+    return perfctr_error_buff;
+}
+
+void perfctr_reset(void)
+{
+    if(!perfctr_thread.active) {
+        return;
+    }
+
+    uint64_t values[PERFCTR_EVENTS];
+    perfctr_thread.stale = read_group(values);
+    if(perfctr_thread.stale) {
+        return;
+    }
+
+    for(int event = 0; event < PERFCTR_EVENTS; event++) {
+        if(perfctr_thread.slot[event] >= 0) {
+            perfctr_thread.last[event] = values[perfctr_thread.slot[event]];
+        }
+    }
+}
+
+/*
+ * A pinned group the PMU could not fit is put in an error state and reads
+ * nothing, which leaves the whole lap missing. So is the lap after it, which
+ * has nothing to count from: its read only becomes the start of the next one.
+ */
+void perfctr_lap(struct perfctr_t *counts)
+{
+    struct perfctr_thread_t *thread = &perfctr_thread;
+    if(!thread->active) {
+        return;
+    }
+
+    uint64_t values[PERFCTR_EVENTS];
+    int failed = read_group(values);
+    int stale = thread->stale;
+    thread->stale = failed;
+
+    for(int event = 0; event < PERFCTR_EVENTS; event++) {
+        if(failed || thread->slot[event] < 0) {
+            counts->counts[event] = PERFCTR_MISSING;
+            continue;
+        }
+
+        uint64_t value = values[thread->slot[event]];
+        if(stale) {
+            counts->counts[event] = PERFCTR_MISSING;
+        } else if(counts->counts[event] != PERFCTR_MISSING) {
+            counts->counts[event] += value - thread->last[event];
+        }
+        thread->last[event] = value;
+    }
+}
+
+static int open_event(enum perfctr_event_t event, int group_fd)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = events[event].type;
+    attr.config = events[event].config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    if(group_fd < 0) {
+        attr.disabled = 1;
+        attr.pinned = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+    }
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+}
+
+static int read_group(uint64_t values[PERFCTR_EVENTS])
+{
+    uint64_t buff[PERFCTR_EVENTS + 1];
+    size_t expected = sizeof(uint64_t) * (perfctr_thread.members + 1);
+
+    ssize_t len = read(perfctr_thread.fds[PERFCTR_CYCLES], buff, sizeof(buff));
+    if(len < (ssize_t)expected || buff[0] != (uint64_t)perfctr_thread.members) {
+        return 1;
+    }
+
+    memcpy(values, buff + 1, sizeof(uint64_t) * perfctr_thread.members);
+
+    return 0;
+}
+
+static void explain(int err)
+{
+    if(err == EACCES || err == EPERM) {
+        int paranoid = -1;
+        FILE *file = fopen("/proc/sys/kernel/perf_event_paranoid", "r");
+        if(file != NULL) {
+            if(fscanf(file, "%d", &paranoid) != 1) {
+                paranoid = -1;
+            }
+            fclose(file);
+        }
+
+        snprintf(perfctr_error_buff, ERROR_LEN, "not permitted, kernel.perf_event_paranoid is %d", paranoid);
+    } else if(err == ENOENT || err == EOPNOTSUPP || err == ENODEV) {
+        snprintf(perfctr_error_buff, ERROR_LEN, "no hardware counters on this machine");
+    } else if(err == ENOSYS) {
+        snprintf(perfctr_error_buff, ERROR_LEN, "kernel built without perf events");
+    } else {
+        snprintf(perfctr_error_buff, ERROR_LEN, "%s", strerror(err));
+    }
+}
+
+#else
+
+int perfctr_start(void)
+{
+    return 1;
+}
+
+void perfctr_stop(void)
+{
+}
+
+const char *perfctr_error(void)
+{
+    return "perf events are Linux only";
+}
+
+void perfctr_reset(void)
+{
+}
+
+void perfctr_lap(struct perfctr_t *counts)
+{
+    (void)counts;
+}
+
+#endif //__linux__
@@ -0,0 +1,54 @@
+#ifndef AOC_PERFCTR_H
+#define AOC_PERFCTR_H
+
+#include <stdint.h>
+
+/*
+ * Hardware performance counters through Linux's perf_event_open(): cycles,
+ * instructions, L1 data cache read misses, last-level cache misses, branch
+ * misses and data TLB read misses, counted in user space only. After perfctr_start(),
+ * answer_lap() charges what the counters moved by to the phase just ended,
+ * the same way memstat charges heap use; until then it costs one branch.
+ *
+ * The counters follow the thread that called perfctr_start(), so work a
+ * solver hands to its pool threads is not counted. They are opened as one
+ * pinned group, so they are never multiplexed: either all of them counted a
+ * phase, or none did. An event this CPU does not have (LLC misses, under
+ * some hypervisors) reads PERFCTR_MISSING while the others still count.
+ */
+#define PERFCTR_MISSING UINT64_MAX
+
+enum perfctr_event_t {
+    PERFCTR_CYCLES,
+    PERFCTR_INSTRUCTIONS,
+    PERFCTR_L1D_MISSES,
+    PERFCTR_LLC_MISSES,
+    PERFCTR_BRANCH_MISSES,
+    PERFCTR_DTLB_MISSES,
+    PERFCTR_EVENTS
+};
+
+struct perfctr_t {
+    uint64_t counts[PERFCTR_EVENTS];
+};
+
+extern const char *const perfctr_event_names[PERFCTR_EVENTS];
+
+/*
+ * Opens the counters on the calling thread, or returns 1 when the kernel
+ * will not count them here (no PMU, as in most VMs, or perf_event_paranoid
+ * too strict), with the reason in perfctr_error().
+ */
+int perfctr_start(void);
+void perfctr_stop(void);
+const char *perfctr_error(void);
+
+/*
+ * perfctr_reset() starts a new lap from the current counts; answer_init()
+ * calls it before every solve. perfctr_lap() adds what each counter moved by
+ * since the last lap to counts.
+ */
+void perfctr_reset(void);
+void perfctr_lap(struct perfctr_t *counts);
+
+#endif //AOC_PERFCTR_H
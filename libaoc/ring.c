@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+
+#include "ring.h"
+
+#define RING_SPINS 64
+
+static void ring_wait(unsigned int spins);
+
+void ring_init(struct ring_t *ring, size_t record_size, size_t capacity)
+{
+    size_t len = 1;
+    while(len < capacity) {
+        len <<= 1;
+    }
+
+    ring->records = (char *)malloc(record_size * len);
+    if(ring->records == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    ring->record_size = record_size;
+    ring->mask = len - 1;
+    ring->head = 0;
+    ring->tail_cache = 0;
+    ring->closed = 0;
+    ring->tail = 0;
+    ring->head_cache = 0;
+}
+
+void ring_release(struct ring_t *ring)
+{
+    free(ring->records);
+    ring->records = NULL;
+}
+
+void *ring_reserve(struct ring_t *ring)
+{
+    size_t head = ring->head;
+
+    for(unsigned int spins = 0; head - ring->tail_cache > ring->mask; spins++) {
+        if(spins > 0) {
+            ring_wait(spins);
+        }
+
+        ring->tail_cache = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    }
+
+    return ring->records + (head & ring->mask) * ring->record_size;
+}
+
+void ring_commit(struct ring_t *ring)
+{
+    __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_RELEASE);
+}
+
+void ring_close(struct ring_t *ring)
+{
+    __atomic_store_n(&ring->closed, 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Records committed before the ring was closed are still handed out, so the
+ * head is read once more after seeing it closed.
+ */
+void *ring_peek(struct ring_t *ring, size_t *count)
+{
+    size_t tail = ring->tail;
+
+    for(unsigned int spins = 0; ring->head_cache == tail; spins++) {
+        if(spins > 0) {
+            ring_wait(spins);
+        }
+
+        int closed = __atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE);
+        ring->head_cache = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        if(closed && ring->head_cache == tail) {
+            return NULL;
+        }
+    }
+
+    size_t first = tail & ring->mask;
+    size_t available = ring->head_cache - tail;
+    if(first + available > ring->mask + 1) {
+        available = ring->mask + 1 - first;
+    }
+
+    *count = available;
+
+    return ring->records + first * ring->record_size;
+}
+
+void ring_consume(struct ring_t *ring, size_t count)
+{
+    __atomic_store_n(&ring->tail, ring->tail + count, __ATOMIC_RELEASE);
+}
+
+/*
+ * A short spin covers a producer and consumer running side by side; after
+ * that the waiting thread gives up its core, which matters most when both
+ * share one.
+ */
+static void ring_wait(unsigned int spins)
+{
+    if(spins < RING_SPINS) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+        return;
+    }
+
+    sched_yield();
+}
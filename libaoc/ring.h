@@ -0,0 +1,50 @@
+#ifndef AOC_RING_H
+#define AOC_RING_H
+
+#include <stddef.h>
+
+#define RING_CACHE_LINE 64
+
+/*
+ * A bounded single-producer single-consumer queue of fixed-size records,
+ * without locks. The producer fills the slot ring_reserve() returns and
+ * publishes it with ring_commit(); the consumer takes every published record
+ * that is contiguous in memory with ring_peek() and hands the slots back with
+ * ring_consume(). Either side waits, spinning briefly and then yielding, while
+ * the ring is full or empty.
+ *
+ * Each side keeps its own index on its own cache line, along with a copy of
+ * the other side's index that is only refreshed when the ring looks full (or
+ * empty), so the two threads only share a line when they have to.
+ */
+struct ring_t {
+    char *records;
+    size_t record_size;
+    size_t mask;
+
+    size_t head __attribute__((aligned(RING_CACHE_LINE)));
+    size_t tail_cache;
+    int closed;
+
+    size_t tail __attribute__((aligned(RING_CACHE_LINE)));
+    size_t head_cache;
+};
+
+/*
+ * capacity is rounded up to a power of two.
+ */
+void ring_init(struct ring_t *ring, size_t record_size, size_t capacity);
+void ring_release(struct ring_t *ring);
+
+void *ring_reserve(struct ring_t *ring);
+void ring_commit(struct ring_t *ring);
+void ring_close(struct ring_t *ring);
+
+/*
+ * Returns the next published records and stores how many there are in count,
+ * or returns NULL once the ring is closed and drained.
+ */
+void *ring_peek(struct ring_t *ring, size_t *count);
+void ring_consume(struct ring_t *ring, size_t count);
+
+#endif //AOC_RING_H
@@ -0,0 +1,172 @@
+#include <pthread.h>
+
+#include "cpu.h"
+#include "scan.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+#define SCAN_BLOCK 32
+
+typedef uint32_t (*digit_mask_t)(const char *block);
+
+static pthread_once_t digit_mask_once = PTHREAD_ONCE_INIT;
+static digit_mask_t digit_mask;
+
+static size_t scan(const char *data, size_t len, void *out, size_t out_len, int wide);
+static void bind_digit_mask(void);
+static uint32_t digit_mask_block(const char *block);
+static uint32_t digit_mask_scalar(const char *block, size_t block_len);
+#ifdef CPU_X86
+CPU_TARGET_SSE42 static uint32_t digit_mask_sse42(const char *block);
+CPU_TARGET_AVX2 static uint32_t digit_mask_avx2(const char *block);
+#endif
+
+size_t scan_int32(const char *data, size_t len, int32_t out[], size_t out_len)
+{
+    return scan(data, len, out, out_len, 0);
+}
+
+size_t scan_int64(const char *data, size_t len, int64_t out[], size_t out_len)
+{
+    return scan(data, len, out, out_len, 1);
+}
+
+/*
+ * Walks the data one block at a time. Bit i of a block's mask is set when
+ * byte i is a digit, so the start of the next integer and the end of the
+ * current one are each a count of trailing zeros away. An integer that runs
+ * past the end of a block carries over into the next one.
+ */
+static size_t scan(const char *data, size_t len, void *out, size_t out_len, int wide)
+{
+    pthread_once(&digit_mask_once, bind_digit_mask);
+
+    size_t count = 0;
+    int in_number = 0;
+    int negative = 0;
+    uint64_t value = 0;
+
+    for(size_t base = 0; base < len && count < out_len; base += SCAN_BLOCK) {
+        size_t block_len = len - base < SCAN_BLOCK ? len - base : SCAN_BLOCK;
+        uint32_t mask = block_len == SCAN_BLOCK ? digit_mask(data + base) : digit_mask_scalar(data + base, block_len);
+
+        size_t pos = 0;
+        while(pos < block_len) {
+            if(!in_number) {
+                uint32_t starts = mask >> pos;
+                if(starts == 0) {
+                    break;
+                }
+
+                pos += (size_t)__builtin_ctz(starts);
+                negative = base + pos > 0 && data[base + pos - 1] == '-';
+                value = 0;
+                in_number = 1;
+            }
+
+            uint32_t ends = ~mask >> pos;
+            size_t end = ends != 0 ? pos + (size_t)__builtin_ctz(ends) : SCAN_BLOCK;
+            if(end > block_len) {
+                end = block_len;
+            }
+
+            for(; pos < end; pos++) {
+                value = value * 10 + (uint64_t)(data[base + pos] - '0');
+            }
+
+            if(end < block_len) {
+                int64_t number = negative ? -(int64_t)value : (int64_t)value;
+                if(wide) {
+                    ((int64_t *)out)[count++] = number;
+                } else {
+                    ((int32_t *)out)[count++] = (int32_t)number;
+                }
+
+                in_number = 0;
+                if(count == out_len) {
+                    return count;
+                }
+            }
+        }
+    }
+
+    if(in_number && count < out_len) {
+        int64_t number = negative ? -(int64_t)value : (int64_t)value;
+        if(wide) {
+            ((int64_t *)out)[count++] = number;
+        } else {
+            ((int32_t *)out)[count++] = (int32_t)number;
+        }
+    }
+
+    return count;
+}
+
+/*
+ * A block is 32 bytes, one AVX2 vector or two SSE ones, so a mask always
+ * fits the same word; AVX-512 would not make the blocks any faster to scan.
+ */
+static void bind_digit_mask(void)
+{
+#ifdef CPU_X86
+    if(cpu_tier() >= CPU_TIER_AVX2) {
+        digit_mask = digit_mask_avx2;
+        return;
+    }
+
+    if(cpu_tier() >= CPU_TIER_SSE42) {
+        digit_mask = digit_mask_sse42;
+        return;
+    }
+#endif
+
+    digit_mask = digit_mask_block;
+}
+
+static uint32_t digit_mask_block(const char *block)
+{
+    return digit_mask_scalar(block, SCAN_BLOCK);
+}
+
+#ifdef CPU_X86
+/*
+ * A byte is a digit when byte - '0' is at most 9 as an unsigned value, which
+ * is where min(byte - '0', 9) leaves it unchanged.
+ */
+CPU_TARGET_SSE42 static uint32_t digit_mask_sse42(const char *block)
+{
+    uint32_t mask = 0;
+    for(int half = 0; half < 2; half++) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(block + 16 * half));
+        __m128i offsets = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+        __m128i digits = _mm_cmpeq_epi8(_mm_min_epu8(offsets, _mm_set1_epi8(9)), offsets);
+
+        mask |= (uint32_t)_mm_movemask_epi8(digits) << (16 * half);
+    }
+
+    return mask;
+}
+
+CPU_TARGET_AVX2 static uint32_t digit_mask_avx2(const char *block)
+{
+    __m256i bytes = _mm256_loadu_si256((const __m256i *)block);
+    __m256i offsets = _mm256_sub_epi8(bytes, _mm256_set1_epi8('0'));
+    __m256i digits = _mm256_cmpeq_epi8(_mm256_min_epu8(offsets, _mm256_set1_epi8(9)), offsets);
+
+    return (uint32_t)_mm256_movemask_epi8(digits);
+}
+#endif
+
+static uint32_t digit_mask_scalar(const char *block, size_t block_len)
+{
+    uint32_t mask = 0;
+    for(size_t i = 0; i < block_len; i++) {
+        if((unsigned char)(block[i] - '0') <= 9) {
+            mask |= (uint32_t)1 << i;
+        }
+    }
+
+    return mask;
+}
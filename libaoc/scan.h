@@ -0,0 +1,25 @@
+#ifndef AOC_SCAN_H
+#define AOC_SCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Bulk integer scanning. Every maximal run of decimal digits is one integer,
+ * negative if the byte right before it is '-'; every other byte is a
+ * separator, so "position=<-3,  11>" scans as -3, 11 and "#1 @ 2,3: 4x5" as
+ * 1, 2, 3, 4, 5. Values too large for the output type wrap.
+ *
+ * Digits are found 32 bytes at a time with SSE4.2 or AVX2, whichever the CPU
+ * has (see cpu.h), and a byte at a time otherwise, so long runs of
+ * separators cost next to nothing.
+ *
+ * Both functions store at most out_len integers and return how many they
+ * stored. SCAN_MAX_INTEGERS(len) is enough room for any len bytes.
+ */
+#define SCAN_MAX_INTEGERS(len) (((len) + 1) / 2)
+
+size_t scan_int32(const char *data, size_t len, int32_t out[], size_t out_len);
+size_t scan_int64(const char *data, size_t len, int64_t out[], size_t out_len);
+
+#endif //AOC_SCAN_H
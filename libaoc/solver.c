@@ -0,0 +1,236 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <sys/resource.h>
+
+#include "solver.h"
+#include "clock.h"
+
+static uint64_t peak_bytes(const struct aoc_answer_t *answer);
+static uint64_t max_rss_bytes(void);
+
+const char *const aoc_phase_names[AOC_PHASES] = {"parse", "part1", "part2"};
+
+void answer_init(struct aoc_answer_t *answer)
+{
+    answer->part1 = NULL;
+    answer->part2 = NULL;
+
+    for(int i = 0; i < AOC_PHASES; i++) {
+        answer->phase_ns[i] = 0;
+        answer->phase_mem[i].allocs = 0;
+        answer->phase_mem[i].bytes = 0;
+        answer->phase_mem[i].peak_bytes = 0;
+        memset(&answer->phase_ctr[i], 0, sizeof(answer->phase_ctr[i]));
+    }
+
+    memstat_reset();
+    perfctr_reset();
+    answer->lap_start_ns = clock_now_ns();
+}
+
+void answer_lap(struct aoc_answer_t *answer, enum aoc_phase_t phase)
+{
+    uint64_t now = clock_now_ns();
+
+    answer->phase_ns[phase] += now - answer->lap_start_ns;
+    answer->lap_start_ns = now;
+
+    memstat_lap(&answer->phase_mem[phase]);
+    perfctr_lap(&answer->phase_ctr[phase]);
+}
+
+void answer_printf(char **part, const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    int len = vsnprintf(NULL, 0, fmt, args);
+    va_end(args);
+
+    if(len < 0) {
+        fprintf(stderr, "Unexpected error: cannot format answer.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    char *str = (char *)malloc(sizeof(char) * (len + 1));
+    if(str == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    va_start(args, fmt);
+    vsnprintf(str, len + 1, fmt, args);
+    va_end(args);
+
+    free(*part);
+    *part = str;
+}
+
+/*
+ * One row per phase, then a total whose peak is the largest of the phases.
+ */
+void answer_print_memstat(FILE *stream, const struct aoc_answer_t *answer)
+{
+    struct memstat_t total = {.allocs = 0, .bytes = 0, .peak_bytes = 0};
+
+    fprintf(stream, "%-8s %12s %16s %16s\n", "phase", "allocs", "bytes", "peak bytes");
+    for(int i = 0; i < AOC_PHASES; i++) {
+        const struct memstat_t *mem = &answer->phase_mem[i];
+
+        fprintf(stream, "%-8s %12llu %16llu %16llu\n", aoc_phase_names[i], (unsigned long long)mem->allocs,
+                (unsigned long long)mem->bytes, (unsigned long long)mem->peak_bytes);
+
+        total.allocs += mem->allocs;
+        total.bytes += mem->bytes;
+        if(mem->peak_bytes > total.peak_bytes) {
+            total.peak_bytes = mem->peak_bytes;
+        }
+    }
+
+    fprintf(stream, "%-8s %12llu %16llu %16llu\n", "total", (unsigned long long)total.allocs,
+            (unsigned long long)total.bytes, (unsigned long long)total.peak_bytes);
+}
+
+/*
+ * Writes a part on a single line: newlines, tabs and backslashes are escaped
+ * as "\n", "\t" and "\\", and a missing part is written as "-".
+ */
+void answer_print_part(FILE *stream, const char *part)
+{
+    if(part == NULL) {
+        fputc('-', stream);
+        return;
+    }
+
+    for(const char *c = part; *c; c++) {
+        switch(*c) {
+            case '\n':
+                fputs("\\n", stream);
+                break;
+            case '\t':
+                fputs("\\t", stream);
+                break;
+            case '\\':
+                fputs("\\\\", stream);
+                break;
+            default:
+                fputc(*c, stream);
+        }
+    }
+}
+
+/*
+ * A JSON string, or null for a missing one. Control characters are escaped.
+ */
+void answer_print_json_string(FILE *stream, const char *str)
+{
+    if(str == NULL) {
+        fprintf(stream, "null");
+        return;
+    }
+
+    fputc('"', stream);
+    for(const unsigned char *c = (const unsigned char *)str; *c; c++) {
+        switch(*c) {
+            case '"':
+                fprintf(stream, "\\\"");
+                break;
+            case '\\':
+                fprintf(stream, "\\\\");
+                break;
+            case '\n':
+                fprintf(stream, "\\n");
+                break;
+            default:
+                if(*c < 0x20) {
+                    fprintf(stream, "\\u%04x", *c);
+                } else {
+                    fputc(*c, stream);
+                }
+        }
+    }
+    fputc('"', stream);
+}
+
+void answer_print_json(FILE *stream, const char *name, const struct aoc_answer_t *answer, int with_memory)
+{
+    fprintf(stream, "{\"solver\": ");
+    answer_print_json_string(stream, name);
+    fprintf(stream, ", \"part1\": ");
+    answer_print_json_string(stream, answer->part1);
+    fprintf(stream, ", \"part2\": ");
+    answer_print_json_string(stream, answer->part2);
+
+    for(int i = 0; i < AOC_PHASES; i++) {
+        fprintf(stream, ", \"%s_ns\": %llu", aoc_phase_names[i], (unsigned long long)answer->phase_ns[i]);
+    }
+
+    if(with_memory) {
+        fprintf(stream, ", \"peak_bytes\": %llu", (unsigned long long)peak_bytes(answer));
+    } else {
+        fprintf(stream, ", \"peak_bytes\": null");
+    }
+
+    fprintf(stream, ", \"max_rss_bytes\": %llu}\n", (unsigned long long)max_rss_bytes());
+}
+
+void answer_print_tsv(FILE *stream, const char *name, const struct aoc_answer_t *answer, int with_memory)
+{
+    answer_print_part(stream, name);
+    fputc('\t', stream);
+    answer_print_part(stream, answer->part1);
+    fputc('\t', stream);
+    answer_print_part(stream, answer->part2);
+
+    for(int i = 0; i < AOC_PHASES; i++) {
+        fprintf(stream, "\t%llu", (unsigned long long)answer->phase_ns[i]);
+    }
+
+    if(with_memory) {
+        fprintf(stream, "\t%llu", (unsigned long long)peak_bytes(answer));
+    } else {
+        fprintf(stream, "\t-");
+    }
+
+    fprintf(stream, "\t%llu\n", (unsigned long long)max_rss_bytes());
+}
+
+void answer_release(struct aoc_answer_t *answer)
+{
+    free(answer->part1);
+    free(answer->part2);
+
+    answer->part1 = NULL;
+    answer->part2 = NULL;
+}
+
+/*
+ * Live bytes are counted from the start of the solve, so its peak is the
+ * largest of the phases'.
+ */
+static uint64_t peak_bytes(const struct aoc_answer_t *answer)
+{
+    uint64_t peak = 0;
+    for(int i = 0; i < AOC_PHASES; i++) {
+        if(answer->phase_mem[i].peak_bytes > peak) {
+            peak = answer->phase_mem[i].peak_bytes;
+        }
+    }
+
+    return peak;
+}
+
+/*
+ * ru_maxrss is in kilobytes on Linux.
+ */
+static uint64_t max_rss_bytes(void)
+{
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+
+    return (uint64_t)usage.ru_maxrss * 1024;
+}
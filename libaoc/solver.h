@@ -0,0 +1,72 @@
+#ifndef AOC_SOLVER_H
+#define AOC_SOLVER_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "memstat.h"
+#include "perfctr.h"
+
+enum aoc_phase_t {
+    AOC_PHASE_PARSE,
+    AOC_PHASE_PART1,
+    AOC_PHASE_PART2,
+    AOC_PHASES
+};
+
+/*
+ * The answers produced by a solver, along with the time spent in each phase
+ * and, while memstat_start() and perfctr_start() are in effect, its heap use
+ * and hardware counts. Answers are heap
+ * allocated strings; a part that cannot be computed is left NULL.
+ */
+struct aoc_answer_t {
+    char *part1;
+    char *part2;
+    uint64_t phase_ns[AOC_PHASES];
+    struct memstat_t phase_mem[AOC_PHASES];
+    struct perfctr_t phase_ctr[AOC_PHASES];
+    uint64_t lap_start_ns;
+};
+
+/*
+ * A solution for a single day. solve() reads the whole puzzle input from the
+ * given stream and fills in the answer, returning 0 on success or 1 if the
+ * puzzle could not be solved. version is part of the key cached answers are
+ * stored under (see cache.h), and must be bumped by any change that could
+ * change the answers; left out, it is 0.
+ *
+ * A solver that can work through its input as it arrives also provides
+ * solve_stream(), which reads the input through a stream (see stream.h)
+ * instead of buffering all of it first. Its parse and part 1 phases overlap,
+ * and the time spent in both is recorded as parse.
+ */
+struct aoc_solver_t {
+    const char *name;
+    int (*solve)(FILE *input, struct aoc_answer_t *answer);
+    int (*solve_stream)(FILE *input, struct aoc_answer_t *answer);
+    int version;
+};
+
+extern const char *const aoc_phase_names[AOC_PHASES];
+
+void answer_init(struct aoc_answer_t *answer);
+void answer_lap(struct aoc_answer_t *answer, enum aoc_phase_t phase);
+void answer_printf(char **part, const char *fmt, ...);
+void answer_print_memstat(FILE *stream, const struct aoc_answer_t *answer);
+void answer_print_part(FILE *stream, const char *part);
+void answer_print_json_string(FILE *stream, const char *str);
+
+/*
+ * The answer as one machine-readable record: the solver's name, both parts,
+ * the time of each phase in nanoseconds, the peak heap bytes of the solve
+ * (only known with_memory, after memstat_start()) and the process's peak
+ * resident set size in bytes. answer_print_json() writes a JSON object, with
+ * null for what is missing; answer_print_tsv() writes one tab-separated line
+ * in that order, with "-" for what is missing.
+ */
+void answer_print_json(FILE *stream, const char *name, const struct aoc_answer_t *answer, int with_memory);
+void answer_print_tsv(FILE *stream, const char *name, const struct aoc_answer_t *answer, int with_memory);
+void answer_release(struct aoc_answer_t *answer);
+
+#endif //AOC_SOLVER_H
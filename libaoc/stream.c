@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "stream.h"
+
+static void *stream_reader(void *arg);
+static void stream_chunks(struct stream_t *stream);
+static void stream_lines(struct stream_t *stream);
+static void stream_emit(struct stream_t *stream, const char *ptr, size_t len);
+static size_t stream_read(FILE *input, char *buffer, size_t len);
+
+void stream_open(struct stream_t *stream, FILE *input, size_t record_size, stream_parse_t parse)
+{
+    stream->input = input;
+    stream->record_size = parse != NULL ? record_size : sizeof(struct stream_chunk_t);
+    stream->parse = parse;
+    stream->batch = NULL;
+    stream->batch_len = 0;
+    stream->batch_index = 0;
+
+    ring_init(&stream->ring, stream->record_size, STREAM_RING_LEN);
+
+    if(pthread_create(&stream->reader, NULL, stream_reader, stream) != 0) {
+        fprintf(stderr, "Fatal error: Cannot create thread.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * Records are handed back to the reader a whole batch at a time, once the
+ * solver asks for the record after the last one of the batch.
+ */
+const void *stream_next(struct stream_t *stream)
+{
+    if(stream->batch_index == stream->batch_len) {
+        if(stream->batch_len > 0) {
+            ring_consume(&stream->ring, stream->batch_len);
+        }
+
+        stream->batch_index = 0;
+        stream->batch = (char *)ring_peek(&stream->ring, &stream->batch_len);
+        if(stream->batch == NULL) {
+            stream->batch_len = 0;
+            return NULL;
+        }
+    }
+
+    return stream->batch + stream->record_size * stream->batch_index++;
+}
+
+/*
+ * Whatever the solver did not read is drained first, so that the reader is
+ * never left waiting on a full ring.
+ */
+void stream_close(struct stream_t *stream)
+{
+    while(stream_next(stream) != NULL);
+
+    pthread_join(stream->reader, NULL);
+    ring_release(&stream->ring);
+}
+
+static void *stream_reader(void *arg)
+{
+    struct stream_t *stream = (struct stream_t *)arg;
+
+    if(stream->parse != NULL) {
+        stream_lines(stream);
+    } else {
+        stream_chunks(stream);
+    }
+
+    ring_close(&stream->ring);
+
+    return NULL;
+}
+
+static void stream_chunks(struct stream_t *stream)
+{
+    while(1) {
+        struct stream_chunk_t *chunk = (struct stream_chunk_t *)ring_reserve(&stream->ring);
+
+        chunk->len = stream_read(stream->input, chunk->data, STREAM_CHUNK_LEN);
+        if(chunk->len == 0) {
+            break;
+        }
+
+        ring_commit(&stream->ring);
+    }
+}
+
+/*
+ * Complete lines are parsed as soon as they arrive; a partial line is moved
+ * to the front of the buffer to be finished by the next read, and the buffer
+ * doubles whenever a single line fills it.
+ */
+static void stream_lines(struct stream_t *stream)
+{
+    size_t buff_len = INPUT_DEFAULT_BUFF_LEN;
+    size_t buff_used = 0;
+    char *buffer = (char *)malloc(sizeof(char) * buff_len);
+    if(buffer == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    while(1) {
+        if(buff_used == buff_len) {
+            buff_len *= 2;
+            buffer = (char *)realloc(buffer, sizeof(char) * buff_len);
+            if(buffer == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        size_t read = stream_read(stream->input, buffer + buff_used, buff_len - buff_used);
+        if(read == 0) {
+            break;
+        }
+
+        size_t end = buff_used + read;
+        size_t start = 0;
+        size_t scan = buff_used;
+
+        char *lf;
+        while((lf = (char *)memchr(buffer + scan, '\n', end - scan)) != NULL) {
+            size_t line_end = (size_t)(lf - buffer);
+            stream_emit(stream, buffer + start, line_end - start);
+
+            start = line_end + 1;
+            scan = start;
+        }
+
+        memmove(buffer, buffer + start, end - start);
+        buff_used = end - start;
+    }
+
+    stream_emit(stream, buffer, buff_used);
+
+    free(buffer);
+}
+
+static void stream_emit(struct stream_t *stream, const char *ptr, size_t len)
+{
+    if(len > 0 && ptr[len - 1] == '\r') {
+        len--;
+    }
+
+    if(len == 0) {
+        return;
+    }
+
+    struct view_t line = {.ptr = ptr, .len = len};
+    if(stream->parse(line, ring_reserve(&stream->ring))) {
+        fprintf(stderr, "Unexpected input: %.*s\n", (int)len, ptr);
+        exit(1);
+    }
+
+    ring_commit(&stream->ring);
+}
+
+/*
+ * Reads whatever has arrived, up to len bytes, without waiting for more the
+ * way fread() would. Streams without a descriptor (memory streams) go through
+ * fread().
+ */
+static size_t stream_read(FILE *input, char *buffer, size_t len)
+{
+    int fd = fileno(input);
+    if(fd < 0) {
+        size_t read = fread(buffer, 1, len, input);
+        if(read == 0 && ferror(input)) {
+            perror("Fatal error: Cannot read input.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        return read;
+    }
+
+    while(1) {
+        ssize_t got = read(fd, buffer, len);
+        if(got >= 0) {
+            return (size_t)got;
+        }
+
+        if(errno != EINTR) {
+            perror("Fatal error: Cannot read input.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
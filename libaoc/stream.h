@@ -0,0 +1,54 @@
+#ifndef AOC_STREAM_H
+#define AOC_STREAM_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#include "input.h"
+#include "ring.h"
+
+#define STREAM_RING_LEN 1024
+#define STREAM_CHUNK_LEN 4096
+
+/*
+ * Turns one line of input into a record, returning 0, or 1 if the line is
+ * malformed, which is fatal.
+ */
+typedef int (*stream_parse_t)(struct view_t line, void *record);
+
+/*
+ * Raw input, for puzzles that are one long line rather than many records.
+ */
+struct stream_chunk_t {
+    size_t len;
+    char data[STREAM_CHUNK_LEN];
+};
+
+/*
+ * Input parsed on a thread of its own while the solver works through it. The
+ * reader thread reads the stream a block at a time, parses each non-empty
+ * line into a record of record_size bytes and passes it through a ring (see
+ * ring.h), so parsing overlaps with solving and only the ring, not the whole
+ * input, is held in memory. Without a parse function the input is passed
+ * through as it is, in stream_chunk_t records.
+ *
+ * stream_next() returns the records in input order, each valid until the
+ * next call, and NULL at the end of the input.
+ */
+struct stream_t {
+    struct ring_t ring;
+    pthread_t reader;
+    FILE *input;
+    size_t record_size;
+    stream_parse_t parse;
+    char *batch;
+    size_t batch_len;
+    size_t batch_index;
+};
+
+void stream_open(struct stream_t *stream, FILE *input, size_t record_size, stream_parse_t parse);
+const void *stream_next(struct stream_t *stream);
+void stream_close(struct stream_t *stream);
+
+#endif //AOC_STREAM_H
@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "threadpool.h"
+
+#define DEFAULT_TASKS_LEN 32
+
+static void *threadpool_worker(void *arg);
+
+/*
+ * One worker per online core, or a single worker if the count is unknown.
+ */
+size_t threadpool_default_threads(void)
+{
+    long int cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return cores > 0 ? (size_t)cores : 1;
+}
+
+void threadpool_init(struct threadpool_t *pool, size_t threads)
+{
+    if(threads == 0) {
+        threads = 1;
+    }
+
+    pool->threads_len = threads;
+    pool->threads = (pthread_t *)malloc(sizeof(pthread_t) * threads);
+    pool->tasks_len = DEFAULT_TASKS_LEN;
+    pool->tasks = (struct threadpool_task_t *)malloc(sizeof(struct threadpool_task_t) * pool->tasks_len);
+    if(pool->threads == NULL || pool->tasks == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    pool->tasks_head = 0;
+    pool->tasks_tail = 0;
+    pool->pending = 0;
+    pool->stopping = 0;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->task_ready, NULL);
+    pthread_cond_init(&pool->all_done, NULL);
+
+    for(size_t i = 0; i < threads; i++) {
+        if(pthread_create(&pool->threads[i], NULL, threadpool_worker, pool) != 0) {
+            fprintf(stderr, "Fatal error: Cannot create thread.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+void threadpool_submit(struct threadpool_t *pool, void (*run)(void *arg), void *arg)
+{
+    pthread_mutex_lock(&pool->lock);
+
+    /*
+     * The queue only ever grows at the tail. Once the workers have drained it
+     * the indices are rewound, so a pool that is fed and waited on in rounds
+     * keeps reusing the same slots.
+     */
+    if(pool->tasks_tail >= pool->tasks_len) {
+        pool->tasks_len *= 2;
+        pool->tasks = (struct threadpool_task_t *)realloc(pool->tasks, sizeof(struct threadpool_task_t) * pool->tasks_len);
+        if(pool->tasks == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    pool->tasks[pool->tasks_tail].run = run;
+    pool->tasks[pool->tasks_tail].arg = arg;
+    pool->tasks_tail++;
+    pool->pending++;
+
+    pthread_cond_signal(&pool->task_ready);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void threadpool_wait(struct threadpool_t *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+
+    while(pool->pending > 0) {
+        pthread_cond_wait(&pool->all_done, &pool->lock);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/*
+ * Waits for the queue to drain, then stops and joins every worker.
+ */
+void threadpool_release(struct threadpool_t *pool)
+{
+    threadpool_wait(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->task_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for(size_t i = 0; i < pool->threads_len; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->task_ready);
+    pthread_cond_destroy(&pool->all_done);
+
+    free(pool->threads);
+    free(pool->tasks);
+
+    pool->threads = NULL;
+    pool->threads_len = 0;
+    pool->tasks = NULL;
+    pool->tasks_len = 0;
+}
+
+static void *threadpool_worker(void *arg)
+{
+    struct threadpool_t *pool = (struct threadpool_t *)arg;
+
+    pthread_mutex_lock(&pool->lock);
+    while(1) {
+        while(pool->tasks_head == pool->tasks_tail && !pool->stopping) {
+            pthread_cond_wait(&pool->task_ready, &pool->lock);
+        }
+
+        if(pool->tasks_head == pool->tasks_tail) {
+            break;
+        }
+
+        struct threadpool_task_t task = pool->tasks[pool->tasks_head];
+        pool->tasks_head++;
+        if(pool->tasks_head == pool->tasks_tail) {
+            pool->tasks_head = 0;
+            pool->tasks_tail = 0;
+        }
+
+        pthread_mutex_unlock(&pool->lock);
+        task.run(task.arg);
+        pthread_mutex_lock(&pool->lock);
+
+        pool->pending--;
+        if(pool->pending == 0) {
+            pthread_cond_broadcast(&pool->all_done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
@@ -0,0 +1,41 @@
+#ifndef AOC_THREADPOOL_H
+#define AOC_THREADPOOL_H
+
+#include <stddef.h>
+#include <pthread.h>
+
+/*
+ * A fixed set of worker threads pulling tasks from a shared FIFO queue.
+ * Tasks are run in the order they were submitted, although with more than one
+ * worker they may finish in any order; threadpool_wait() blocks until every
+ * submitted task has finished.
+ *
+ * Like the rest of the project, failing to create a thread or to allocate the
+ * queue is fatal.
+ */
+struct threadpool_task_t {
+    void (*run)(void *arg);
+    void *arg;
+};
+
+struct threadpool_t {
+    pthread_t *threads;
+    size_t threads_len;
+    struct threadpool_task_t *tasks;
+    size_t tasks_len;
+    size_t tasks_head;
+    size_t tasks_tail;
+    size_t pending;
+    int stopping;
+    pthread_mutex_t lock;
+    pthread_cond_t task_ready;
+    pthread_cond_t all_done;
+};
+
+size_t threadpool_default_threads(void);
+void threadpool_init(struct threadpool_t *pool, size_t threads);
+void threadpool_submit(struct threadpool_t *pool, void (*run)(void *arg), void *arg);
+void threadpool_wait(struct threadpool_t *pool);
+void threadpool_release(struct threadpool_t *pool);
+
+#endif //AOC_THREADPOOL_H
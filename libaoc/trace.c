@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "clock.h"
+#include "trace.h"
+
+#define NAME_LEN 128
+
+struct trace_entry_t {
+    char name[NAME_LEN];
+    const struct trace_site_t *site;
+};
+
+static struct trace_site_t *trace_sites = NULL;
+static int trace_started = 0;
+static uint64_t trace_start_ticks;
+static uint64_t trace_start_ns;
+
+static void trace_report(void);
+static void trace_entry_name(const struct trace_site_t *site, char buffer[], size_t buff_len);
+static int compare_entries(const void *a, const void *b);
+static void print_table(FILE *stream, const struct trace_entry_t entries[], size_t entries_len, double ns_per_tick);
+static void print_json(FILE *stream, const struct trace_entry_t entries[], size_t entries_len, double ns_per_tick);
+
+void trace_register(struct trace_site_t *site)
+{
+    int expected = 0;
+    if(!__atomic_compare_exchange_n(&site->registered, &expected, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    expected = 0;
+    if(__atomic_compare_exchange_n(&trace_started, &expected, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        trace_start_ticks = trace_ticks();
+        trace_start_ns = clock_now_ns();
+        atexit(trace_report);
+    }
+
+    site->next = __atomic_load_n(&trace_sites, __ATOMIC_ACQUIRE);
+    while(!__atomic_compare_exchange_n(&trace_sites, &site->next, site, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+static void trace_report(void)
+{
+    const char *mode = getenv("AOC_TRACE");
+    if(mode == NULL || mode[0] == 0 || strcmp(mode, "0") == 0) {
+        return;
+    }
+
+    uint64_t elapsed_ticks = trace_ticks() - trace_start_ticks;
+    uint64_t elapsed_ns = clock_now_ns() - trace_start_ns;
+    double ns_per_tick = elapsed_ticks ? (double)elapsed_ns / (double)elapsed_ticks : 1.0;
+
+    size_t entries_len = 0;
+    for(struct trace_site_t *site = trace_sites; site != NULL; site = site->next) {
+        entries_len++;
+    }
+
+    struct trace_entry_t *entries = (struct trace_entry_t *)malloc(sizeof(struct trace_entry_t) * (entries_len + 1));
+    if(entries == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t entries_index = 0;
+    for(struct trace_site_t *site = trace_sites; site != NULL; site = site->next) {
+        entries[entries_index].site = site;
+        trace_entry_name(site, entries[entries_index].name, NAME_LEN);
+        entries_index++;
+    }
+
+    qsort(entries, entries_len, sizeof(struct trace_entry_t), compare_entries);
+
+    size_t mode_len = strlen(mode);
+    if(strcmp(mode, "json") == 0) {
+        print_json(stderr, entries, entries_len, ns_per_tick);
+    } else if(mode_len > 5 && strcmp(mode + mode_len - 5, ".json") == 0) {
+        FILE *json = fopen(mode, "w");
+        if(json == NULL) {
+            perror("Unexpected error: Cannot open trace output file.\n");
+        } else {
+            print_json(json, entries, entries_len, ns_per_tick);
+            fclose(json);
+        }
+    } else {
+        print_table(stderr, entries, entries_len, ns_per_tick);
+    }
+
+    free(entries);
+}
+
+/*
+ * Sites are reported as <dir>/<id>, where <dir> is the directory holding the
+ * file they were used in (day13, libaoc, ...).
+ */
+static void trace_entry_name(const struct trace_site_t *site, char buffer[], size_t buff_len)
+{
+    const char *end = strrchr(site->file, '/');
+    if(end == NULL) {
+        snprintf(buffer, buff_len, "%s", site->name);
+        return;
+    }
+
+    const char *start = end;
+    while(start > site->file && start[-1] != '/') {
+        start--;
+    }
+
+    snprintf(buffer, buff_len, "%.*s/%s", (int)(end - start), start, site->name);
+}
+
+static int compare_entries(const void *a, const void *b)
+{
+    const struct trace_entry_t *lhs = (const struct trace_entry_t *)a;
+    const struct trace_entry_t *rhs = (const struct trace_entry_t *)b;
+
+    if(lhs->site->kind != rhs->site->kind) {
+        return lhs->site->kind == TRACE_KIND_SCOPE ? -1 : 1;
+    }
+
+    return strcmp(lhs->name, rhs->name);
+}
+
+static void print_table(FILE *stream, const struct trace_entry_t entries[], size_t entries_len, double ns_per_tick)
+{
+    fprintf(stream, "%-40s %12s %16s %14s\n", "scope", "calls", "ticks", "ms");
+    for(size_t i = 0; i < entries_len && entries[i].site->kind == TRACE_KIND_SCOPE; i++) {
+        const struct trace_site_t *site = entries[i].site;
+
+        fprintf(stream, "%-40s %12llu %16llu %14.3f\n", entries[i].name, (unsigned long long)site->calls,
+                (unsigned long long)site->total, (double)site->total * ns_per_tick / 1e6);
+    }
+
+    fprintf(stream, "%-40s %12s %16s\n", "counter", "calls", "total");
+    for(size_t i = 0; i < entries_len; i++) {
+        const struct trace_site_t *site = entries[i].site;
+        if(site->kind != TRACE_KIND_COUNTER) {
+            continue;
+        }
+
+        fprintf(stream, "%-40s %12llu %16llu\n", entries[i].name, (unsigned long long)site->calls, (unsigned long long)site->total);
+    }
+}
+
+static void print_json(FILE *stream, const struct trace_entry_t entries[], size_t entries_len, double ns_per_tick)
+{
+    fprintf(stream, "{\"ns_per_tick\": %.6f, \"scopes\": [", ns_per_tick);
+
+    int written = 0;
+    for(size_t i = 0; i < entries_len; i++) {
+        const struct trace_site_t *site = entries[i].site;
+        if(site->kind != TRACE_KIND_SCOPE) {
+            continue;
+        }
+
+        fprintf(stream, "%s\n  {\"name\": \"%s\", \"calls\": %llu, \"ticks\": %llu, \"ns\": %.0f}", written++ ? "," : "",
+                entries[i].name, (unsigned long long)site->calls, (unsigned long long)site->total, (double)site->total * ns_per_tick);
+    }
+
+    fprintf(stream, "\n], \"counters\": [");
+
+    written = 0;
+    for(size_t i = 0; i < entries_len; i++) {
+        const struct trace_site_t *site = entries[i].site;
+        if(site->kind != TRACE_KIND_COUNTER) {
+            continue;
+        }
+
+        fprintf(stream, "%s\n  {\"name\": \"%s\", \"calls\": %llu, \"total\": %llu}", written++ ? "," : "",
+                entries[i].name, (unsigned long long)site->calls, (unsigned long long)site->total);
+    }
+
+    fprintf(stream, "\n]}\n");
+}
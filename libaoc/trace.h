@@ -0,0 +1,94 @@
+#ifndef AOC_TRACE_H
+#define AOC_TRACE_H
+
+/*
+ * Hot-path instrumentation. A scope times a stretch of code between
+ * TRACE_BEGIN(id) and TRACE_END(id) in the same block, and a counter sums
+ * whatever is passed to TRACE_COUNT(id, n). Each id becomes one entry in the
+ * report, named after the directory of the file it is used in, so the same id
+ * can be reused in different days.
+ *
+ * Unless the project is configured with -DAOC_TRACE=ON every macro compiles to
+ * nothing. When it is, the report is written at exit according to the AOC_TRACE
+ * environment variable: unset or "0" for none, "json" for JSON on stderr, a
+ * path ending in ".json" for JSON in that file, and anything else for a table
+ * on stderr.
+ */
+#ifdef AOC_TRACE
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include "clock.h"
+#endif
+
+enum trace_kind_t {
+    TRACE_KIND_SCOPE,
+    TRACE_KIND_COUNTER
+};
+
+/*
+ * One per use of a macro, statically allocated at the call site. Sites link
+ * themselves into a global list the first time they are hit, and are updated
+ * atomically so that solvers running on different threads can share them.
+ */
+struct trace_site_t {
+    const char *file;
+    const char *name;
+    enum trace_kind_t kind;
+    int registered;
+    uint64_t calls;
+    uint64_t total;
+    struct trace_site_t *next;
+};
+
+void trace_register(struct trace_site_t *site);
+
+/*
+ * Scopes are measured in timestamp counter ticks where there is one, and in
+ * nanoseconds otherwise. The report converts ticks to time using the rate
+ * observed over the life of the process.
+ */
+static inline uint64_t trace_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return clock_now_ns();
+#endif
+}
+
+static inline void trace_site_add(struct trace_site_t *site, uint64_t value)
+{
+    if(!__atomic_load_n(&site->registered, __ATOMIC_ACQUIRE)) {
+        trace_register(site);
+    }
+
+    __atomic_fetch_add(&site->calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&site->total, value, __ATOMIC_RELAXED);
+}
+
+#define TRACE_SITE_INIT(id, kind) {__FILE__, #id, (kind), 0, 0, 0, NULL}
+
+#define TRACE_BEGIN(id) \
+    static struct trace_site_t trace_site_##id = TRACE_SITE_INIT(id, TRACE_KIND_SCOPE); \
+    uint64_t trace_start_##id = trace_ticks()
+
+#define TRACE_END(id) trace_site_add(&trace_site_##id, trace_ticks() - trace_start_##id)
+
+#define TRACE_COUNT(id, n) do { \
+        static struct trace_site_t trace_site_##id = TRACE_SITE_INIT(id, TRACE_KIND_COUNTER); \
+        trace_site_add(&trace_site_##id, (uint64_t)(n)); \
+    } while(0)
+
+#else
+
+#define TRACE_BEGIN(id) do { } while(0)
+#define TRACE_END(id) do { } while(0)
+#define TRACE_COUNT(id, n) do { (void)sizeof(n); } while(0)
+
+#endif
+
+#endif //AOC_TRACE_H
@@ -0,0 +1,253 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vm.h"
+
+#define CODE_LEN 32
+
+#if defined(__GNUC__)
+#define VM_THREADED
+#endif
+
+#define WRAP32(x) ((int64_t)(int32_t)(uint32_t)(x))
+
+/*
+ * Opcodes past VM_OPS are the 32-bit versions of the arithmetic ones, picked
+ * when decoding for 32-bit registers.
+ */
+enum {
+    VM_ADDR_32 = VM_OPS,
+    VM_ADDI_32,
+    VM_MULR_32,
+    VM_MULI_32,
+    VM_OPS_ALL
+};
+
+struct op_info_t {
+    const char *name;
+    int a_reg;
+    int b_reg;
+};
+
+/*
+ * Which operands name a register; the rest are immediates, or ignored.
+ */
+static const struct op_info_t ops[VM_OPS] = {
+    [VM_ADDR] = {"addr", 1, 1}, [VM_ADDI] = {"addi", 1, 0},
+    [VM_MULR] = {"mulr", 1, 1}, [VM_MULI] = {"muli", 1, 0},
+    [VM_BANR] = {"banr", 1, 1}, [VM_BANI] = {"bani", 1, 0},
+    [VM_BORR] = {"borr", 1, 1}, [VM_BORI] = {"bori", 1, 0},
+    [VM_SETR] = {"setr", 1, 0}, [VM_SETI] = {"seti", 0, 0},
+    [VM_GTIR] = {"gtir", 0, 1}, [VM_GTRI] = {"gtri", 1, 0}, [VM_GTRR] = {"gtrr", 1, 1},
+    [VM_EQIR] = {"eqir", 0, 1}, [VM_EQRI] = {"eqri", 1, 0}, [VM_EQRR] = {"eqrr", 1, 1}
+};
+
+static int operand_fits(int64_t operand, int reg, size_t regs_len);
+static void run(struct vm_t *vm, const struct vm_instr_t *code, size_t code_len, int64_t *ip);
+
+void vm_init(struct vm_t *vm, size_t regs_len, unsigned int width, int ip_reg)
+{
+    if(regs_len > VM_MAX_REGS || (width != 32 && width != 64) ||
+       (ip_reg != VM_NO_IP && (ip_reg < 0 || (size_t)ip_reg >= regs_len))) {
+        fprintf(stderr, "Fatal error: unsupported machine: %zu registers of %u bits, ip in %d.\n", regs_len, width, ip_reg);
+        exit(EXIT_FAILURE);
+    }
+
+    memset(vm->regs, 0, sizeof(vm->regs));
+    vm->regs_len = regs_len;
+    vm->width = width;
+    vm->ip_reg = ip_reg;
+    vm->code = NULL;
+    vm->code_len = 0;
+    vm->code_cap = 0;
+    vm->retired = 0;
+}
+
+void vm_release(struct vm_t *vm)
+{
+    free(vm->code);
+    vm->code = NULL;
+    vm->code_len = 0;
+    vm->code_cap = 0;
+}
+
+void vm_reset(struct vm_t *vm)
+{
+    memset(vm->regs, 0, sizeof(vm->regs));
+    vm->retired = 0;
+}
+
+const char *vm_op_name(enum vm_op_t op)
+{
+    return ops[op].name;
+}
+
+int vm_decode(const struct vm_t *vm, enum vm_op_t op, int64_t a, int64_t b, int64_t c, struct vm_instr_t *instr)
+{
+    if((unsigned int)op >= VM_OPS || !operand_fits(a, ops[op].a_reg, vm->regs_len) ||
+       !operand_fits(b, ops[op].b_reg, vm->regs_len) || !operand_fits(c, 1, vm->regs_len)) {
+        return 1;
+    }
+
+    instr->op = (uint8_t)op;
+    instr->a = (int32_t)a;
+    instr->b = (int32_t)b;
+    instr->c = (uint8_t)c;
+
+    if(vm->width == 32) {
+        switch(op) {
+            case VM_ADDR:
+                instr->op = VM_ADDR_32;
+                break;
+            case VM_ADDI:
+                instr->op = VM_ADDI_32;
+                break;
+            case VM_MULR:
+                instr->op = VM_MULR_32;
+                break;
+            case VM_MULI:
+                instr->op = VM_MULI_32;
+                break;
+            default:
+                break;
+        }
+    }
+
+    return 0;
+}
+
+int vm_push(struct vm_t *vm, enum vm_op_t op, int64_t a, int64_t b, int64_t c)
+{
+    struct vm_instr_t instr;
+    if(vm_decode(vm, op, a, b, c, &instr)) {
+        return 1;
+    }
+
+    if(vm->code_len >= vm->code_cap) {
+        vm->code_cap = vm->code_cap < CODE_LEN ? CODE_LEN : vm->code_cap * 2;
+        vm->code = (struct vm_instr_t *)realloc(vm->code, sizeof(struct vm_instr_t) * vm->code_cap);
+        if(vm->code == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    vm->code[vm->code_len++] = instr;
+
+    return 0;
+}
+
+void vm_run(struct vm_t *vm)
+{
+    if(vm->ip_reg == VM_NO_IP) {
+        int64_t ip = 0;
+        run(vm, vm->code, vm->code_len, &ip);
+    } else {
+        run(vm, vm->code, vm->code_len, &vm->regs[vm->ip_reg]);
+    }
+}
+
+void vm_exec(struct vm_t *vm, const struct vm_instr_t *code, size_t code_len)
+{
+    int64_t ip = 0;
+    run(vm, code, code_len, &ip);
+}
+
+static int operand_fits(int64_t operand, int reg, size_t regs_len)
+{
+    if(reg) {
+        return operand >= 0 && (uint64_t)operand < regs_len;
+    }
+
+    return operand >= INT32_MIN && operand <= INT32_MAX;
+}
+
+/*
+ * The instruction pointer lives in its register when bound, so instructions
+ * that write that register jump, and it is bumped after every instruction. A
+ * negative one wraps to past the end when compared unsigned.
+ */
+static void run(struct vm_t *vm, const struct vm_instr_t *code, size_t code_len, int64_t *ip)
+{
+    int64_t *regs = vm->regs;
+    const struct vm_instr_t *instr;
+    uint64_t retired = 0;
+
+#define RA regs[instr->a]
+#define RB regs[instr->b]
+#define RC regs[instr->c]
+#define IA ((int64_t)instr->a)
+#define IB ((int64_t)instr->b)
+
+#ifdef VM_THREADED
+    static const void *const handlers[VM_OPS_ALL] = {
+        [VM_ADDR] = &&op_ADDR, [VM_ADDI] = &&op_ADDI, [VM_MULR] = &&op_MULR, [VM_MULI] = &&op_MULI,
+        [VM_BANR] = &&op_BANR, [VM_BANI] = &&op_BANI, [VM_BORR] = &&op_BORR, [VM_BORI] = &&op_BORI,
+        [VM_SETR] = &&op_SETR, [VM_SETI] = &&op_SETI, [VM_GTIR] = &&op_GTIR, [VM_GTRI] = &&op_GTRI,
+        [VM_GTRR] = &&op_GTRR, [VM_EQIR] = &&op_EQIR, [VM_EQRI] = &&op_EQRI, [VM_EQRR] = &&op_EQRR,
+        [VM_ADDR_32] = &&op_ADDR_32, [VM_ADDI_32] = &&op_ADDI_32,
+        [VM_MULR_32] = &&op_MULR_32, [VM_MULI_32] = &&op_MULI_32
+    };
+
+#define HANDLER(op) op_##op:
+#define DISPATCH() do { \
+        if((uint64_t)*ip >= code_len) \
+            goto halt; \
+        instr = code + *ip; \
+        retired++; \
+        goto *handlers[instr->op]; \
+    } while(0)
+#define NEXT() do { (*ip)++; DISPATCH(); } while(0)
+
+    DISPATCH();
+#else
+#define HANDLER(op) case VM_##op:
+#define NEXT() do { (*ip)++; continue; } while(0)
+
+    while((uint64_t)*ip < code_len) {
+        instr = code + *ip;
+        retired++;
+
+        switch(instr->op) {
+#endif
+    HANDLER(ADDR) RC = (int64_t)((uint64_t)RA + (uint64_t)RB); NEXT();
+    HANDLER(ADDI) RC = (int64_t)((uint64_t)RA + (uint64_t)IB); NEXT();
+    HANDLER(MULR) RC = (int64_t)((uint64_t)RA * (uint64_t)RB); NEXT();
+    HANDLER(MULI) RC = (int64_t)((uint64_t)RA * (uint64_t)IB); NEXT();
+    HANDLER(BANR) RC = RA & RB; NEXT();
+    HANDLER(BANI) RC = RA & IB; NEXT();
+    HANDLER(BORR) RC = RA | RB; NEXT();
+    HANDLER(BORI) RC = RA | IB; NEXT();
+    HANDLER(SETR) RC = RA; NEXT();
+    HANDLER(SETI) RC = IA; NEXT();
+    HANDLER(GTIR) RC = IA > RB; NEXT();
+    HANDLER(GTRI) RC = RA > IB; NEXT();
+    HANDLER(GTRR) RC = RA > RB; NEXT();
+    HANDLER(EQIR) RC = IA == RB; NEXT();
+    HANDLER(EQRI) RC = RA == IB; NEXT();
+    HANDLER(EQRR) RC = RA == RB; NEXT();
+    HANDLER(ADDR_32) RC = WRAP32((uint64_t)RA + (uint64_t)RB); NEXT();
+    HANDLER(ADDI_32) RC = WRAP32((uint64_t)RA + (uint64_t)IB); NEXT();
+    HANDLER(MULR_32) RC = WRAP32((uint64_t)RA * (uint64_t)RB); NEXT();
+    HANDLER(MULI_32) RC = WRAP32((uint64_t)RA * (uint64_t)IB); NEXT();
+#ifdef VM_THREADED
+halt:
+#else
+            default:
+                NEXT();
+        }
+    }
+#endif
+
+    vm->retired += retired;
+
+#undef RA
+#undef RB
+#undef RC
+#undef IA
+#undef IB
+#undef HANDLER
+#undef DISPATCH
+#undef NEXT
+}
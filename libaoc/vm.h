@@ -0,0 +1,103 @@
+#ifndef AOC_VM_H
+#define AOC_VM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * The device's register machine (days 16 and 19): sixteen opcodes over a
+ * small file of registers, with the instruction pointer optionally bound to
+ * one of them.
+ *
+ * Instructions are decoded once, as they are added, into a compact form: an
+ * internal opcode, checked register operands and 32-bit immediates. The
+ * register width is chosen up front, and with 32-bit registers the
+ * arithmetic opcodes decode to versions that wrap at 32 bits, so the run loop
+ * never tests the width. The loop is threaded: each handler jumps straight to
+ * the next one through a table of label addresses (computed goto, where the
+ * compiler has it; a switch otherwise).
+ *
+ * Registers are always stored as int64_t, sign-extended from the width.
+ */
+#define VM_MAX_REGS 32
+#define VM_NO_IP (-1)
+
+enum vm_op_t {
+    VM_ADDR,
+    VM_ADDI,
+    VM_MULR,
+    VM_MULI,
+    VM_BANR,
+    VM_BANI,
+    VM_BORR,
+    VM_BORI,
+    VM_SETR,
+    VM_SETI,
+    VM_GTIR,
+    VM_GTRI,
+    VM_GTRR,
+    VM_EQIR,
+    VM_EQRI,
+    VM_EQRR,
+    VM_OPS
+};
+
+struct vm_instr_t {
+    uint8_t op;
+    uint8_t c;
+    int32_t a;
+    int32_t b;
+};
+
+/*
+ * ip_reg is the register bound to the instruction pointer, or VM_NO_IP to
+ * run the program straight through. retired counts the instructions run by
+ * vm_run() and vm_exec().
+ */
+struct vm_t {
+    int64_t regs[VM_MAX_REGS];
+    size_t regs_len;
+    unsigned int width;
+    int ip_reg;
+    struct vm_instr_t *code;
+    size_t code_len;
+    size_t code_cap;
+    uint64_t retired;
+};
+
+/*
+ * regs_len registers of width bits (32 or 64), all zero.
+ */
+void vm_init(struct vm_t *vm, size_t regs_len, unsigned int width, int ip_reg);
+void vm_release(struct vm_t *vm);
+
+/*
+ * Zeroes the registers and the retired count, keeping the program, to run it
+ * again from the start.
+ */
+void vm_reset(struct vm_t *vm);
+
+const char *vm_op_name(enum vm_op_t op);
+
+/*
+ * Decodes an instruction for vm's register file into instr, or returns 1 when
+ * an operand is not a register where one is expected or an immediate does
+ * not fit.
+ */
+int vm_decode(const struct vm_t *vm, enum vm_op_t op, int64_t a, int64_t b, int64_t c, struct vm_instr_t *instr);
+
+/*
+ * Decodes an instruction onto the end of vm's program, returning 1 like
+ * vm_decode().
+ */
+int vm_push(struct vm_t *vm, enum vm_op_t op, int64_t a, int64_t b, int64_t c);
+
+/*
+ * vm_run() runs the program from the instruction pointer until it points
+ * outside the program. vm_exec() runs code_len decoded instructions of its
+ * own once, in order, on the registers, ignoring the instruction pointer.
+ */
+void vm_run(struct vm_t *vm);
+void vm_exec(struct vm_t *vm, const struct vm_instr_t *code, size_t code_len);
+
+#endif //AOC_VM_H
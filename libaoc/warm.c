@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "warm.h"
+
+#define WARM_SLOTS 8
+#define WARM_KEY_SEED 0x9e3779b97f4a7c15ULL
+#define WARM_KEY_MUL 0xff51afd7ed558ccdULL
+
+struct warm_slot_t {
+    const void *owner;
+    uint64_t key;
+    void *object;
+    warm_release_t release;
+};
+
+static __thread struct warm_slot_t slots[WARM_SLOTS];
+static __thread size_t next_victim = 0;
+static __thread int warm_enabled = 0;
+
+static void release_slot(struct warm_slot_t *slot);
+
+void warm_enable(void)
+{
+    warm_enabled = 1;
+}
+
+void warm_release(void)
+{
+    warm_enabled = 0;
+
+    for(size_t i = 0; i < WARM_SLOTS; i++) {
+        release_slot(&slots[i]);
+    }
+}
+
+void *warm_take(const void *owner, uint64_t key)
+{
+    if(!warm_enabled) {
+        return NULL;
+    }
+
+    for(size_t i = 0; i < WARM_SLOTS; i++) {
+        if(slots[i].owner == owner && slots[i].object != NULL && slots[i].key == key) {
+            void *object = slots[i].object;
+            slots[i].owner = NULL;
+            slots[i].object = NULL;
+            return object;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * An owner has one slot at most: its new object replaces its old one, else
+ * takes an empty slot, else evicts the slots in turn.
+ */
+void warm_keep(const void *owner, uint64_t key, void *object, warm_release_t release)
+{
+    if(!warm_enabled) {
+        release(object);
+        return;
+    }
+
+    struct warm_slot_t *slot = NULL;
+    for(size_t i = 0; i < WARM_SLOTS && slot == NULL; i++) {
+        if(slots[i].owner == owner) {
+            slot = &slots[i];
+        }
+    }
+
+    for(size_t i = 0; i < WARM_SLOTS && slot == NULL; i++) {
+        if(slots[i].object == NULL) {
+            slot = &slots[i];
+        }
+    }
+
+    if(slot == NULL) {
+        slot = &slots[next_victim];
+        next_victim = (next_victim + 1) % WARM_SLOTS;
+    }
+
+    release_slot(slot);
+
+    slot->owner = owner;
+    slot->key = key;
+    slot->object = object;
+    slot->release = release;
+}
+
+uint64_t warm_key_bytes(const void *data, size_t len)
+{
+    const char *bytes = (const char *)data;
+    uint64_t key = WARM_KEY_SEED ^ (uint64_t)len;
+
+    size_t i = 0;
+    for(; i + 8 <= len; i += 8) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        key = (key ^ word) * WARM_KEY_MUL;
+        key ^= key >> 32;
+    }
+
+    if(i < len) {
+        uint64_t word = 0;
+        memcpy(&word, bytes + i, len - i);
+        key = (key ^ word) * WARM_KEY_MUL;
+        key ^= key >> 32;
+    }
+
+    return key;
+}
+
+static void release_slot(struct warm_slot_t *slot)
+{
+    if(slot->object != NULL) {
+        slot->release(slot->object);
+    }
+
+    slot->owner = NULL;
+    slot->object = NULL;
+    slot->release = NULL;
+}
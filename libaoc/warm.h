@@ -0,0 +1,36 @@
+#ifndef AOC_WARM_H
+#define AOC_WARM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * State a solver keeps from one solve to the next in a long-running process
+ * (batch workers, the aocd server), so that an input seen again skips the work
+ * that only depends on it: day11's summed-area table for a serial number, or
+ * day19's decoded program.
+ *
+ * Each thread has a few slots, each holding one object for one owner (a
+ * solver passes its aoc_solver_t) under a key for what it was built from.
+ * warm_take() hands the owner's object over, and empties its slot, only when
+ * the key matches; warm_keep() hands one back once the solve is done,
+ * releasing whatever it displaces.
+ *
+ * Nothing is kept until the thread calls warm_enable(): warm_keep() then
+ * releases the object straight away, so a one-shot solve frees its state as
+ * before. warm_release() releases every slot and disables it again.
+ */
+typedef void (*warm_release_t)(void *object);
+
+void warm_enable(void);
+void warm_release(void);
+
+void *warm_take(const void *owner, uint64_t key);
+void warm_keep(const void *owner, uint64_t key, void *object, warm_release_t release);
+
+/*
+ * A key for the bytes of an input.
+ */
+uint64_t warm_key_bytes(const void *data, size_t len);
+
+#endif //AOC_WARM_H
@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "input.h"
+#include "protocol.h"
+
+struct connection_t {
+    FILE *in;
+    FILE *out;
+};
+
+static void open_connection(struct connection_t *conn, const char *path);
+static void close_connection(struct connection_t *conn);
+static int request(struct connection_t *conn, const char *day, const struct input_t *input);
+static void usage(const char *prog);
+
+/*
+ * Sends the puzzle on stdin, or each given input in turn, to aocd for <day>
+ * over one connection, and prints each answer line as it comes back. -n sends
+ * every input that many times, to measure a warm server.
+ */
+int main(int argc, char *argv[])
+{
+    const char *path = getenv(PROTOCOL_SOCKET_ENV);
+    long int repeat = 1;
+
+    int opt;
+    while((opt = getopt(argc, argv, "S:n:h")) != -1) {
+        switch(opt) {
+            case 'S':
+                path = optarg;
+                break;
+            case 'n':
+                repeat = strtol(optarg, NULL, 10);
+                if(repeat < 1) {
+                    fprintf(stderr, "Unexpected argument: number of requests must be positive.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if(optind >= argc) {
+        usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    if(path == NULL || *path == 0) {
+        path = PROTOCOL_DEFAULT_SOCKET;
+    }
+
+    const char *day = argv[optind++];
+
+    struct connection_t conn;
+    open_connection(&conn, path);
+
+    int failures = 0;
+    int arg = optind;
+    do {
+        FILE *stream = stdin;
+        if(arg < argc) {
+            stream = fopen(argv[arg], "rb");
+            if(stream == NULL) {
+                fprintf(stderr, "Unexpected error: cannot read %s.\n", argv[arg]);
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        struct input_t input;
+        input_open(&input, stream);
+
+        for(long int i = 0; i < repeat; i++) {
+            failures += request(&conn, day, &input);
+        }
+
+        input_release(&input);
+        if(stream != stdin) {
+            fclose(stream);
+        }
+    } while(++arg < argc);
+
+    close_connection(&conn);
+
+    return failures ? EXIT_FAILURE : 0;
+}
+
+static void open_connection(struct connection_t *conn, const char *path)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+
+    if(strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Unexpected argument: socket path %s is too long.\n", path);
+        exit(EXIT_FAILURE);
+    }
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "Unexpected error: cannot connect to %s: %s.\n", path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    int out_fd = dup(fd);
+    conn->in = fdopen(fd, "rb");
+    conn->out = out_fd >= 0 ? fdopen(out_fd, "wb") : NULL;
+    if(conn->in == NULL || conn->out == NULL) {
+        fprintf(stderr, "Unexpected error: cannot open connection: %s.\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void close_connection(struct connection_t *conn)
+{
+    fclose(conn->out);
+    fclose(conn->in);
+}
+
+/*
+ * Returns 1 if the server answered with an error, or hung up.
+ */
+static int request(struct connection_t *conn, const char *day, const struct input_t *input)
+{
+    fprintf(conn->out, "%s %zu\n", day, input->len);
+    fwrite(input->data, 1, input->len, conn->out);
+    if(fflush(conn->out) != 0) {
+        fprintf(stdout, "error\tconnection closed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    char *line = NULL;
+    size_t line_cap = 0;
+    if(getline(&line, &line_cap, conn->in) < 0) {
+        free(line);
+        fprintf(stdout, "error\tconnection closed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fputs(line, stdout);
+    fflush(stdout);
+
+    int failed = strncmp(line, "error\t", 6) == 0;
+    free(line);
+
+    return failed;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-S socket] [-n requests] <day> [input...]\n"
+                    "\n"
+                    "Asks a running aocd to solve the puzzle on stdin, or each given input, for\n"
+                    "<day>, and prints each answer as <day>\\t<part1>\\t<part2>\\t<parse ns>\\t\n"
+                    "<part1 ns>\\t<part2 ns>\\t<peak heap bytes>\\t<max rss bytes>. -n sends each\n"
+                    "input that many times over the same connection. The socket is -S, or\n"
+                    "AOC_SOCKET, or " PROTOCOL_DEFAULT_SOCKET ".\n", prog);
+}
@@ -0,0 +1,24 @@
+#ifndef AOC_PROTOCOL_H
+#define AOC_PROTOCOL_H
+
+/*
+ * The aocd wire format, over a Unix stream socket. A connection carries any
+ * number of requests, each answered in turn before the next is read:
+ *
+ *   request:  <day> <input length>\n<input bytes>
+ *   answer:   <day>\t<part1>\t<part2>\t<parse ns>\t<part1 ns>\t<part2 ns>\t<peak heap bytes>\t<max rss bytes>\n
+ *   or:       error\t<reason>\n
+ *
+ * An answer is the --tsv record of the solve (see answer_print_tsv()): parts
+ * are escaped onto one line, and what is missing is "-". After an error about
+ * the request line itself the server closes the connection, since it cannot
+ * tell where the next request starts. A connection closed with no answer
+ * means the worker died on the input (solvers exit on input they cannot
+ * parse); the server replaces it.
+ */
+#define PROTOCOL_SOCKET_ENV "AOC_SOCKET"
+#define PROTOCOL_DEFAULT_SOCKET "/tmp/aocd.sock"
+#define PROTOCOL_LINE_LEN 256
+#define PROTOCOL_MAX_INPUT (1024UL * 1024 * 1024)
+
+#endif //AOC_PROTOCOL_H
@@ -0,0 +1,316 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "arena.h"
+#include "cli.h"
+#include "protocol.h"
+#include "suite.h"
+#include "threadpool.h"
+#include "warm.h"
+
+#define BACKLOG 128
+#define INPUT_BUFF_LEN (64 * 1024)
+
+struct worker_t {
+    char *input;
+    size_t input_cap;
+    int with_memory;
+};
+
+static volatile sig_atomic_t stopping = 0;
+
+static int open_socket(const char *path);
+static pid_t spawn_worker(int listener);
+static void worker_main(int listener);
+static void serve_connection(struct worker_t *worker, int fd);
+static int serve_request(struct worker_t *worker, FILE *in, FILE *out);
+static void stop(int sig);
+static void usage(const char *prog);
+
+/*
+ * A prefork server: the parent only binds the socket and keeps <workers>
+ * processes alive, and each worker accepts connections on the shared socket
+ * and answers them one at a time. A worker keeps its arena blocks, dispatch
+ * choices and warm solver state (see warm.h) from one request to the next,
+ * which is what a process per request pays for every time. Workers are
+ * processes rather than threads because a solver given a bad input exits:
+ * that only takes its worker down, and the parent starts another.
+ */
+int main(int argc, char *argv[])
+{
+    const char *path = getenv(PROTOCOL_SOCKET_ENV);
+    size_t workers = threadpool_default_threads();
+
+    int opt;
+    while((opt = getopt(argc, argv, "S:j:h")) != -1) {
+        switch(opt) {
+            case 'S':
+                path = optarg;
+                break;
+            case 'j':
+                workers = (size_t)cli_parse_count(optarg, 1, "workers");
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if(path == NULL || *path == 0) {
+        path = PROTOCOL_DEFAULT_SOCKET;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = stop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGTERM, &action, NULL);
+    sigaction(SIGINT, &action, NULL);
+
+    int listener = open_socket(path);
+
+    pid_t *pids = (pid_t *)malloc(sizeof(pid_t) * workers);
+    if(pids == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(size_t i = 0; i < workers; i++) {
+        pids[i] = spawn_worker(listener);
+    }
+
+    fprintf(stderr, "aocd: listening on %s with %zu workers\n", path, workers);
+
+    while(!stopping) {
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if(pid < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        for(size_t i = 0; i < workers && !stopping; i++) {
+            if(pids[i] == pid) {
+                fprintf(stderr, "aocd: worker %d exited (status %d), starting another\n", (int)pid,
+                        WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status));
+                pids[i] = spawn_worker(listener);
+            }
+        }
+    }
+
+    for(size_t i = 0; i < workers; i++) {
+        kill(pids[i], SIGTERM);
+    }
+
+    for(size_t i = 0; i < workers; i++) {
+        while(waitpid(pids[i], NULL, 0) < 0 && errno == EINTR) {
+        }
+    }
+
+    close(listener);
+    unlink(path);
+    free(pids);
+
+    return 0;
+}
+
+/*
+ * A socket file left behind by a server that did not shut down cleanly is
+ * replaced; anything else at the path is not touched.
+ */
+static int open_socket(const char *path)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+
+    if(strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Unexpected argument: socket path %s is too long.\n", path);
+        exit(EXIT_FAILURE);
+    }
+    strcpy(addr.sun_path, path);
+
+    struct stat st;
+    if(lstat(path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        unlink(path);
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0 || bind(listener, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listener, BACKLOG) != 0) {
+        fprintf(stderr, "Fatal error: cannot listen on %s: %s.\n", path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    return listener;
+}
+
+/*
+ * The stop signals are held off until the worker has its own handling of
+ * them, so one that arrives in between is not caught by the parent's handler
+ * in the worker, and lost.
+ */
+static pid_t spawn_worker(int listener)
+{
+    sigset_t stop_signals, old_mask;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGTERM);
+    sigaddset(&stop_signals, SIGINT);
+    sigprocmask(SIG_BLOCK, &stop_signals, &old_mask);
+
+    pid_t pid = fork();
+    if(pid < 0) {
+        fprintf(stderr, "Fatal error: cannot start a worker: %s.\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    if(pid == 0) {
+        signal(SIGTERM, SIG_DFL);
+        signal(SIGINT, SIG_IGN);
+        sigprocmask(SIG_SETMASK, &old_mask, NULL);
+
+        worker_main(listener);
+        exit(EXIT_SUCCESS);
+    }
+
+    sigprocmask(SIG_SETMASK, &old_mask, NULL);
+
+    return pid;
+}
+
+static void worker_main(int listener)
+{
+    struct worker_t worker = {.input = NULL, .input_cap = 0, .with_memory = !memstat_start()};
+
+    arena_cache_enable();
+    warm_enable();
+
+    while(1) {
+        int fd = accept(listener, NULL, NULL);
+        if(fd < 0) {
+            if(errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+
+            fprintf(stderr, "Fatal error: cannot accept a connection: %s.\n", strerror(errno));
+            exit(EXIT_FAILURE);
+        }
+
+        serve_connection(&worker, fd);
+    }
+}
+
+static void serve_connection(struct worker_t *worker, int fd)
+{
+    int out_fd = dup(fd);
+    FILE *in = fdopen(fd, "rb");
+    FILE *out = out_fd >= 0 ? fdopen(out_fd, "wb") : NULL;
+    if(in == NULL || out == NULL) {
+        fprintf(stderr, "Unexpected error: cannot open connection: %s.\n", strerror(errno));
+        if(in != NULL) {
+            fclose(in);
+        } else {
+            close(fd);
+        }
+        if(out_fd >= 0 && out == NULL) {
+            close(out_fd);
+        }
+        return;
+    }
+
+    while(!serve_request(worker, in, out)) {
+        fflush(out);
+    }
+
+    fclose(out);
+    fclose(in);
+}
+
+/*
+ * Returns 1 when the connection is done: closed by the client, or left where
+ * the next request cannot be found.
+ */
+static int serve_request(struct worker_t *worker, FILE *in, FILE *out)
+{
+    char line[PROTOCOL_LINE_LEN];
+    if(fgets(line, sizeof(line), in) == NULL) {
+        return 1;
+    }
+
+    char name[PROTOCOL_LINE_LEN];
+    unsigned long long len;
+    if(strchr(line, '\n') == NULL || sscanf(line, "%255s %llu", name, &len) != 2 || len > PROTOCOL_MAX_INPUT) {
+        fprintf(out, "error\tbad request\n");
+        return 1;
+    }
+
+    if(len > worker->input_cap) {
+        worker->input_cap = len > INPUT_BUFF_LEN ? (size_t)len : INPUT_BUFF_LEN;
+        worker->input = (char *)realloc(worker->input, sizeof(char) * worker->input_cap);
+        if(worker->input == NULL) {
+            perror("Fatal error: Cannot allocate memory.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if(fread(worker->input, 1, (size_t)len, in) != (size_t)len) {
+        return 1;
+    }
+
+    const struct aoc_solver_t *solver = suite_find(name);
+    if(solver == NULL) {
+        fprintf(out, "error\tno solver named %s\n", name);
+        return 0;
+    }
+
+    FILE *input = fmemopen(worker->input, (size_t)len, "rb");
+    if(input == NULL) {
+        fprintf(out, "error\tcannot read input\n");
+        return 0;
+    }
+
+    struct aoc_answer_t answer;
+    answer_init(&answer);
+
+    if(solver->solve(input, &answer)) {
+        fprintf(out, "error\t%s failed\n", solver->name);
+    } else {
+        answer_print_tsv(out, solver->name, &answer, worker->with_memory);
+    }
+
+    answer_release(&answer);
+    fclose(input);
+
+    return 0;
+}
+
+static void stop(int sig)
+{
+    (void)sig;
+
+    stopping = 1;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-S socket] [-j workers]\n"
+                    "\n"
+                    "Answers puzzles sent over a Unix socket (-S, or AOC_SOCKET, or\n"
+                    "" PROTOCOL_DEFAULT_SOCKET ") with <workers> long-running processes, one per core\n"
+                    "by default, so that a request pays for no process start-up. Send requests\n"
+                    "with aocd_client. SIGTERM or SIGINT stops the workers and removes the socket.\n", prog);
+}
@@ -0,0 +1,56 @@
+#!/bin/sh
+# usage: test.sh <aocd> <aocd_client> <build dir> <expected.tsv>
+set -u
+
+server=$1
+client=$2
+build=$3
+expected=$4
+
+dir=$(mktemp -d)
+socket=$dir/aocd.sock
+failures=0
+
+"$server" -S "$socket" -j 2 2>"$dir/server.log" &
+pid=$!
+trap 'kill $pid 2>/dev/null; rm -rf "$dir"' EXIT
+
+tries=0
+while [ ! -S "$socket" ]; do
+    tries=$((tries + 1))
+    if [ $tries -gt 100 ]; then
+        echo "server did not start"
+        cat "$dir/server.log"
+        exit 1
+    fi
+    sleep 0.05
+done
+
+fail() {
+    echo "FAIL: $*"
+    failures=$((failures + 1))
+}
+
+# Each day twice over one connection, the second time warm.
+grep "	input.in	" "$expected" | while IFS='	' read -r day input part1 part2; do
+    "$client" -S "$socket" -n 2 "$day" "$build/$day/input.in" > "$dir/answer" || { fail "$day: request failed"; continue; }
+    cut -f 2,3 "$dir/answer" | sort -u > "$dir/parts"
+    printf '%s\t%s\n' "$part1" "$part2" | cmp -s - "$dir/parts" || fail "$day: got $(head -n 1 "$dir/parts")"
+done > "$dir/days"
+if [ -s "$dir/days" ]; then
+    cat "$dir/days"
+    failures=$((failures + 1))
+fi
+
+"$client" -S "$socket" day99 < /dev/null | grep -q "^error	no solver named day99" || fail "unknown day not reported"
+
+# day11 exits on a serial that is not a number, taking its worker down.
+echo nonsense | "$client" -S "$socket" day11 > "$dir/answer" 2>/dev/null && fail "bad input answered"
+grep -q "^error	connection closed" "$dir/answer" || fail "bad input not reported"
+"$client" -S "$socket" day11 "$build/day11/input.in" > /dev/null || fail "no worker after a bad input"
+
+kill $pid
+wait $pid
+[ -e "$socket" ] && fail "socket left behind"
+
+[ $failures -eq 0 ]
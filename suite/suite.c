@@ -0,0 +1,53 @@
+#include <string.h>
+
+#include "suite.h"
+#include "day1.h"
+#include "day2.h"
+#include "day3.h"
+#include "day4.h"
+#include "day5.h"
+#include "day6.h"
+#include "day7.h"
+#include "day8.h"
+#include "day9.h"
+#include "day10.h"
+#include "day11.h"
+#include "day12.h"
+#include "day13.h"
+#include "day14.h"
+#include "day16.h"
+#include "day18.h"
+#include "day19.h"
+
+const struct aoc_solver_t *const suite_solvers[] = {
+    &day1_solver,
+    &day2_solver,
+    &day3_solver,
+    &day4_solver,
+    &day5_solver,
+    &day6_solver,
+    &day7_solver,
+    &day8_solver,
+    &day9_solver,
+    &day10_solver,
+    &day11_solver,
+    &day12_solver,
+    &day13_solver,
+    &day14_solver,
+    &day16_solver,
+    &day18_solver,
+    &day19_solver,
+};
+
+const size_t suite_solvers_len = sizeof(suite_solvers) / sizeof(suite_solvers[0]);
+
+const struct aoc_solver_t *suite_find(const char *name)
+{
+    for(size_t i = 0; i < suite_solvers_len; i++) {
+        if(strcmp(suite_solvers[i]->name, name) == 0) {
+            return suite_solvers[i];
+        }
+    }
+
+    return NULL;
+}
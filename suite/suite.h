@@ -0,0 +1,18 @@
+#ifndef AOC_SUITE_H
+#define AOC_SUITE_H
+
+#include <stddef.h>
+
+#include "solver.h"
+
+/*
+ * Every solver in the repository, in puzzle order. Tools that drive more than
+ * one day (benchmarks, batch runners) look solvers up here rather than linking
+ * each day by hand.
+ */
+extern const struct aoc_solver_t *const suite_solvers[];
+extern const size_t suite_solvers_len;
+
+const struct aoc_solver_t *suite_find(const char *name);
+
+#endif //AOC_SUITE_H
@@ -0,0 +1,634 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "day5.h"
+#include "day6.h"
+#include "day12.h"
+#include "day13.h"
+
+#define DEFAULT_CASES 20
+#define DEFAULT_SEED 1
+#define DEFAULT_SCALE 1
+#define DEFAULT_TIMEOUT 10
+#define DEFAULT_TRIES 500
+#define PATH_LEN 4096
+#define BUFF_LEN 4096
+#define SHOW_LEN 400
+
+#ifndef AOC_BINARY_DIR
+#define AOC_BINARY_DIR "."
+#endif
+
+/*
+ * A solver and the plain reference it must agree with (see reference.c in
+ * each day).
+ */
+struct verify_pair_t {
+    const struct aoc_solver_t *solver;
+    const struct aoc_solver_t *reference;
+};
+
+static const struct verify_pair_t pairs[] = {
+    {&day5_solver, &day5_reference},
+    {&day6_solver, &day6_reference},
+    {&day12_solver, &day12_reference},
+    {&day13_solver, &day13_reference}
+};
+
+static const size_t pairs_len = sizeof(pairs) / sizeof(pairs[0]);
+
+enum run_status_t {
+    RUN_OK,
+    RUN_FAILED,
+    RUN_CRASHED,
+    RUN_TIMEOUT
+};
+
+/*
+ * How one solve went. The parts are as answer_print_tsv() writes them:
+ * escaped, and "-" when missing.
+ */
+struct run_t {
+    enum run_status_t status;
+    int code;
+    char *part1;
+    char *part2;
+};
+
+/*
+ * A reference that refuses an input says the puzzle rules it out, so the
+ * case does not count. Otherwise the solver must give the same answers.
+ */
+enum verdict_t {
+    VERDICT_AGREE,
+    VERDICT_REFUSED,
+    VERDICT_DIFFER,
+    VERDICT_FAILED
+};
+
+/*
+ * What the solver is checked with: the pair, which of the solver's entry
+ * points (solve, or solve_stream), and how long either may take.
+ */
+struct check_t {
+    const struct verify_pair_t *pair;
+    int (*solve)(FILE *input, struct aoc_answer_t *answer);
+    const char *entry;
+    unsigned int timeout;
+    int tries;
+};
+
+static int verify_pair(const struct verify_pair_t *pair, const char *dir, const char *out_dir, uint64_t first_seed, int cases, unsigned long int scale, unsigned int timeout, int tries);
+static int report(const struct check_t *check, const char *out_dir, uint64_t seed, char *input, size_t input_len, enum verdict_t verdict);
+static char *generate(const char *dir, const char *day, uint64_t seed, unsigned long int scale, size_t *len);
+static char *read_all(int fd, size_t *len);
+static enum verdict_t check_input(const struct check_t *check, const char *input, size_t input_len, struct run_t *solver_run, struct run_t *reference_run);
+static void run_solver(const char *name, int (*solve)(FILE *input, struct aoc_answer_t *answer), const char *input, size_t input_len, unsigned int timeout, struct run_t *run);
+static void release_run(struct run_t *run);
+static size_t minimize(const struct check_t *check, char *input, size_t input_len, enum verdict_t verdict, int by_line, int *tries);
+static size_t count_units(const char *input, size_t input_len, int by_line, size_t starts[]);
+static void print_run(FILE *stream, const char *who, const struct run_t *run);
+static const char *verdict_name(enum verdict_t verdict);
+static void usage(const char *prog);
+
+int main(int argc, char *argv[])
+{
+    int cases = DEFAULT_CASES;
+    uint64_t first_seed = DEFAULT_SEED;
+    unsigned long int scale = DEFAULT_SCALE;
+    unsigned int timeout = DEFAULT_TIMEOUT;
+    int tries = DEFAULT_TRIES;
+    const char *dir = AOC_BINARY_DIR;
+    const char *out_dir = ".";
+
+    int opt;
+    while((opt = getopt(argc, argv, "n:r:s:T:m:C:o:h")) != -1) {
+        switch(opt) {
+            case 'n':
+                cases = (int)strtol(optarg, NULL, 10);
+                if(cases < 1) {
+                    fprintf(stderr, "Unexpected argument: number of cases must be positive.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'r':
+                first_seed = strtoull(optarg, NULL, 10);
+                break;
+            case 's':
+                scale = strtoul(optarg, NULL, 10);
+                if(scale < 1) {
+                    fprintf(stderr, "Unexpected argument: scale must be positive.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'T':
+                timeout = (unsigned int)strtoul(optarg, NULL, 10);
+                if(timeout < 1) {
+                    fprintf(stderr, "Unexpected argument: timeout must be at least a second.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'm':
+                tries = (int)strtol(optarg, NULL, 10);
+                if(tries < 0) {
+                    fprintf(stderr, "Unexpected argument: number of tries must not be negative.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'C':
+                dir = optarg;
+                break;
+            case 'o':
+                out_dir = optarg;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    for(int arg = optind; arg < argc; arg++) {
+        size_t i = 0;
+        while(i < pairs_len && strcmp(pairs[i].solver->name, argv[arg]) != 0) {
+            i++;
+        }
+
+        if(i == pairs_len) {
+            fprintf(stderr, "Unexpected argument: no reference for %s.\n", argv[arg]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    int failures = 0;
+    for(size_t i = 0; i < pairs_len; i++) {
+        int wanted = optind == argc;
+        for(int arg = optind; arg < argc && !wanted; arg++) {
+            wanted = strcmp(argv[arg], pairs[i].solver->name) == 0;
+        }
+
+        if(wanted) {
+            failures += verify_pair(pairs + i, dir, out_dir, first_seed, cases, scale, timeout, tries);
+        }
+    }
+
+    return failures ? EXIT_FAILURE : 0;
+}
+
+/*
+ * Returns the number of cases where the solver disagreed, or 1 when the
+ * reference refused every input, which says the generator and the reference
+ * no longer describe the same puzzle.
+ */
+static int verify_pair(const struct verify_pair_t *pair, const char *dir, const char *out_dir, uint64_t first_seed, int cases, unsigned long int scale, unsigned int timeout, int tries)
+{
+    const char *name = pair->solver->name;
+    struct check_t checks[2] = {
+        {.pair = pair, .solve = pair->solver->solve, .entry = "solve", .timeout = timeout, .tries = tries},
+        {.pair = pair, .solve = pair->solver->solve_stream, .entry = "solve_stream", .timeout = timeout, .tries = tries}
+    };
+    int checks_len = pair->solver->solve_stream != NULL ? 2 : 1;
+
+    int agreed = 0;
+    int refused = 0;
+    int disagreed = 0;
+    for(int i = 0; i < cases; i++) {
+        uint64_t seed = first_seed + (uint64_t)i;
+
+        size_t input_len;
+        char *input = generate(dir, name, seed, scale, &input_len);
+        if(input == NULL) {
+            return 1;
+        }
+
+        enum verdict_t verdict = VERDICT_AGREE;
+        for(int c = 0; c < checks_len && verdict == VERDICT_AGREE; c++) {
+            struct run_t solver_run, reference_run;
+            verdict = check_input(checks + c, input, input_len, &solver_run, &reference_run);
+            release_run(&solver_run);
+            release_run(&reference_run);
+
+            if(verdict == VERDICT_DIFFER || verdict == VERDICT_FAILED) {
+                report(checks + c, out_dir, seed, input, input_len, verdict);
+            }
+        }
+
+        agreed += verdict == VERDICT_AGREE;
+        refused += verdict == VERDICT_REFUSED;
+        disagreed += verdict == VERDICT_DIFFER || verdict == VERDICT_FAILED;
+
+        free(input);
+    }
+
+    fprintf(stdout, "%s: %d cases from seed %llu, %d agree, %d refused by the reference, %d disagree\n", name, cases,
+            (unsigned long long)first_seed, agreed, refused, disagreed);
+
+    if(refused == cases) {
+        fprintf(stderr, "Unexpected result: the %s reference refused every generated input.\n", name);
+        return 1;
+    }
+
+    return disagreed;
+}
+
+/*
+ * Shrinks the input to one that still gets the same verdict, in at most
+ * check->tries solves of each, writes it to <out_dir>/<day>.<seed>.in, and
+ * shows both runs on it.
+ */
+static int report(const struct check_t *check, const char *out_dir, uint64_t seed, char *input, size_t input_len, enum verdict_t verdict)
+{
+    const char *name = check->pair->solver->name;
+
+    fprintf(stderr, "Unexpected result: %s %s %s the reference on seed %llu; minimizing %zu bytes.\n", name,
+            check->entry, verdict_name(verdict), (unsigned long long)seed, input_len);
+
+    int tries = check->tries;
+    size_t len = minimize(check, input, input_len, verdict, 1, &tries);
+    if(memchr(input, '\n', len > 0 ? len - 1 : 0) == NULL) {
+        len = minimize(check, input, len, verdict, 0, &tries);
+    }
+
+    char path[PATH_LEN];
+    snprintf(path, PATH_LEN, "%s/%s.%llu.in", out_dir, name, (unsigned long long)seed);
+    FILE *file = fopen(path, "wb");
+    if(file == NULL || fwrite(input, 1, len, file) != len || fclose(file) != 0) {
+        fprintf(stderr, "Unexpected error: cannot write %s.\n", path);
+        return 1;
+    }
+
+    struct run_t solver_run, reference_run;
+    check_input(check, input, len, &solver_run, &reference_run);
+
+    fprintf(stderr, "  minimized to %zu bytes in %s%s\n", len, path, tries == 0 ? " (out of tries)" : "");
+    if(len <= SHOW_LEN) {
+        fprintf(stderr, "%.*s%s", (int)len, input, len > 0 && input[len - 1] == '\n' ? "" : "\n");
+    }
+    print_run(stderr, "solver:   ", &solver_run);
+    print_run(stderr, "reference:", &reference_run);
+
+    release_run(&solver_run);
+    release_run(&reference_run);
+
+    return 0;
+}
+
+/*
+ * Runs `<dir>/<day>/aocd#_gen <seed> <scale>` and returns what it writes.
+ */
+static char *generate(const char *dir, const char *day, uint64_t seed, unsigned long int scale, size_t *len)
+{
+    char gen[PATH_LEN];
+    char seed_arg[32];
+    char scale_arg[32];
+    snprintf(gen, PATH_LEN, "%s/%s/aocd%s_gen", dir, day, day + 3);
+    snprintf(seed_arg, sizeof(seed_arg), "%llu", (unsigned long long)seed);
+    snprintf(scale_arg, sizeof(scale_arg), "%lu", scale);
+
+    int fds[2];
+    if(pipe(fds) != 0) {
+        fprintf(stderr, "Unexpected error: cannot run %s: %s.\n", gen, strerror(errno));
+        return NULL;
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t pid = fork();
+    if(pid < 0) {
+        fprintf(stderr, "Unexpected error: cannot run %s: %s.\n", gen, strerror(errno));
+        close(fds[0]);
+        close(fds[1]);
+        return NULL;
+    }
+
+    if(pid == 0) {
+        int null_fd = open("/dev/null", O_WRONLY);
+        dup2(fds[1], STDOUT_FILENO);
+        if(null_fd >= 0) {
+            dup2(null_fd, STDERR_FILENO);
+        }
+        close(fds[0]);
+        close(fds[1]);
+
+        execl(gen, gen, seed_arg, scale_arg, (char *)NULL);
+        _exit(127);
+    }
+
+    close(fds[1]);
+    char *input = read_all(fds[0], len);
+    close(fds[0]);
+
+    int status;
+    while(waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "Unexpected error: %s failed for seed %s.\n", gen, seed_arg);
+        free(input);
+        return NULL;
+    }
+
+    return input;
+}
+
+static char *read_all(int fd, size_t *len)
+{
+    size_t buff_len = BUFF_LEN;
+    size_t buff_index = 0;
+    char *buffer = (char *)malloc(sizeof(char) * buff_len);
+    if(buffer == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    while(1) {
+        if(buff_index == buff_len) {
+            buff_len *= 2;
+            buffer = (char *)realloc(buffer, sizeof(char) * buff_len);
+            if(buffer == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        ssize_t got = read(fd, buffer + buff_index, buff_len - buff_index);
+        if(got < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if(got <= 0) {
+            break;
+        }
+
+        buff_index += (size_t)got;
+    }
+
+    *len = buff_index;
+    return buffer;
+}
+
+static enum verdict_t check_input(const struct check_t *check, const char *input, size_t input_len, struct run_t *solver_run, struct run_t *reference_run)
+{
+    const char *name = check->pair->solver->name;
+
+    run_solver(name, check->pair->reference->solve, input, input_len, check->timeout, reference_run);
+    run_solver(name, check->solve, input, input_len, check->timeout, solver_run);
+
+    if(reference_run->status != RUN_OK) {
+        return VERDICT_REFUSED;
+    }
+
+    if(solver_run->status != RUN_OK) {
+        return VERDICT_FAILED;
+    }
+
+    if(strcmp(solver_run->part1, reference_run->part1) != 0 || strcmp(solver_run->part2, reference_run->part2) != 0) {
+        return VERDICT_DIFFER;
+    }
+
+    return VERDICT_AGREE;
+}
+
+/*
+ * Each solve runs in a child of its own, since solvers exit on input they
+ * cannot parse and a broken one may crash or never finish; the child sends
+ * its answer back as a TSV record and is killed by SIGALRM after timeout
+ * seconds.
+ */
+static void run_solver(const char *name, int (*solve)(FILE *input, struct aoc_answer_t *answer), const char *input, size_t input_len, unsigned int timeout, struct run_t *run)
+{
+    run->status = RUN_FAILED;
+    run->code = 0;
+    run->part1 = NULL;
+    run->part2 = NULL;
+
+    int fds[2];
+    if(pipe(fds) != 0) {
+        perror("Fatal error: Cannot create pipe.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t pid = fork();
+    if(pid < 0) {
+        perror("Fatal error: Cannot fork.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if(pid == 0) {
+        close(fds[0]);
+
+        int null_fd = open("/dev/null", O_WRONLY);
+        if(null_fd >= 0) {
+            dup2(null_fd, STDERR_FILENO);
+        }
+
+        signal(SIGALRM, SIG_DFL);
+        alarm(timeout);
+
+        FILE *stream = fmemopen((void *)input, input_len, "r");
+        FILE *out = fdopen(fds[1], "w");
+        if(stream == NULL || out == NULL) {
+            _exit(EXIT_FAILURE);
+        }
+
+        struct aoc_answer_t answer;
+        answer_init(&answer);
+        if(solve(stream, &answer)) {
+            exit(EXIT_FAILURE);
+        }
+
+        answer_print_tsv(out, name, &answer, 0);
+        fclose(out);
+        exit(0);
+    }
+
+    close(fds[1]);
+    size_t len;
+    char *record = read_all(fds[0], &len);
+    close(fds[0]);
+
+    int status;
+    while(waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+
+    if(WIFSIGNALED(status)) {
+        run->status = WTERMSIG(status) == SIGALRM ? RUN_TIMEOUT : RUN_CRASHED;
+        run->code = WTERMSIG(status);
+    } else if(WEXITSTATUS(status) != 0) {
+        run->code = WEXITSTATUS(status);
+    } else {
+        /*
+         * <name>\t<part1>\t<part2>\t...
+         */
+        char *part1 = memchr(record, '\t', len);
+        char *part2 = part1 != NULL ? memchr(part1 + 1, '\t', len - (size_t)(part1 + 1 - record)) : NULL;
+        char *end = part2 != NULL ? memchr(part2 + 1, '\t', len - (size_t)(part2 + 1 - record)) : NULL;
+        if(end != NULL) {
+            *part2 = 0;
+            *end = 0;
+            run->status = RUN_OK;
+            run->part1 = strdup(part1 + 1);
+            run->part2 = strdup(part2 + 1);
+            if(run->part1 == NULL || run->part2 == NULL) {
+                perror("Fatal error: Cannot allocate memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    free(record);
+}
+
+static void release_run(struct run_t *run)
+{
+    free(run->part1);
+    free(run->part2);
+    run->part1 = NULL;
+    run->part2 = NULL;
+}
+
+/*
+ * Delta debugging: the input is cut into n chunks of lines (or of bytes),
+ * and the first chunk whose removal leaves an input with the same verdict is
+ * dropped, after which the search goes on with one chunk fewer. When no
+ * chunk can go, the chunks are halved, until they are single lines. Each
+ * candidate costs one of the tries, and the search stops when they run out.
+ * The input is shrunk in place and its new length returned.
+ */
+static size_t minimize(const struct check_t *check, char *input, size_t input_len, enum verdict_t verdict, int by_line, int *tries)
+{
+    size_t *starts = (size_t *)malloc(sizeof(size_t) * (input_len + 1));
+    char *candidate = (char *)malloc(sizeof(char) * (input_len > 0 ? input_len : 1));
+    if(starts == NULL || candidate == NULL) {
+        perror("Fatal error: Cannot allocate memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t chunks = 2;
+    while(*tries > 0) {
+        size_t units = count_units(input, input_len, by_line, starts);
+        if(units < 2) {
+            break;
+        }
+
+        if(chunks > units) {
+            chunks = units;
+        }
+
+        int reduced = 0;
+        for(size_t chunk = 0; chunk < chunks && !reduced && *tries > 0; chunk++) {
+            size_t drop_begin = starts[units * chunk / chunks];
+            size_t drop_end = starts[units * (chunk + 1) / chunks];
+
+            size_t candidate_len = drop_begin;
+            memcpy(candidate, input, drop_begin);
+            memcpy(candidate + candidate_len, input + drop_end, input_len - drop_end);
+            candidate_len += input_len - drop_end;
+
+            (*tries)--;
+
+            struct run_t solver_run, reference_run;
+            enum verdict_t candidate_verdict = check_input(check, candidate, candidate_len, &solver_run, &reference_run);
+            release_run(&solver_run);
+            release_run(&reference_run);
+
+            if(candidate_verdict == verdict) {
+                memcpy(input, candidate, candidate_len);
+                input_len = candidate_len;
+                chunks = chunks > 2 ? chunks - 1 : 2;
+                reduced = 1;
+            }
+        }
+
+        if(!reduced && *tries > 0) {
+            if(chunks >= units) {
+                break;
+            }
+            chunks = chunks * 2 < units ? chunks * 2 : units;
+        }
+    }
+
+    free(candidate);
+    free(starts);
+
+    return input_len;
+}
+
+/*
+ * Fills starts with where each unit begins, and starts[units] with the end
+ * of the input. A line unit takes its newline with it.
+ */
+static size_t count_units(const char *input, size_t input_len, int by_line, size_t starts[])
+{
+    size_t units = 0;
+    for(size_t i = 0; i < input_len; i++) {
+        if(!by_line || i == 0 || input[i - 1] == '\n') {
+            starts[units++] = i;
+        }
+    }
+
+    starts[units] = input_len;
+
+    return units;
+}
+
+static void print_run(FILE *stream, const char *who, const struct run_t *run)
+{
+    switch(run->status) {
+        case RUN_OK:
+            fprintf(stream, "  %s part1 %s, part2 %s\n", who, run->part1, run->part2);
+            break;
+        case RUN_FAILED:
+            fprintf(stream, "  %s exited with status %d\n", who, run->code);
+            break;
+        case RUN_CRASHED:
+            fprintf(stream, "  %s killed by signal %d\n", who, run->code);
+            break;
+        case RUN_TIMEOUT:
+            fprintf(stream, "  %s timed out\n", who);
+            break;
+    }
+}
+
+static const char *verdict_name(enum verdict_t verdict)
+{
+    switch(verdict) {
+        case VERDICT_DIFFER:
+            return "answers differently from";
+        case VERDICT_FAILED:
+            return "fails where it should match";
+        case VERDICT_REFUSED:
+            return "was not checked against";
+        default:
+            return "agrees with";
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-n cases] [-r seed] [-s scale] [-T seconds] [-m tries] [-C dir] [-o dir] [day...]\n"
+                    "\n"
+                    "Checks each solver that has a reference (days 5, 6, 12 and 13) against it on\n"
+                    "<cases> inputs from the day's generator, with seeds counting up from <seed>,\n"
+                    "at <scale>. Both solves, and solve_stream where there is one, run in\n"
+                    "children of their own and are stopped after -T seconds. An input the\n"
+                    "reference refuses is skipped; one where the solver answers differently,\n"
+                    "fails, crashes or runs out of time is shrunk by delta debugging, in at\n"
+                    "most <tries> candidates (default %d), to a smaller one that does the same,\n"
+                    "which is written to <dir>/<day>.<seed>.in.\n", prog, DEFAULT_TRIES);
+}